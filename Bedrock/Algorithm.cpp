@@ -3,6 +3,151 @@
 #include <Bedrock/StringView.h>
 #include <Bedrock/Test.h>
 
+// SSE2 is always available on x64. AVX2 would compare twice as many elements per instruction, but isn't guaranteed.
+#if defined(_M_X64) || defined(__x86_64__)
+#define BEDROCK_FIND_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace Details
+{
+#ifdef BEDROCK_FIND_SSE2
+
+	template <typename taType>
+	force_inline __m128i SIMDBroadcast(taType inValue)
+	{
+		if constexpr (sizeof(taType) == 1)		return _mm_set1_epi8((char)inValue);
+		else if constexpr (sizeof(taType) == 2)	return _mm_set1_epi16((short)inValue);
+		else if constexpr (sizeof(taType) == 4)	return _mm_set1_epi32((int)inValue);
+		else									return _mm_set1_epi64x((long long)inValue);
+	}
+
+	// Return a mask with all the bits of a lane set if the lanes of inA and inB are equal.
+	template <typename taType>
+	force_inline __m128i SIMDEqual(__m128i inA, __m128i inB)
+	{
+		if constexpr (sizeof(taType) == 1)		return _mm_cmpeq_epi8(inA, inB);
+		else if constexpr (sizeof(taType) == 2)	return _mm_cmpeq_epi16(inA, inB);
+		else if constexpr (sizeof(taType) == 4)	return _mm_cmpeq_epi32(inA, inB);
+		else
+		{
+			// No 64-bit compare in SSE2, both 32-bit halves must be equal.
+			__m128i equal32 = _mm_cmpeq_epi32(inA, inB);
+			return _mm_and_si128(equal32, _mm_shuffle_epi32(equal32, _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+	}
+
+	template <typename taType>
+	force_inline __m128i SIMDLoadEqual(const taType* inPtr, __m128i inValue)
+	{
+		return SIMDEqual<taType>(_mm_loadu_si128((const __m128i*)inPtr), inValue);
+	}
+
+	template <typename taType>
+	const taType* FindSIMDImpl(const taType* inBegin, const taType* inEnd, taType inValue)
+	{
+		constexpr int cLanes = 16 / sizeof(taType);
+
+		__m128i       value = SIMDBroadcast(inValue);
+		const taType* it    = inBegin;
+
+		// Check 4 vectors per iteration, most of the time none of them match.
+		for (; inEnd - it >= cLanes * 4; it += cLanes * 4)
+		{
+			__m128i equal0 = SIMDLoadEqual(it, value);
+			__m128i equal1 = SIMDLoadEqual(it + cLanes, value);
+			__m128i equal2 = SIMDLoadEqual(it + cLanes * 2, value);
+			__m128i equal3 = SIMDLoadEqual(it + cLanes * 3, value);
+
+			__m128i any_equal = _mm_or_si128(_mm_or_si128(equal0, equal1), _mm_or_si128(equal2, equal3));
+			if (_mm_movemask_epi8(any_equal) != 0)
+			{
+				uint64 mask = (uint64)(uint32)_mm_movemask_epi8(equal0)
+							| (uint64)(uint32)_mm_movemask_epi8(equal1) << 16
+							| (uint64)(uint32)_mm_movemask_epi8(equal2) << 32
+							| (uint64)(uint32)_mm_movemask_epi8(equal3) << 48;
+
+				return it + gCountTrailingZeros64(mask) / sizeof(taType);
+			}
+		}
+
+		for (; inEnd - it >= cLanes; it += cLanes)
+		{
+			int mask = _mm_movemask_epi8(SIMDLoadEqual(it, value));
+			if (mask != 0)
+				return it + gCountTrailingZeros64((uint64)mask) / sizeof(taType);
+		}
+
+		// Check the last elements with one more vector ending at inEnd, overlapping the ones already checked.
+		// The range is at least one vector long (see cFindSIMDMinSize).
+		if (it != inEnd)
+		{
+			it = inEnd - cLanes;
+			int mask = _mm_movemask_epi8(SIMDLoadEqual(it, value));
+			if (mask != 0)
+				return it + gCountTrailingZeros64((uint64)mask) / sizeof(taType);
+		}
+
+		return inEnd;
+	}
+
+	template <typename taType>
+	int CountSIMDImpl(const taType* inBegin, const taType* inEnd, taType inValue)
+	{
+		constexpr int cLanes = 16 / sizeof(taType);
+
+		__m128i       value = SIMDBroadcast(inValue);
+		const taType* it    = inBegin;
+		int           count = 0;
+
+		// Each matching element sets sizeof(taType) bits of the mask.
+		for (; inEnd - it >= cLanes; it += cLanes)
+			count += gCountSetBits64((uint64)(uint32)_mm_movemask_epi8(SIMDLoadEqual(it, value)));
+
+		count /= sizeof(taType);
+
+		for (; it != inEnd; ++it)
+			count += (*it == inValue);
+
+		return count;
+	}
+
+#else
+
+	template <typename taType>
+	const taType* FindSIMDImpl(const taType* inBegin, const taType* inEnd, taType inValue)
+	{
+		for (const taType* it = inBegin; it != inEnd; ++it)
+			if (*it == inValue)
+				return it;
+
+		return inEnd;
+	}
+
+	template <typename taType>
+	int CountSIMDImpl(const taType* inBegin, const taType* inEnd, taType inValue)
+	{
+		int count = 0;
+		for (const taType* it = inBegin; it != inEnd; ++it)
+			count += (*it == inValue);
+
+		return count;
+	}
+
+#endif
+
+	const uint8*  FindSIMD(const uint8* inBegin, const uint8* inEnd, uint8 inValue)		{ return FindSIMDImpl(inBegin, inEnd, inValue); }
+	const uint16* FindSIMD(const uint16* inBegin, const uint16* inEnd, uint16 inValue)	{ return FindSIMDImpl(inBegin, inEnd, inValue); }
+	const uint32* FindSIMD(const uint32* inBegin, const uint32* inEnd, uint32 inValue)	{ return FindSIMDImpl(inBegin, inEnd, inValue); }
+	const uint64* FindSIMD(const uint64* inBegin, const uint64* inEnd, uint64 inValue)	{ return FindSIMDImpl(inBegin, inEnd, inValue); }
+	int           CountSIMD(const uint8* inBegin, const uint8* inEnd, uint8 inValue)		{ return CountSIMDImpl(inBegin, inEnd, inValue); }
+	int           CountSIMD(const uint16* inBegin, const uint16* inEnd, uint16 inValue)	{ return CountSIMDImpl(inBegin, inEnd, inValue); }
+	int           CountSIMD(const uint32* inBegin, const uint32* inEnd, uint32 inValue)	{ return CountSIMDImpl(inBegin, inEnd, inValue); }
+	int           CountSIMD(const uint64* inBegin, const uint64* inEnd, uint64 inValue)	{ return CountSIMDImpl(inBegin, inEnd, inValue); }
+}
+
+
 REGISTER_TEST("ReverseIterator")
 {
 	StringView test = "test";
@@ -33,3 +178,109 @@ REGISTER_TEST("AnyOf")
 	TEST_TRUE(gAllOf(values, [](int v) { return v <= 5; }));
 	TEST_FALSE(gAllOf(values, [](int v) { return v < 3; }));
 };
+
+
+REGISTER_TEST("Find")
+{
+	// Constant evaluation uses the scalar version.
+	static_assert([]
+	{
+		int values[] = { 1, 2, 3, 4, 5 };
+		return gFind(values, values + 5, 4) == values + 3 && gCount(values, values + 5, 6) == 0;
+	}());
+
+	// Every size and position, to cover the 4 vectors loop, the single vector loop and the last overlapping vector.
+	uint8 bytes[200] = {};
+	for (int size = 0; size <= 200; ++size)
+	{
+		TEST_TRUE(gFind(bytes, bytes + size, (uint8)1) == bytes + size);
+
+		for (int pos = 0; pos < size; ++pos)
+		{
+			bytes[pos] = 1;
+			TEST_TRUE(gFind(bytes, bytes + size, (uint8)1) == bytes + pos);
+			bytes[pos] = 0;
+		}
+	}
+
+	// 8-byte values that only differ by one of their 32-bit halves.
+	uint64 values[40];
+	for (int i = 0; i < 40; ++i)
+		values[i] = (uint64)i << 32 | 7;
+
+	TEST_TRUE(gFind(values, values + 40, (uint64)7) == values);
+	TEST_TRUE(gFind(values, values + 40, (uint64)33 << 32 | 7) == values + 33);
+	TEST_TRUE(gFind(values, values + 40, (uint64)33 << 32) == values + 40);
+
+	// Pointers and enums.
+	enum class EValue : int16 { A, B, C };
+	EValue enums[20] = {};
+	enums[17] = EValue::C;
+	TEST_TRUE(gFind(enums, enums + 20, EValue::C) == enums + 17);
+
+	int        target       = 0;
+	const int* pointers[10] = {};
+	pointers[9] = &target;
+	TEST_TRUE(gFind(pointers, pointers + 10, pointers[9]) == pointers + 9);
+
+	// Different types of values use the scalar version.
+	int32 ints[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, -1 };
+	TEST_TRUE(gFind(ints, ints + 10, (int64)-1) == ints + 9);
+
+	StringView test = "a string that's long enough for the SIMD version";
+	TEST_TRUE(test.Find('S') == 36);
+	TEST_TRUE(test.Find('z') == -1);
+	TEST_TRUE(gContains(test, 'I'));
+	TEST_FALSE(gContains(test, 'z'));
+	TEST_TRUE(gFindIf(test, [](char c) { return c == '\''; }) == test.Begin() + 13);
+};
+
+
+REGISTER_TEST("Count")
+{
+	uint16 values[300];
+	for (int i = 0; i < 300; ++i)
+		values[i] = (uint16)(i % 7);
+
+	int sizes[] = { 0, 5, 8, 9, 100, 300 };
+	for (int size : sizes)
+	{
+		int expected = 0;
+		for (int i = 0; i < size; ++i)
+			expected += values[i] == 3;
+
+		TEST_TRUE(gCount(values, values + size, (uint16)3) == expected);
+		TEST_TRUE(gCountIf(values, values + size, [](uint16 v) { return v == 3; }) == expected);
+	}
+
+	StringView test = "count the t's in this string please";
+	TEST_TRUE(gCount(test, 't') == 5);
+	TEST_TRUE(gCount(test, 'z') == 0);
+};
+
+
+REGISTER_TEST("LowerBound")
+{
+	static_assert([]
+	{
+		int values[] = { 1, 3, 5, 7 };
+		return gLowerBound(values, values + 4, 5) == values + 2 && gLowerBound(values, values + 4, 8) == values + 4;
+	}());
+
+	// Every size and position, with duplicates.
+	for (int size = 0; size < 40; ++size)
+	{
+		int values[40];
+		for (int i = 0; i < size; ++i)
+			values[i] = i / 2;
+
+		for (int value = -1; value <= size / 2 + 1; ++value)
+		{
+			int* expected = values;
+			while (expected != values + size && *expected < value)
+				++expected;
+
+			TEST_TRUE(gLowerBound(values, values + size, value) == expected);
+		}
+	}
+};
@@ -15,6 +15,14 @@ constexpr void gSwap(taType& ioA, taType& ioB)
 }
 
 
+// Default comparison function for sorting.
+// Equivalent to std::less<>.
+struct Less
+{
+	constexpr bool operator()(const auto& inA, const auto& inB) const { return inA < inB; }
+};
+
+
 // Forward declaration of the Hash struct.
 // Equivalent to std::hash.
 template <typename taType> struct Hash;
@@ -48,15 +56,6 @@ template <typename taContainer>
 constexpr ReverseAdapter<taContainer> gBackwards(taContainer& ioContainer) { return { ioContainer }; }
 
 
-// Check if a value is present in a vector-like container.
-constexpr bool gContains(const auto& ioContainer, const auto& inElem)
-{
-	for (auto& elem : ioContainer)
-		if (elem == inElem)
-			return true;
-
-	return false;
-}
 
 
 // Check if any element in the container matches the predicate.
@@ -112,29 +111,37 @@ constexpr bool gEquals(const auto& inContainerA, const auto& inContainerB)
 
 
 // Lower bound implementation to avoid <algorithm>
-template<typename taIterator>
-constexpr taIterator gLowerBound(taIterator inFirst, taIterator inLast, const auto& inElem)
+// inLess(a, b) must return true if a is before b (see Less).
+// Branchless: the range is halved at each step with a conditional move instead of a hard to predict branch, and the two
+// possible middles of the next step are prefetched.
+template<typename taIterator, typename taLess = Less>
+constexpr taIterator gLowerBound(taIterator inFirst, taIterator inLast, const auto& inElem, taLess inLess = {})
 {
 	auto first = inFirst;
 	auto count = inLast - first;
 
-    while (count > 0) 
+	if (count == 0)
+		return first;
+
+	while (count > 1)
 	{
-		auto count2 = count / 2;
-		auto mid    = first + count2;
+		auto half = count / 2;
 
-		if (*mid < inElem)
+		if constexpr (cIsPointer<taIterator>)
 		{
-			first = mid + 1;
-			count -= count2 + 1;
+			if (!gIsContantEvaluated())
+			{
+				auto next_half = (count - half) / 2;
+				gPrefetch(first + next_half);
+				gPrefetch(first + half + next_half);
+			}
 		}
-		else
-		{
-			count = count2;
-		}
-    }
 
-	return first;
+		first = inLess(first[half], inElem) ? first + half : first;
+		count -= half;
+	}
+
+	return inLess(*first, inElem) ? first + 1 : first;
 }
 
 
@@ -182,10 +189,67 @@ constexpr auto gEmplaceSorted(auto& ioContainer, const auto& inElem)
 }
 
 
+namespace Details
+{
+	// Types that gFind and gCount compare bitwise with SIMD instructions: integers, enums and pointers.
+	// Floats are excluded, NaN and -0 don't compare equal to their bits.
+	template <typename taType>
+	constexpr bool cIsBitwiseComparable = (cIsIntegral<taType> || cIsEnum<taType> || cIsPointer<taType>) && sizeof(taType) <= 8;
+
+	// True if searching for a taElem in a [taIterator, taIterator) range can use the SIMD versions.
+	// The range must be contiguous (a pointer), and the searched value must be of the same type as the elements (otherwise
+	// the comparison could involve a conversion).
+	template <typename taIterator, typename taElem>
+	constexpr bool cCanFindSIMD = cIsPointer<taIterator>
+		&& cIsBitwiseComparable<::RemoveCV<::RemovePointer<taIterator>>>
+		&& cIsSame<::RemoveCV<::RemovePointer<taIterator>>, ::RemoveCV<::RemoveReference<taElem>>>;
+
+	// Below this size (in bytes) the scalar loop is faster than calling the SIMD version.
+	constexpr int cFindSIMDMinSize = 16;
+
+	// SIMD versions of gFind and gCount, 16 bytes at a time (see Algorithm.cpp).
+	const uint8*  FindSIMD(const uint8* inBegin, const uint8* inEnd, uint8 inValue);
+	const uint16* FindSIMD(const uint16* inBegin, const uint16* inEnd, uint16 inValue);
+	const uint32* FindSIMD(const uint32* inBegin, const uint32* inEnd, uint32 inValue);
+	const uint64* FindSIMD(const uint64* inBegin, const uint64* inEnd, uint64 inValue);
+	int           CountSIMD(const uint8* inBegin, const uint8* inEnd, uint8 inValue);
+	int           CountSIMD(const uint16* inBegin, const uint16* inEnd, uint16 inValue);
+	int           CountSIMD(const uint32* inBegin, const uint32* inEnd, uint32 inValue);
+	int           CountSIMD(const uint64* inBegin, const uint64* inEnd, uint64 inValue);
+
+	template <typename taType>
+	force_inline constexpr bool UseFindSIMD(const taType* inBegin, const taType* inEnd)
+	{
+		return !gIsContantEvaluated() && (inEnd - inBegin) * (int64)sizeof(taType) >= cFindSIMDMinSize;
+	}
+
+	template <typename taType>
+	force_inline taType* FindBitwise(taType* inBegin, taType* inEnd, const ::RemoveCV<taType>& inValue)
+	{
+		using UInt = ::UnsignedOfSize<sizeof(taType)>;
+		return (taType*)FindSIMD((const UInt*)inBegin, (const UInt*)inEnd, __builtin_bit_cast(UInt, inValue));
+	}
+
+	template <typename taType>
+	force_inline int CountBitwise(const taType* inBegin, const taType* inEnd, const ::RemoveCV<taType>& inValue)
+	{
+		using UInt = ::UnsignedOfSize<sizeof(taType)>;
+		return CountSIMD((const UInt*)inBegin, (const UInt*)inEnd, __builtin_bit_cast(UInt, inValue));
+	}
+}
+
+
 // Find a value in the [inBegin, inEnd) range.
+// Uses SIMD instructions for contiguous ranges of integers, enums and pointers.
 template<typename taIterator>
 constexpr auto gFind(taIterator inBegin, taIterator inEnd, const auto& inElem)
 {
+	if constexpr (Details::cCanFindSIMD<taIterator, decltype(inElem)>)
+	{
+		if (Details::UseFindSIMD(inBegin, inEnd))
+			return Details::FindBitwise(inBegin, inEnd, inElem);
+	}
+
 	for (auto it = inBegin; it != inEnd; ++it)
 	{
 		if (*it == inElem)
@@ -210,6 +274,103 @@ constexpr auto gFind(const auto& inContainer, const auto& inElem)
 }
 
 
+// Find the first element in the [inBegin, inEnd) range that matches the predicate.
+template<typename taIterator>
+constexpr auto gFindIf(taIterator inBegin, taIterator inEnd, const auto& inPredicate)
+{
+	for (auto it = inBegin; it != inEnd; ++it)
+	{
+		if (inPredicate(*it))
+			return it;
+	}
+
+	return inEnd;
+}
+
+
+// Find the first element in a vector-like container that matches the predicate.
+constexpr auto gFindIf(auto& inContainer, const auto& inPredicate)
+{
+	return gFindIf(inContainer.Begin(), inContainer.End(), inPredicate);
+}
+
+
+// Find the first element in a vector-like container that matches the predicate.
+constexpr auto gFindIf(const auto& inContainer, const auto& inPredicate)
+{
+	return gFindIf(inContainer.Begin(), inContainer.End(), inPredicate);
+}
+
+
+// Check if a value is present in a vector-like container.
+constexpr bool gContains(const auto& inContainer, const auto& inElem)
+{
+	if constexpr (requires { inContainer.Begin(); inContainer.End(); })
+	{
+		return gFind(inContainer.Begin(), inContainer.End(), inElem) != inContainer.End();
+	}
+	else
+	{
+		for (auto& elem : inContainer)
+			if (elem == inElem)
+				return true;
+
+		return false;
+	}
+}
+
+
+// Count the number of elements equal to a value in the [inBegin, inEnd) range.
+// Uses SIMD instructions for contiguous ranges of integers, enums and pointers.
+template<typename taIterator>
+constexpr int gCount(taIterator inBegin, taIterator inEnd, const auto& inElem)
+{
+	if constexpr (Details::cCanFindSIMD<taIterator, decltype(inElem)>)
+	{
+		if (Details::UseFindSIMD(inBegin, inEnd))
+			return Details::CountBitwise(inBegin, inEnd, inElem);
+	}
+
+	int count = 0;
+	for (auto it = inBegin; it != inEnd; ++it)
+	{
+		if (*it == inElem)
+			count++;
+	}
+
+	return count;
+}
+
+
+// Count the number of elements equal to a value in a vector-like container.
+constexpr int gCount(const auto& inContainer, const auto& inElem)
+{
+	return gCount(inContainer.Begin(), inContainer.End(), inElem);
+}
+
+
+// Count the number of elements in the [inBegin, inEnd) range that match the predicate.
+template<typename taIterator>
+constexpr int gCountIf(taIterator inBegin, taIterator inEnd, const auto& inPredicate)
+{
+	int count = 0;
+	for (auto it = inBegin; it != inEnd; ++it)
+	{
+		if (inPredicate(*it))
+			count++;
+	}
+
+	return count;
+}
+
+
+// Count the number of elements in a vector-like container that match the predicate.
+constexpr int gCountIf(const auto& inContainer, const auto& inPredicate)
+{
+	return gCountIf(inContainer.Begin(), inContainer.End(), inPredicate);
+}
+
+
 // Erase an element from a vector-like container by swapping it with the last one and reducing the size by 1.
 constexpr void gSwapErase(auto& inContainer, const auto& inIterator)
 {
@@ -2,31 +2,122 @@
 #pragma once
 
 #include <Bedrock/Memory.h>
+#include <Bedrock/TypeTraits.h>
+#include <Bedrock/MemoryStats.h>
 #include <Bedrock/TempMemory.h>
 
 
+namespace Details
+{
+	// Helpers to update the memory counters of an allocator kind (see MemoryStats.h).
+	template <EMemoryKind taKind, typename taType>
+	force_inline taType* TrackAlloc(taType* inPtr, int inSize)
+	{
+		if (inPtr != nullptr) [[likely]]
+			gGetMemCounters(taKind).OnAlloc(inSize * (int64)sizeof(taType));
+		return inPtr;
+	}
+
+	template <EMemoryKind taKind, typename taType>
+	force_inline void TrackFree(int inSize)
+	{
+		gGetMemCounters(taKind).OnFree(inSize * (int64)sizeof(taType));
+	}
+
+	template <EMemoryKind taKind, typename taType>
+	force_inline bool TrackRealloc(bool inSuccess, int inCurrentSize, int inNewSize)
+	{
+		if (inSuccess)
+			gGetMemCounters(taKind).OnResize((inNewSize - (int64)inCurrentSize) * (int64)sizeof(taType));
+		return inSuccess;
+	}
+
+	// Return the largest alignment an allocator supports (see cMaxAlignment), or cMaxInt if it has no limit.
+	template <typename taAllocator>
+	consteval int GetMaxAlignment()
+	{
+		if constexpr (requires { taAllocator::cMaxAlignment; })
+			return taAllocator::cMaxAlignment;
+		else
+			return cMaxInt;
+	}
+}
+
+
+// Allocators take an optional alignment (a power of 2) in Allocate and Free. The same alignment must be passed to both.
+// Memory is only wasted when the alignment is larger than what the allocator provides by default.
+
+
 // Default allocator. Allocates from the heap.
 template <typename taType>
 struct DefaultAllocator
 {
 	// Allocate memory.
-	static taType*	Allocate(int inSize)				{ return (taType*)gMemAlloc(inSize * sizeof(taType)).mPtr; }
-	static void		Free(taType* inPtr, int inSize)		{ gMemFree({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }); }
+	static taType*	Allocate(int inSize, int inAlignment = alignof(taType))				{ return (taType*)gMemAllocAligned(inSize * sizeof(taType), inAlignment).mPtr; }
+	static void		Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))	{ gMemFreeAligned({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }, inAlignment); }
 
 	// Try changing the size of an existing allocation, return false if unsuccessful.
 	static bool		TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize)	{ gAssert(inPtr != nullptr); return false; }
+
+	// Allocate memory for at least ioSize elements. ioSize is updated with the number of elements that actually fit.
+	static taType*	AllocateAtLeast(int& ioSize, int inAlignment = alignof(taType));
+
+	// Change the size of an existing allocation, moving it if necessary. Only for types that can be moved with a memcpy.
+	// ioNewSize is updated like in AllocateAtLeast. Return nullptr on failure (inPtr stays valid).
+	static taType*	Reallocate(taType* inPtr, int inCurrentSize, int& ioNewSize, int inAlignment = alignof(taType));
 };
 
 
 
-// Temp memory allocator. Allocates from a thread-local global MemArena.
-// Falls back to the default allocator if temp memory runs out.
+// Allocates from the heap and keeps track of the memory in a MemTag (see MemoryStats.h).
+template <typename taType, MemTag& taTag>
+struct TaggedAllocator
+{
+	// Allocate memory.
+	static taType*	Allocate(int inSize, int inAlignment = alignof(taType))
+	{
+		taType* ptr = DefaultAllocator<taType>::Allocate(inSize, inAlignment);
+		if (ptr != nullptr) [[likely]]
+			taTag.GetCounters().OnAlloc(inSize * (int64)sizeof(taType));
+		return ptr;
+	}
+
+	static void		Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))
+	{
+		taTag.GetCounters().OnFree(inSize * (int64)sizeof(taType));
+		DefaultAllocator<taType>::Free(inPtr, inSize, inAlignment);
+	}
+
+	// Try changing the size of an existing allocation, return false if unsuccessful.
+	static bool		TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize)	{ return DefaultAllocator<taType>::TryRealloc(inPtr, inCurrentSize, inNewSize); }
+
+	// See DefaultAllocator.
+	static taType*	AllocateAtLeast(int& ioSize, int inAlignment = alignof(taType))
+	{
+		taType* ptr = DefaultAllocator<taType>::AllocateAtLeast(ioSize, inAlignment);
+		if (ptr != nullptr) [[likely]]
+			taTag.GetCounters().OnAlloc(ioSize * (int64)sizeof(taType));
+		return ptr;
+	}
+
+	static taType*	Reallocate(taType* inPtr, int inCurrentSize, int& ioNewSize, int inAlignment = alignof(taType))
+	{
+		taType* ptr = DefaultAllocator<taType>::Reallocate(inPtr, inCurrentSize, ioNewSize, inAlignment);
+		if (ptr != nullptr) [[likely]]
+			taTag.GetCounters().OnResize((ioNewSize - (int64)inCurrentSize) * (int64)sizeof(taType));
+		return ptr;
+	}
+};
+
+
+// Temp memory allocator. Allocates from a thread-local global arena (see TempMemArena).
+// Falls back to the default allocator if temp memory runs out (ie. it can't chain any more blocks).
 template <typename taType>
 struct TempAllocator
 {
 	// Allocate memory.
-	static taType*	Allocate(int inSize);
-	static void     Free(taType* inPtr, int inSize);
+	static taType*	Allocate(int inSize, int inAlignment = alignof(taType));
+	static void     Free(taType* inPtr, int inSize, int inAlignment = alignof(taType));
 
 	// Try changing the size of an existing allocation, return false if unsuccessful.
 	static bool		TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize);
@@ -43,8 +134,8 @@ struct ArenaAllocator
 	ArenaAllocator(MemArenaType& inArena) : mArena(&inArena) {}
 
 	// Allocate memory.
-	taType*				Allocate(int inSize)				{ return (taType*)mArena->Alloc(inSize * sizeof(taType)).mPtr; }
-	void				Free(taType* inPtr, int inSize)		{ mArena->Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }); }
+	taType*				Allocate(int inSize, int inAlignment = alignof(taType))				{ return Details::TrackAlloc<EMemoryKind::Arena>((taType*)mArena->Alloc(inSize * sizeof(taType), inAlignment).mPtr, inSize); }
+	void				Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))	{ Details::TrackFree<EMemoryKind::Arena, taType>(inSize); mArena->Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }, inAlignment); }
 
 	// Try changing the size of an existing allocation, return false if unsuccessful.
 	bool				TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize);
@@ -64,21 +155,24 @@ struct VMemAllocator
 {
 	using MemArenaType = VMemArena<0>; // Don't need to support any out of order free since the arena isn't shared.
 
-	static constexpr int64 cDefaultReservedSize = MemArenaType::cDefaultReservedSize; // By default the arena will reserve that much virtual memory.
-	static constexpr int64 cDefaultCommitSize   = MemArenaType::cDefaultCommitSize;   // By default the arena will commit that much virtual memory every time it grows.
+	static constexpr int64 cDefaultReservedSize  = MemArenaType::cDefaultReservedSize;  // By default the arena will reserve that much virtual memory.
+	static constexpr int64 cDefaultCommitSize    = MemArenaType::cDefaultCommitSize;    // By default the arena will commit that much virtual memory every time it grows.
+	static constexpr int64 cDefaultTrimThreshold = MemArenaType::cDefaultTrimThreshold; // By default the arena will decommit memory when more than that is committed but unused.
 
 	VMemAllocator() = default;
-	VMemAllocator(int inReservedSizeInBytes, int inCommitIncreaseSizeInBytes = cDefaultCommitSize)
-		: mArena(inReservedSizeInBytes, inCommitIncreaseSizeInBytes) {}
+	VMemAllocator(int inReservedSizeInBytes, int inCommitIncreaseSizeInBytes = cDefaultCommitSize, int64 inTrimThresholdInBytes = cDefaultTrimThreshold, 
+				  EVMemPageSize inPageSize = EVMemPageSize::Normal)
+		: mArena(inReservedSizeInBytes, inCommitIncreaseSizeInBytes, inTrimThresholdInBytes, inPageSize) {}
 
 	// Allocate memory.
-	taType*				Allocate(int inSize)				{ return (taType*)mArena.Alloc(inSize * sizeof(taType)).mPtr; }
-	void				Free(taType* inPtr, int inSize)		{ mArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }); }
+	taType*				Allocate(int inSize, int inAlignment = alignof(taType))				{ return Details::TrackAlloc<EMemoryKind::VMem>((taType*)mArena.Alloc(inSize * sizeof(taType), inAlignment).mPtr, inSize); }
+	void				Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))	{ Details::TrackFree<EMemoryKind::VMem, taType>(inSize); mArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }, inAlignment); }
 
 	// Try changing the size of an existing allocation, return false if unsuccessful.
 	bool				TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize);
 
 	int					MaxSize() const						{ return mArena.GetReservedSize() / sizeof(taType); }
+	MemArenaType*		GetArena()							{ return &mArena; }
 	const MemArenaType* GetArena() const					{ return &mArena; }
 
 private:
@@ -86,16 +180,24 @@ private:
 };
 
 
+// VMemAllocator only points to its virtual memory, it can be relocated with a memcpy.
+template <typename taType> inline constexpr bool cIsTriviallyRelocatable<VMemAllocator<taType>> = true;
+
+
 // Allocates from an internal FixedMemArena.
-template <typename taType, int taSize>
+// The buffer is aligned to taAlignment, allocations with a larger alignment will fail.
+template <typename taType, int taSize, int taAlignment = gMax((int)alignof(taType), MemArena<>::cAlignment)>
 struct FixedAllocator
 {
 	static constexpr int cMemAreanaSizeInBytes = (int)gAlignUp(taSize * sizeof(taType), MemArena<>::cAlignment);
-	using MemArenaType = FixedMemArena<cMemAreanaSizeInBytes, 0>; // Don't need to support any out of order free since the arena isn't shared.
+	using MemArenaType = FixedMemArena<cMemAreanaSizeInBytes, 0, taAlignment>; // Don't need to support any out of order free since the arena isn't shared.
+
+	// The buffer is sized for taSize elements only, there is no room for padding before an allocation with a larger alignment.
+	static constexpr int cMaxAlignment = taAlignment;
 
 	// Allocate memory.
-	taType*				Allocate(int inSize)				{ return (taType*)mArena.Alloc(inSize * sizeof(taType)).mPtr; }
-	void				Free(taType* inPtr, int inSize)		{ mArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }); }
+	taType*				Allocate(int inSize, int inAlignment = alignof(taType))				{ return Details::TrackAlloc<EMemoryKind::Fixed>((taType*)mArena.Alloc(inSize * sizeof(taType), inAlignment).mPtr, inSize); }
+	void				Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))	{ Details::TrackFree<EMemoryKind::Fixed, taType>(inSize); mArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }, inAlignment); }
 
 	// Try changing the size of an existing allocation, return false if unsuccessful.
 	bool				TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize);
@@ -109,25 +211,173 @@ private:
 
 
 
+// Stores up to taSize elements in an internal buffer, and allocates from taFallbackAllocator when more are needed.
+// Only one allocation can use the internal buffer at a time. Vector and String never need two, since they only allocate
+// a new block when the current one can't grow, and the internal buffer grows in place up to taSize.
+// Moving the allocator only moves the fallback allocator: containers have to move the elements of the internal buffer themselves (see IsInline).
+// AllocateAtLeast and Reallocate are provided when the fallback allocator provides them.
+// Note: The internal buffer is counted as EMemoryKind::Fixed memory, like the buffer of a FixedAllocator.
+template <typename taType, int taSize, typename taFallbackAllocator = DefaultAllocator<taType>>
+struct SmallAllocator : private taFallbackAllocator
+{
+	static_assert(taSize > 0);
+
+	using FallbackAllocator = taFallbackAllocator;
+
+	static constexpr int cInlineSize = taSize;
+
+	// Optional features of the fallback allocator (see DefaultAllocator).
+	static constexpr bool cFallbackHasAllocateAtLeast = requires (FallbackAllocator& ioAllocator, int& ioSize) { ioAllocator.AllocateAtLeast(ioSize, 1); };
+	static constexpr bool cFallbackHasReallocate      = requires (FallbackAllocator& ioAllocator, taType* inPtr, int& ioSize) { ioAllocator.Reallocate(inPtr, 0, ioSize, 1); };
+
+	SmallAllocator() = default;
+	SmallAllocator(FallbackAllocator&& inFallbackAllocator) : FallbackAllocator(gMove(inFallbackAllocator)) {}
+
+	SmallAllocator(SmallAllocator&& ioOther) : FallbackAllocator(gMove(ioOther.GetFallbackAllocator())) {}
+	SmallAllocator& operator=(SmallAllocator&& ioOther) { GetFallbackAllocator() = gMove(ioOther.GetFallbackAllocator()); return *this; }
+
+	// Allocate memory.
+	taType*					Allocate(int inSize, int inAlignment = alignof(taType))
+	{
+		if (inSize <= taSize && inAlignment <= (int)alignof(taType)) [[likely]]
+			return Details::TrackAlloc<EMemoryKind::Fixed>((taType*)mBuffer, inSize);
+
+		return FallbackAllocator::Allocate(inSize, inAlignment);
+	}
+
+	void					Free(taType* inPtr, int inSize, int inAlignment = alignof(taType))
+	{
+		if (IsInline(inPtr)) [[likely]]
+			Details::TrackFree<EMemoryKind::Fixed, taType>(inSize);
+		else
+			FallbackAllocator::Free(inPtr, inSize, inAlignment);
+	}
+
+	// Try changing the size of an existing allocation, return false if unsuccessful.
+	bool					TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize)
+	{
+		gAssert(inPtr != nullptr); // Call Allocate instead.
+
+		if (IsInline(inPtr))
+			return Details::TrackRealloc<EMemoryKind::Fixed, taType>(inNewSize <= taSize, inCurrentSize, inNewSize);
+
+		return FallbackAllocator::TryRealloc(inPtr, inCurrentSize, inNewSize);
+	}
+
+	// See DefaultAllocator. When the internal buffer is used, ioSize is left unchanged (the buffer grows in place up to taSize anyway).
+	taType*					AllocateAtLeast(int& ioSize, int inAlignment = alignof(taType)) requires cFallbackHasAllocateAtLeast
+	{
+		if (ioSize <= taSize && inAlignment <= (int)alignof(taType)) [[likely]]
+			return Details::TrackAlloc<EMemoryKind::Fixed>((taType*)mBuffer, ioSize);
+
+		return FallbackAllocator::AllocateAtLeast(ioSize, inAlignment);
+	}
+
+	// See DefaultAllocator. Memory is moved from the internal buffer to the fallback allocator, but never back (see ShrinkToFit in containers).
+	taType*					Reallocate(taType* inPtr, int inCurrentSize, int& ioNewSize, int inAlignment = alignof(taType)) requires cFallbackHasReallocate
+	{
+		gAssert(inPtr != nullptr); // Call Allocate instead.
+
+		if (!IsInline(inPtr))
+			return FallbackAllocator::Reallocate(inPtr, inCurrentSize, ioNewSize, inAlignment);
+
+		if (ioNewSize <= taSize)
+		{
+			Details::TrackRealloc<EMemoryKind::Fixed, taType>(true, inCurrentSize, ioNewSize);
+			return inPtr;
+		}
+
+		taType* ptr;
+		if constexpr (cFallbackHasAllocateAtLeast)
+			ptr = FallbackAllocator::AllocateAtLeast(ioNewSize, inAlignment);
+		else
+			ptr = FallbackAllocator::Allocate(ioNewSize, inAlignment);
+
+		if (ptr == nullptr) [[unlikely]]
+			return nullptr;
+
+		gMemCopy(ptr, inPtr, inCurrentSize * (int64)sizeof(taType));
+		Details::TrackFree<EMemoryKind::Fixed, taType>(inCurrentSize);
+		return ptr;
+	}
+
+	// Return true if inPtr points to the internal buffer.
+	bool					IsInline(const taType* inPtr) const		{ return inPtr == (const taType*)mBuffer; }
+
+	FallbackAllocator&		GetFallbackAllocator()					{ return *this; }
+	const FallbackAllocator& GetFallbackAllocator() const			{ return *this; }
+
+private:
+	alignas(taType) uint8	mBuffer[taSize * sizeof(taType)];
+};
+
+
 template <typename taType>
-taType* TempAllocator<taType>::Allocate(int inSize)
+taType* DefaultAllocator<taType>::AllocateAtLeast(int& ioSize, int inAlignment)
 {
-	MemBlock mem = gTempMemArena.Alloc(inSize * sizeof(taType));
+	if (inAlignment > cMemDefaultAlignment) [[unlikely]]
+		return Allocate(ioSize, inAlignment);
+
+	MemBlock mem = gMemAllocAtLeast(ioSize * (int64)sizeof(taType), (int)sizeof(taType));
+	if (mem == nullptr) [[unlikely]]
+		return nullptr;
+
+	ioSize = (int)gMin(mem.mSize / (int64)sizeof(taType), (int64)cMaxInt);
+	return (taType*)mem.mPtr;
+}
+
+
+template <typename taType>
+taType* DefaultAllocator<taType>::Reallocate(taType* inPtr, int inCurrentSize, int& ioNewSize, int inAlignment)
+{
+	gAssert(inPtr != nullptr); // Call Allocate instead.
+
+	if (inAlignment > cMemDefaultAlignment) [[unlikely]]
+	{
+		// Over-aligned allocations can't be resized, allocate a new one instead.
+		taType* ptr = Allocate(ioNewSize, inAlignment);
+		if (ptr == nullptr) [[unlikely]]
+			return nullptr;
+
+		gMemCopy(ptr, inPtr, gMin(inCurrentSize, ioNewSize) * (int64)sizeof(taType));
+		Free(inPtr, inCurrentSize, inAlignment);
+		return ptr;
+	}
+
+	MemBlock mem = gMemRealloc({ (uint8*)inPtr, inCurrentSize * (int64)sizeof(taType) }, ioNewSize * (int64)sizeof(taType), (int)sizeof(taType));
+	if (mem == nullptr) [[unlikely]]
+		return nullptr;
+
+	ioNewSize = (int)gMin(mem.mSize / (int64)sizeof(taType), (int64)cMaxInt);
+	return (taType*)mem.mPtr;
+}
+
+
+template <typename taType>
+taType* TempAllocator<taType>::Allocate(int inSize, int inAlignment)
+{
+	MemBlock mem = gTempMemArena.Alloc(inSize * sizeof(taType), inAlignment);
 
 	if (mem != nullptr) [[likely]]
-		return (taType*)mem.mPtr;
+		return Details::TrackAlloc<EMemoryKind::Temp>((taType*)mem.mPtr, inSize);
 
-	return DefaultAllocator<taType>::Allocate(inSize);
+	return Details::TrackAlloc<EMemoryKind::TempFallback>(DefaultAllocator<taType>::Allocate(inSize, inAlignment), inSize);
 }
 
 
 template <typename taType>
-void TempAllocator<taType>::Free(taType* inPtr, int inSize)
+void TempAllocator<taType>::Free(taType* inPtr, int inSize, int inAlignment)
 {
 	if (gTempMemArena.Owns(inPtr)) [[likely]]
-		gTempMemArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) });
+	{
+		Details::TrackFree<EMemoryKind::Temp, taType>(inSize);
+		gTempMemArena.Free({ (uint8*)inPtr, inSize * (int64)sizeof(taType) }, inAlignment);
+	}
 	else
-		DefaultAllocator<taType>::Free(inPtr, inSize);
+	{
+		Details::TrackFree<EMemoryKind::TempFallback, taType>(inSize);
+		DefaultAllocator<taType>::Free(inPtr, inSize, inAlignment);
+	}
 }
 
 
@@ -143,7 +393,7 @@ bool TempAllocator<taType>::TryRealloc(taType* inPtr, int inCurrentSize, int inN
 		// With the TempAllocator, only try to resize the last alloc!
 		// Otherwise doing a new alloc is going to waste a lot of memory very quickly.
 		gAssert(gTempMemArena.IsLastAlloc(mem));
-		return gTempMemArena.TryRealloc(mem, inNewSize * sizeof(taType));
+		return Details::TrackRealloc<EMemoryKind::Temp, taType>(gTempMemArena.TryRealloc(mem, inNewSize * sizeof(taType)), inCurrentSize, inNewSize);
 	}
 	
 	return DefaultAllocator<taType>::TryRealloc(inPtr, inCurrentSize, inNewSize);
@@ -156,7 +406,7 @@ bool ArenaAllocator<taType, taMemArenaType>::TryRealloc(taType* inPtr, int inCur
 	gAssert(inPtr != nullptr); // Call Allocate instead.
 
 	MemBlock mem = { (uint8*)inPtr, inCurrentSize * (int64)sizeof(taType) };
-	return mArena->TryRealloc(mem, inNewSize * sizeof(taType));
+	return Details::TrackRealloc<EMemoryKind::Arena, taType>(mArena->TryRealloc(mem, inNewSize * sizeof(taType)), inCurrentSize, inNewSize);
 }
 
 
@@ -166,15 +416,15 @@ bool VMemAllocator<taType>::TryRealloc(taType* inPtr, int inCurrentSize, int inN
 	gAssert(inPtr != nullptr); // Call Allocate instead.
 
 	MemBlock mem = { (uint8*)inPtr, inCurrentSize * (int64)sizeof(taType) };
-	return mArena.TryRealloc(mem, inNewSize * sizeof(taType));
+	return Details::TrackRealloc<EMemoryKind::VMem, taType>(mArena.TryRealloc(mem, inNewSize * sizeof(taType)), inCurrentSize, inNewSize);
 }
 
 
-template <typename taType, int taSize>
-bool FixedAllocator<taType, taSize>::TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize)
+template <typename taType, int taSize, int taAlignment>
+bool FixedAllocator<taType, taSize, taAlignment>::TryRealloc(taType* inPtr, int inCurrentSize, int inNewSize)
 {
 	gAssert(inPtr != nullptr); // Call Allocate instead.
 
 	MemBlock mem = { (uint8*)inPtr, inCurrentSize * (int64)sizeof(taType) };
-	return mArena.TryRealloc(mem, inNewSize * sizeof(taType));
+	return Details::TrackRealloc<EMemoryKind::Fixed, taType>(mArena.TryRealloc(mem, inNewSize * sizeof(taType)), inCurrentSize, inNewSize);
 }
@@ -2,7 +2,13 @@
 #pragma once
 
 // Break to the debugger (or crash if no debugger is attached).
+#ifdef _MSC_VER
 #define BREAKPOINT __debugbreak()
+#elif __clang__
+#define BREAKPOINT __builtin_debugtrap()
+#else
+#error Unknown compiler
+#endif
 
 // Cause a crash.
 #ifdef __clang__
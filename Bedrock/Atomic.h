@@ -4,6 +4,8 @@
 #include <Bedrock/Core.h>
 #include <Bedrock/TypeTraits.h>
 
+#ifdef _MSC_VER
+
 #define PUSH_DISABLE_DEPRECATED_WARNING __pragma(warning(push)) __pragma(warning(disable : 4996))
 #define POP_WARNING __pragma(warning(pop))
 
@@ -31,15 +33,23 @@ extern "C"
 
 #define COMPILER_BARRIER() PUSH_DISABLE_DEPRECATED_WARNING _ReadWriteBarrier() POP_WARNING
 
+#else
+
+// Outside of MSVC (and clang-cl), use the GCC/Clang atomic builtins instead of the MSVC intrinsics.
+#define COMPILER_BARRIER() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+#endif
+
 template <typename taType>
 struct Atomic;
 
+// Note: Acquire and Release only need a compiler barrier, because on x64 all loads have acquire semantics and all stores have release semantics.
 enum class MemoryOrder
 {
 	Relaxed,
 	//Consume,	// TODO?
-	//Acquire,
-	//Release,
+	Acquire,	// Only for Load.
+	Release,	// Only for Store.
 	//AcqRel,
 	SeqCst,
 };
@@ -60,7 +70,7 @@ struct Atomic : NoCopy
 
 	Atomic() = default;
 	~Atomic() = default;
-	Atomic(ValueType inValue) : mValue(inValue) {}
+	constexpr Atomic(ValueType inValue) : mValue(inValue) {}
 
 	ValueType	Load(MemoryOrder inOrder = MemoryOrder::SeqCst) const;
 	void		Store(ValueType inValue, MemoryOrder inOrder = MemoryOrder::SeqCst);
@@ -95,16 +105,24 @@ typename Atomic<taType>::ValueType Atomic<taType>::Load(MemoryOrder inOrder) con
 	StorageType value;
 	auto        storage_ptr = (const StorageType*)&mValue;
 
+#ifdef _MSC_VER
 	if constexpr(sizeof(taType) == 8)
 		value = __iso_volatile_load64(storage_ptr);
 	else if constexpr(sizeof(taType) == 4)
 		value = __iso_volatile_load32((const int*)storage_ptr);
 	else
 		value = __iso_volatile_load8(storage_ptr);
+#else
+	value = __atomic_load_n(storage_ptr, __ATOMIC_RELAXED);
+#endif
+
+	gAssert(inOrder != MemoryOrder::Release);
 
 	switch (inOrder)
 	{
 	case MemoryOrder::Relaxed:	break;
+	case MemoryOrder::Acquire:	COMPILER_BARRIER(); break;
+	case MemoryOrder::Release:	break;
 	case MemoryOrder::SeqCst:	COMPILER_BARRIER(); break;
 	}
 
@@ -118,26 +136,40 @@ void Atomic<taType>::Store(ValueType inValue, MemoryOrder inOrder)
 	StorageType new_value   = sAsStorage(inValue);
 	auto        storage_ptr = (StorageType*)&mValue;
 
+	gAssert(inOrder != MemoryOrder::Acquire);
+
 	switch (inOrder)
 	{
+	case MemoryOrder::Release:
+		COMPILER_BARRIER(); // Previous writes must not be moved after the store.
+		[[fallthrough]];
+
 	case MemoryOrder::Relaxed: 
 	{
+#ifdef _MSC_VER
 		if constexpr(sizeof(taType) == 8)
 			__iso_volatile_store64(storage_ptr, new_value);
 		else if constexpr(sizeof(taType) == 4)
 			__iso_volatile_store32((int*)storage_ptr, new_value);
 		else
 			__iso_volatile_store8(storage_ptr, new_value);
+#else
+		__atomic_store_n(storage_ptr, new_value, __ATOMIC_RELAXED);
+#endif
 		break;
 	}
 			
 	case MemoryOrder::SeqCst:
+#ifdef _MSC_VER
 		if constexpr(sizeof(taType) == 8)
 			_InterlockedExchange64(storage_ptr, new_value);
 		else if constexpr(sizeof(taType) == 4)
 			_InterlockedExchange(storage_ptr, new_value);
 		else
 			_InterlockedExchange8(storage_ptr, new_value);
+#else
+		__atomic_store_n(storage_ptr, new_value, __ATOMIC_SEQ_CST);
+#endif
 		break;
 	}
 }
@@ -150,12 +182,16 @@ typename Atomic<taType>::ValueType Atomic<taType>::Exchange(ValueType inValue, M
 	auto        storage_ptr = (StorageType*)&mValue;
 	StorageType previous_value;
 
+#ifdef _MSC_VER
 	if constexpr(sizeof(taType) == 8)
 		previous_value = _InterlockedExchange64(storage_ptr, new_value);
 	else if constexpr(sizeof(taType) == 4)
 		previous_value = _InterlockedExchange(storage_ptr, new_value);
 	else
 		previous_value = _InterlockedExchange8(storage_ptr, new_value);
+#else
+	previous_value = __atomic_exchange_n(storage_ptr, new_value, __ATOMIC_SEQ_CST);
+#endif
 
 	return sAsValue(previous_value);
 }
@@ -169,12 +205,17 @@ bool Atomic<taType>::CompareExchange(ValueType& ioExpected, ValueType inDesired)
 	auto        storage_ptr = (StorageType*)&mValue;
 	StorageType previous_value;
 
+#ifdef _MSC_VER
 	if constexpr(sizeof(taType) == 8)
 		previous_value = _InterlockedCompareExchange64(storage_ptr, desired, expected);
 	else if constexpr(sizeof(taType) == 4)
 		previous_value = _InterlockedCompareExchange(storage_ptr, desired, expected);
 	else
 		previous_value = _InterlockedCompareExchange8(storage_ptr, desired, expected);
+#else
+	previous_value = expected;
+	__atomic_compare_exchange_n(storage_ptr, &previous_value, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
 
 	bool exchanged = (previous_value == expected);
 
@@ -192,12 +233,16 @@ typename Atomic<taType>::ValueType Atomic<taType>::Add(ValueType inValue, Memory
 	auto        storage_ptr  = (StorageType*)&mValue;
 	StorageType previous_value;
 
+#ifdef _MSC_VER
 	if constexpr(sizeof(taType) == 8)
 		previous_value = _InterlockedExchangeAdd64(storage_ptr, value_to_add);
 	else if constexpr(sizeof(taType) == 4)
 		previous_value = _InterlockedExchangeAdd(storage_ptr, value_to_add);
 	else
 		previous_value = _InterlockedExchangeAdd8(storage_ptr, value_to_add);
+#else
+	previous_value = __atomic_fetch_add(storage_ptr, value_to_add, __ATOMIC_SEQ_CST);
+#endif
 
 	return sAsValue(previous_value);
 }
@@ -244,7 +289,7 @@ typename Atomic<taType>::ValueType Atomic<taType>::sAsValue(StorageType inStorag
 		// The only way of converting unrelated types that is non UB is memcpy.
 		// This will be optimized out in practice.
 		ValueType value;
-		memcpy(&value, &inStorage, sizeof(inStorage));
+		gMemCopy(&value, &inStorage, sizeof(inStorage));
 		return value;
 	}
 }
@@ -262,7 +307,7 @@ typename Atomic<taType>::StorageType Atomic<taType>::sAsStorage(ValueType inValu
 		// The only way of converting unrelated types that is non UB is memcpy.
 		// This will be optimized out in practice.
 		StorageType storage;
-		memcpy(&storage, &inValue, sizeof(inValue));
+		gMemCopy(&storage, &inValue, sizeof(inValue));
 		return storage;
 	}
 }
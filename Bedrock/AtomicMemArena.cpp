@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/AtomicMemArena.h>
+#include <Bedrock/MemoryStats.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/HashMap.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/Test.h>
+
+
+AtomicMemArena::AtomicMemArena(MemBlock inMemory)
+{
+	gAssert(((uint64)inMemory.mPtr % cAlignment) == 0);	// Pointer should be aligned.
+
+	mBeginPtr          = inMemory.mPtr;
+	mEndReservedOffset = inMemory.mSize;
+	mEndCommittedOffset.Store(inMemory.mSize);
+}
+
+
+AtomicMemArena::AtomicMemArena(int64 inReservedSize, int64 inCommitIncreaseSize)
+{
+	// Replace parameters by defaults if necessary.
+	if (inReservedSize <= 0)
+		inReservedSize = cDefaultReservedSize;
+	if (inCommitIncreaseSize <= 0)
+		inCommitIncreaseSize = cDefaultCommitSize;
+
+	MemBlock reserved_mem = gVMemReserve(inReservedSize);
+	mBeginPtr             = reserved_mem.mPtr;
+	mEndReservedOffset    = reserved_mem.mSize;
+	mCommitIncreaseSize   = gAlignUp(inCommitIncreaseSize, (int64)gVMemCommitGranularity());
+	mIsVMem               = true;
+}
+
+
+bool AtomicMemArena::TryRealloc(MemBlock& ioMemory, int inNewSize)
+{
+	gAssert(Owns(ioMemory.mPtr));
+
+	int64 end_offset     = (ioMemory.mPtr - mBeginPtr) + gAlignUp(ioMemory.mSize, (int64)cAlignment);
+	int64 new_end_offset = (ioMemory.mPtr - mBeginPtr) + gAlignUp(inNewSize, cAlignment);
+
+	// Commit first, so that other threads never see an offset past the committed memory.
+	if (new_end_offset > mEndCommittedOffset.Load()) [[unlikely]]
+	{
+		if (!CommitMore(new_end_offset))
+			return false;
+	}
+
+	// Only succeeds if ioMemory is still the last allocation.
+	if (!mCurrentOffset.CompareExchange(end_offset, new_end_offset))
+		return false;
+
+	ioMemory.mSize = inNewSize;
+	return true;
+}
+
+
+bool AtomicMemArena::CommitMore(int64 inNewEndOffset)
+{
+	if (inNewEndOffset > mEndReservedOffset) [[unlikely]]
+		return false; // Doesn't fit.
+
+	if (!mIsVMem)
+		return false; // Fixed memory can't grow (and is entirely committed already).
+
+	// Several threads can commit at the same time. Committing memory that is already committed is fine,
+	// the only thing to synchronize is the committed offset, which can only increase.
+	int64 end_committed_offset = mEndCommittedOffset.Load();
+	while (end_committed_offset < inNewEndOffset)
+	{
+		int64 new_end_committed_offset = gMax(inNewEndOffset, end_committed_offset + mCommitIncreaseSize);
+		new_end_committed_offset       = gMin(gAlignUp(new_end_committed_offset, (int64)gVMemCommitGranularity()), mEndReservedOffset);
+
+		MemBlock committed_mem = gVMemCommit({ mBeginPtr + end_committed_offset, new_end_committed_offset - end_committed_offset });
+		if (committed_mem == nullptr) [[unlikely]]
+			return false; // Out of memory.
+
+		if (mEndCommittedOffset.CompareExchange(end_committed_offset, new_end_committed_offset))
+		{
+			gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(new_end_committed_offset - end_committed_offset);
+			return true;
+		}
+
+		// Another thread committed more memory in the meantime, end_committed_offset was updated. Check again.
+	}
+
+	return true;
+}
+
+
+void AtomicMemArena::FreeReserved()
+{
+	if (mBeginPtr == nullptr || !mIsVMem)
+		return;
+
+	gVMemFree({ mBeginPtr, mEndReservedOffset });
+	gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(-mEndCommittedOffset.Load());
+	mBeginPtr = nullptr;
+}
+
+
+REGISTER_TEST("AtomicMemArena")
+{
+	alignas(AtomicMemArena::cAlignment) uint8 buffer[256];
+	AtomicMemArena arena({ buffer, sizeof(buffer) });
+
+	MemBlock b1 = arena.Alloc(1);
+	MemBlock b2 = arena.Alloc(20);
+	TEST_TRUE(b1.mPtr == buffer);
+	TEST_TRUE(b2.mPtr == buffer + 16);
+	TEST_TRUE(arena.GetAllocatedSize() == 48);
+
+	// Only the last allocation can grow.
+	TEST_FALSE(arena.TryRealloc(b1, 32));
+	TEST_TRUE(arena.TryRealloc(b2, 64));
+	TEST_TRUE(arena.GetAllocatedSize() == 80);
+
+	// Larger alignment.
+	MemBlock b3 = arena.Alloc(16, 64);
+	TEST_TRUE(((uint64)b3.mPtr % 64) == 0);
+
+	// Full. Failing doesn't prevent smaller allocations.
+	TEST_TRUE(arena.Alloc(256) == nullptr);
+	TEST_TRUE(arena.Alloc(16) != nullptr);
+
+	arena.Free(b1);
+	arena.Reset();
+	TEST_TRUE(arena.GetAllocatedSize() == 0);
+	TEST_TRUE(arena.Alloc(256).mPtr == buffer);
+};
+
+
+REGISTER_TEST("AtomicMemArena Threads")
+{
+	constexpr int cNumThreads = 4;
+	constexpr int cNumAllocs  = 10000;
+
+	AtomicMemArena arena(64_MiB, 64_KiB);
+
+	// Each thread fills its own vector of allocations, all from the same arena.
+	Vector<int*, AtomicArenaAllocator<int*>> allocs[cNumThreads];
+	for (auto& thread_allocs : allocs)
+		thread_allocs = Vector<int*, AtomicArenaAllocator<int*>>(AtomicArenaAllocator<int*>(arena));
+
+	{
+		Thread threads[cNumThreads];
+		for (int t = 0; t < cNumThreads; ++t)
+		{
+			threads[t].Create({ .mName = "AtomicMemArenaTest" }, [&arena, &allocs, t](Thread&)
+			{
+				for (int i = 0; i < cNumAllocs; ++i)
+				{
+					int* value = (int*)arena.Alloc(sizeof(int)).mPtr;
+					*value     = t * cNumAllocs + i;
+					allocs[t].PushBack(value);
+				}
+			});
+		}
+	}
+
+	// All allocations are distinct and still hold their value.
+	for (int t = 0; t < cNumThreads; ++t)
+	{
+		TEST_TRUE(allocs[t].Size() == cNumAllocs);
+		for (int i = 0; i < cNumAllocs; ++i)
+			TEST_TRUE(*allocs[t][i] == t * cNumAllocs + i);
+	}
+
+	TEST_TRUE(arena.GetCommittedSize() >= arena.GetAllocatedSize());
+
+	// Containers can keep allocating from the same arena.
+	{
+		HashMap<int, int, Hash<int>, AtomicArenaAllocator> map(arena);
+		for (int i = 0; i < 1000; ++i)
+			map.Insert(i, i * 2);
+		TEST_TRUE(map.Size() == 1000);
+		TEST_TRUE(map.Find(500)->mValue == 1000);
+	}
+
+	for (auto& thread_allocs : allocs)
+		thread_allocs.ClearAndFreeMemory();
+	arena.Reset();
+};
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Memory.h>
+#include <Bedrock/MemoryArena.h>
+#include <Bedrock/Atomic.h>
+#include <Bedrock/Allocator.h>
+
+
+// Linear allocator that can be shared between threads. Alloc is lock-free (a fetch-add on the current offset).
+// Individual allocations are never freed: everything is freed at once with Reset, once no thread uses the arena anymore.
+// Can be initialized with a fixed MemBlock, or with virtual memory that is committed as needed (also lock-free).
+// Can be used with containers through AtomicArenaAllocator (each container must still be used by a single thread at a time).
+struct AtomicMemArena : NoCopy
+{
+	static constexpr int   cAlignment           = MemArena<>::cAlignment;
+	static constexpr int64 cDefaultReservedSize = 1_GiB;  // By default the arena will reserve that much virtual memory.
+	static constexpr int64 cDefaultCommitSize   = 1_MiB;  // By default the arena will commit that much virtual memory every time it grows.
+
+	AtomicMemArena() = default;
+	~AtomicMemArena() { FreeReserved(); }
+
+	// Initialize this arena with a memory block.
+	AtomicMemArena(MemBlock inMemory);
+
+	// Initialize this arena with reserved memory (but no committed memory yet).
+	AtomicMemArena(int64 inReservedSize, int64 inCommitIncreaseSize = cDefaultCommitSize);
+
+	// Allocate memory. Can be called from any thread.
+	// Allocations are aligned to cAlignment, or to inAlignment if it is larger (in which case up to inAlignment - cAlignment bytes are wasted).
+	// Return a nullptr MemBlock if the arena is full.
+	MemBlock Alloc(int inSize, int inAlignment = cAlignment)
+	{
+		gAssert(mBeginPtr != nullptr); // Need to initialize first.
+		gAssert(gIsPow2(inAlignment));
+
+		int64 aligned_size = gAlignUp(inSize, cAlignment);
+		if (inAlignment > cAlignment) [[unlikely]]
+			aligned_size += inAlignment - cAlignment; // Reserve enough for the worst case padding instead of looping on a compare exchange.
+
+		int64 offset     = mCurrentOffset.Add(aligned_size);
+		int64 end_offset = offset + aligned_size;
+
+		// Check if we need to commit more memory.
+		if (end_offset > mEndCommittedOffset.Load()) [[unlikely]]
+		{
+			if (!CommitMore(end_offset))
+			{
+				// Give the memory back if nothing else was allocated in the meantime, so that smaller allocations can still succeed.
+				(void)mCurrentOffset.CompareExchange(end_offset, offset);
+				return {}; // Allocation failed.
+			}
+		}
+
+		uint8* ptr = mBeginPtr + offset;
+		if (inAlignment > cAlignment) [[unlikely]]
+			ptr = (uint8*)gAlignUp((uint64)ptr, (uint64)inAlignment);
+
+		return { ptr, inSize };
+	}
+
+	// Individual frees are ignored, memory is only freed by Reset.
+	void Free(MemBlock inMemory, int inAlignment = cAlignment) { gAssert(Owns(inMemory.mPtr)); }
+
+	// Try resizing ioMemory. Only works if ioMemory is the last allocation and no other thread allocates at the same time.
+	bool TryRealloc(MemBlock& ioMemory, int inNewSize);
+
+	// Free all the allocations at once. No other thread must be using the arena during the call or afterward with previous allocations.
+	// Committed memory is kept for the next allocations.
+	void Reset() { mCurrentOffset.Store(0); }
+
+	// Return true if inMemoryPtr is inside this arena.
+	bool Owns(const void* inMemoryPtr) const
+	{
+		return ((const uint8*)inMemoryPtr >= mBeginPtr && (const uint8*)inMemoryPtr < (mBeginPtr + mEndReservedOffset));
+	}
+
+	// Return the amount of memory currently allocated (including padding).
+	int64 GetAllocatedSize() const	{ return gMin(mCurrentOffset.Load(MemoryOrder::Relaxed), mEndReservedOffset); }
+	int64 GetReservedSize() const	{ return mEndReservedOffset; }
+	int64 GetCommittedSize() const	{ return mEndCommittedOffset.Load(MemoryOrder::Relaxed); }
+
+private:
+	bool CommitMore(int64 inNewEndOffset);
+	void FreeReserved();
+
+	uint8*      mBeginPtr           = nullptr;
+	int64       mEndReservedOffset  = 0;
+	int64       mCommitIncreaseSize = 0;
+	bool        mIsVMem             = false;
+	AtomicInt64 mCurrentOffset      = 0;
+	AtomicInt64 mEndCommittedOffset = 0;
+};
+
+
+// ArenaAllocator using an AtomicMemArena. The arena needs to be passed to the container before it can be used.
+//
+//		Vector<int, AtomicArenaAllocator<int>>             vector(AtomicArenaAllocator<int>{ arena });
+//		HashMap<int, int, Hash<int>, AtomicArenaAllocator> map(arena);
+//
+template <typename taType>
+using AtomicArenaAllocator = ArenaAllocator<taType, AtomicMemArena>;
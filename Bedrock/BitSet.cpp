@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/BitSet.h>
+#include <Bedrock/Test.h>
+
+
+// BitSet is usable in constexpr.
+static_assert([]
+{
+	BitSet<100> bits;
+	bits.Set(3);
+	bits.Set(99);
+	return bits.CountSetBits() == 2 && bits.FindFirstSet(4) == 99;
+}());
+
+
+REGISTER_TEST("BitSet")
+{
+	BitSet<130> bits;
+	TEST_TRUE(bits.Size() == 130);
+	TEST_TRUE(bits.cNumWords == 3);
+	TEST_TRUE(bits.NoneSet());
+	TEST_TRUE(bits.FindFirstSet() == -1);
+	TEST_TRUE(bits.FindFirstUnset() == 0);
+
+	bits.Set(0);
+	bits.Set(64);
+	bits.Set(129);
+	TEST_TRUE(bits.Test(0));
+	TEST_TRUE(bits[64]);
+	TEST_FALSE(bits[65]);
+	TEST_TRUE(bits.CountSetBits() == 3);
+	TEST_TRUE(bits.AnySet());
+
+	TEST_TRUE(bits.FindFirstSet() == 0);
+	TEST_TRUE(bits.FindFirstSet(1) == 64);
+	TEST_TRUE(bits.FindFirstSet(65) == 129);
+	TEST_TRUE(bits.FindFirstSet(130) == -1);
+	TEST_TRUE(bits.FindFirstUnset() == 1);
+	TEST_TRUE(bits.FindFirstUnset(64) == 65);
+
+	int indices[4] = {};
+	int count      = 0;
+	bits.ForEachSetBit([&](int inIndex) { indices[count++] = inIndex; });
+	TEST_TRUE(count == 3);
+	TEST_TRUE(indices[0] == 0);
+	TEST_TRUE(indices[1] == 64);
+	TEST_TRUE(indices[2] == 129);
+
+	bits.Unset(64);
+	TEST_FALSE(bits[64]);
+	bits.Assign(64, true);
+	TEST_TRUE(bits[64]);
+
+	// The unused bits of the last word stay 0.
+	bits.SetAll();
+	TEST_TRUE(bits.AllSet());
+	TEST_TRUE(bits.CountSetBits() == 130);
+	TEST_TRUE(bits.FindFirstUnset() == -1);
+	bits.Flip();
+	TEST_TRUE(bits.NoneSet());
+	bits.Flip();
+	TEST_TRUE(bits.CountSetBits() == 130);
+	bits.UnsetAll();
+	TEST_TRUE(bits.NoneSet());
+};
+
+
+REGISTER_TEST("BitSet Operations")
+{
+	BitSet<200> a, b;
+	for (int i = 0; i < 200; i += 2)
+		a.Set(i);
+	for (int i = 0; i < 200; i += 3)
+		b.Set(i);
+
+	TEST_TRUE((a & b).CountSetBits() == 34);	// Multiples of 6.
+	TEST_TRUE((a | b).CountSetBits() == 133);	// 100 + 67 - 34.
+	TEST_TRUE((a ^ b).CountSetBits() == 99);
+	TEST_TRUE(BitSet(a).AndNot(b).CountSetBits() == 66);
+
+	BitSet<200> c = a;
+	TEST_TRUE(c == a);
+	c &= b;
+	TEST_FALSE(c == a);
+	c |= a;
+	TEST_TRUE(c == a);
+	c ^= a;
+	TEST_TRUE(c.NoneSet());
+};
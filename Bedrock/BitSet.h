@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Span.h>
+
+
+namespace Details
+{
+	// Operations on arrays of 64-bit words, shared by BitSet and BitVector.
+	// The unused bits of the last word must always be 0, so that counting and comparing don't need to mask them.
+	// Note: The bulk operations are simple loops over whole words, so that the compiler can vectorize them.
+
+	constexpr int    gGetNumBitWords(int inNumBits)		{ return (int)((uint32)(inNumBits + 63) / 64); }
+	constexpr uint64 gGetBitMask(int inIndex)			{ return (uint64)1 << ((uint32)inIndex % 64); }
+	constexpr int    gGetBitWordIndex(int inIndex)		{ return (int)((uint32)inIndex / 64); }
+
+	// Mask of the used bits in the last word.
+	constexpr uint64 gGetLastBitWordMask(int inNumBits)	{ return ((uint32)inNumBits % 64) == 0 ? cMaxUInt64 : gGetBitMask(inNumBits) - 1; }
+
+	constexpr bool gTestBit(const uint64* inWords, int inIndex) { return (inWords[gGetBitWordIndex(inIndex)] & gGetBitMask(inIndex)) != 0; }
+
+	constexpr void gAssignBit(uint64* ioWords, int inIndex, bool inValue)
+	{
+		uint64& word = ioWords[gGetBitWordIndex(inIndex)];
+		uint64  mask = gGetBitMask(inIndex);
+		word = inValue ? (word | mask) : (word & ~mask);
+	}
+
+	constexpr void gSetAllBits(uint64* ioWords, int inNumBits)
+	{
+		int num_words = gGetNumBitWords(inNumBits);
+		for (int i = 0; i < num_words; ++i)
+			ioWords[i] = cMaxUInt64;
+
+		if (num_words != 0)
+			ioWords[num_words - 1] = gGetLastBitWordMask(inNumBits);
+	}
+
+	constexpr void gUnsetAllBits(uint64* ioWords, int inNumWords)
+	{
+		for (int i = 0; i < inNumWords; ++i)
+			ioWords[i] = 0;
+	}
+
+	constexpr int gCountSetBits(const uint64* inWords, int inNumWords)
+	{
+		int count = 0;
+		for (int i = 0; i < inNumWords; ++i)
+			count += gCountSetBits64(inWords[i]);
+		return count;
+	}
+
+	constexpr bool gAnyBitSet(const uint64* inWords, int inNumWords)
+	{
+		uint64 any = 0;
+		for (int i = 0; i < inNumWords; ++i)
+			any |= inWords[i];
+		return any != 0;
+	}
+
+	constexpr bool gAllBitsSet(const uint64* inWords, int inNumBits)
+	{
+		int num_words = gGetNumBitWords(inNumBits);
+		if (num_words == 0)
+			return true;
+
+		uint64 all = cMaxUInt64;
+		for (int i = 0; i < num_words - 1; ++i)
+			all &= inWords[i];
+
+		return all == cMaxUInt64 && inWords[num_words - 1] == gGetLastBitWordMask(inNumBits);
+	}
+
+	// Return the index of the first bit set (or unset if inInvert is true) at or after inFromIndex, or -1 if there isn't any.
+	template <bool taInvert = false>
+	constexpr int gFindFirstBit(const uint64* inWords, int inNumBits, int inFromIndex)
+	{
+		gAssert(inFromIndex >= 0);
+		if (inFromIndex >= inNumBits)
+			return -1;
+
+		int    word_index = gGetBitWordIndex(inFromIndex);
+		int    num_words  = gGetNumBitWords(inNumBits);
+		uint64 word       = (taInvert ? ~inWords[word_index] : inWords[word_index]) & ~(gGetBitMask(inFromIndex) - 1); // Ignore the bits before inFromIndex.
+
+		while (true)
+		{
+			if (word != 0)
+			{
+				int index = word_index * 64 + gCountTrailingZeros64(word);
+				return index < inNumBits ? index : -1; // Inverted unused bits are set in the last word.
+			}
+
+			if (++word_index == num_words)
+				return -1;
+
+			word = taInvert ? ~inWords[word_index] : inWords[word_index];
+		}
+	}
+
+	// Call inFunc(int inIndex) for each bit set, in increasing order.
+	template <typename taFunc>
+	constexpr void gForEachSetBit(const uint64* inWords, int inNumWords, taFunc&& inFunc)
+	{
+		for (int i = 0; i < inNumWords; ++i)
+		{
+			for (uint64 word = inWords[i]; word != 0; word &= word - 1) // Clear the lowest bit set at each iteration.
+				inFunc(i * 64 + gCountTrailingZeros64(word));
+		}
+	}
+
+	constexpr void gAndBits(uint64* ioWords, const uint64* inOtherWords, int inNumWords)		{ for (int i = 0; i < inNumWords; ++i) ioWords[i] &= inOtherWords[i]; }
+	constexpr void gOrBits(uint64* ioWords, const uint64* inOtherWords, int inNumWords)		{ for (int i = 0; i < inNumWords; ++i) ioWords[i] |= inOtherWords[i]; }
+	constexpr void gXorBits(uint64* ioWords, const uint64* inOtherWords, int inNumWords)		{ for (int i = 0; i < inNumWords; ++i) ioWords[i] ^= inOtherWords[i]; }
+	constexpr void gAndNotBits(uint64* ioWords, const uint64* inOtherWords, int inNumWords)	{ for (int i = 0; i < inNumWords; ++i) ioWords[i] &= ~inOtherWords[i]; }
+
+	constexpr void gNotBits(uint64* ioWords, int inNumBits)
+	{
+		int num_words = gGetNumBitWords(inNumBits);
+		for (int i = 0; i < num_words; ++i)
+			ioWords[i] = ~ioWords[i];
+
+		if (num_words != 0)
+			ioWords[num_words - 1] &= gGetLastBitWordMask(inNumBits);
+	}
+}
+
+
+// Fixed-size set of taSize bits, stored in 64-bit words.
+// See BitVector for a resizable version.
+template <int taSize>
+struct BitSet
+{
+	static_assert(taSize > 0);
+
+	static constexpr int cNumWords = Details::gGetNumBitWords(taSize);
+
+	constexpr static int Size() { return taSize; }
+
+	constexpr bool Test(int inIndex) const				{ gBoundsCheck(inIndex, taSize); return Details::gTestBit(mWords, inIndex); }
+	constexpr bool operator[](int inIndex) const		{ return Test(inIndex); }
+
+	constexpr void Set(int inIndex)						{ Assign(inIndex, true); }
+	constexpr void Unset(int inIndex)					{ Assign(inIndex, false); }
+	constexpr void Assign(int inIndex, bool inValue)	{ gBoundsCheck(inIndex, taSize); Details::gAssignBit(mWords, inIndex, inValue); }
+
+	constexpr void SetAll()								{ Details::gSetAllBits(mWords, taSize); }
+	constexpr void UnsetAll()							{ Details::gUnsetAllBits(mWords, cNumWords); }
+	constexpr void Flip()								{ Details::gNotBits(mWords, taSize); }
+
+	constexpr int  CountSetBits() const					{ return Details::gCountSetBits(mWords, cNumWords); }
+	constexpr bool AnySet() const						{ return Details::gAnyBitSet(mWords, cNumWords); }
+	constexpr bool NoneSet() const						{ return !AnySet(); }
+	constexpr bool AllSet() const						{ return Details::gAllBitsSet(mWords, taSize); }
+
+	// Return the index of the first bit set/unset at or after inFromIndex, or -1 if there isn't any.
+	constexpr int  FindFirstSet(int inFromIndex = 0) const		{ return Details::gFindFirstBit<false>(mWords, taSize, inFromIndex); }
+	constexpr int  FindFirstUnset(int inFromIndex = 0) const	{ return Details::gFindFirstBit<true>(mWords, taSize, inFromIndex); }
+
+	// Call inFunc(int inIndex) for each bit set, in increasing order.
+	template <typename taFunc>
+	constexpr void ForEachSetBit(taFunc&& inFunc) const	{ Details::gForEachSetBit(mWords, cNumWords, inFunc); }
+
+	constexpr BitSet& operator&=(const BitSet& inOther)	{ Details::gAndBits(mWords, inOther.mWords, cNumWords); return *this; }
+	constexpr BitSet& operator|=(const BitSet& inOther)	{ Details::gOrBits(mWords, inOther.mWords, cNumWords); return *this; }
+	constexpr BitSet& operator^=(const BitSet& inOther)	{ Details::gXorBits(mWords, inOther.mWords, cNumWords); return *this; }
+	constexpr BitSet& AndNot(const BitSet& inOther)		{ Details::gAndNotBits(mWords, inOther.mWords, cNumWords); return *this; }
+
+	constexpr friend BitSet operator&(BitSet inA, const BitSet& inB) { return inA &= inB; }
+	constexpr friend BitSet operator|(BitSet inA, const BitSet& inB) { return inA |= inB; }
+	constexpr friend BitSet operator^(BitSet inA, const BitSet& inB) { return inA ^= inB; }
+
+	constexpr bool operator==(const BitSet& inOther) const
+	{
+		for (int i = 0; i < cNumWords; ++i)
+			if (mWords[i] != inOther.mWords[i])
+				return false;
+		return true;
+	}
+
+	// Access to the underlying words. The unused bits of the last word must stay 0.
+	constexpr Span<const uint64> GetWords() const		{ return mWords; }
+	constexpr Span<uint64>       GetWords()				{ return mWords; }
+
+private:
+	uint64 mWords[cNumWords] = {};
+};
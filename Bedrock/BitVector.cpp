@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/BitVector.h>
+#include <Bedrock/Test.h>
+
+
+REGISTER_TEST("BitVector")
+{
+	BitVector bits;
+	TEST_TRUE(bits.Empty());
+	TEST_TRUE(bits.FindFirstSet() == -1);
+	TEST_TRUE(bits.FindFirstUnset() == -1);
+	TEST_TRUE(bits.AllSet());
+
+	for (int i = 0; i < 100; ++i)
+		bits.PushBack((i % 10) == 0);
+
+	TEST_TRUE(bits.Size() == 100);
+	TEST_TRUE(bits.GetWords().Size() == 2);
+	TEST_TRUE(bits.CountSetBits() == 10);
+	TEST_TRUE(bits[90]);
+	TEST_FALSE(bits[91]);
+	TEST_TRUE(bits.FindFirstSet(71) == 80);
+
+	int sum = 0;
+	bits.ForEachSetBit([&](int inIndex) { sum += inIndex; });
+	TEST_TRUE(sum == 450);
+
+	// Shrinking clears the removed bits.
+	bits.Resize(85);
+	TEST_TRUE(bits.CountSetBits() == 9);
+	bits.Resize(100);
+	TEST_TRUE(bits.CountSetBits() == 9);
+
+	// Growing with true only sets the new bits.
+	bits.Resize(200, true);
+	TEST_TRUE(bits.CountSetBits() == 9 + 100);
+	TEST_FALSE(bits[99]);
+	TEST_TRUE(bits[100]);
+	TEST_TRUE(bits[199]);
+	TEST_TRUE(bits.FindFirstUnset(100) == -1);
+
+	bits.PopBack();
+	TEST_TRUE(bits.Size() == 199);
+	TEST_TRUE(bits.CountSetBits() == 9 + 99);
+
+	bits.SetAll();
+	TEST_TRUE(bits.AllSet());
+	TEST_TRUE(bits.CountSetBits() == 199);
+	bits.Flip();
+	TEST_TRUE(bits.NoneSet());
+
+	bits.Clear();
+	TEST_TRUE(bits.Empty());
+	TEST_TRUE(bits.CountSetBits() == 0);
+};
+
+
+REGISTER_TEST("BitVector Operations")
+{
+	constexpr int cSize = 1000;
+	BitVector     a(cSize), b(cSize, true);
+	TEST_TRUE(b.CountSetBits() == cSize);
+
+	for (int i = 0; i < cSize; i += 5)
+		a.Set(i);
+	for (int i = 0; i < cSize; i += 7)
+		b.Unset(i);
+
+	BitVector c = a;
+	TEST_TRUE(c == a);
+	c &= b;
+	TEST_TRUE(c.CountSetBits() == 200 - 29);	// Multiples of 5 that aren't multiples of 35.
+	c = a;
+	c |= b;
+	TEST_TRUE(c.CountSetBits() == cSize - 143 + 29);
+	c = a;
+	c.AndNot(b);
+	TEST_TRUE(c.CountSetBits() == 29);
+	c ^= c;
+	TEST_TRUE(c.NoneSet());
+
+	TempBitVector temp(cSize);
+	temp.Set(5);
+	temp |= a;
+	TEST_TRUE(temp.CountSetBits() == 200);
+	TEST_TRUE(temp == a);
+
+	BitVector moved = gMove(c);
+	TEST_TRUE(moved.Size() == cSize);
+	TEST_TRUE(c.Empty());
+};
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/BitSet.h>
+#include <Bedrock/Vector.h>
+
+
+// Resizable array of bits, stored in 64-bit words (8x smaller than a Vector<bool>).
+// The bulk operations (&=, |=, ^=, AndNot, CountSetBits...) work on whole words at a time.
+// See BitSet for a fixed-size version.
+template <typename taAllocator = DefaultAllocator<uint64>>
+struct BitVector
+{
+	using Allocator = taAllocator;
+
+	// Default
+	BitVector() = default;
+	~BitVector() = default;
+
+	// Default with Allocator
+	explicit BitVector(Allocator&& inAllocator) : mWords(gMove(inAllocator)) {}
+
+	// Construct with inSize bits, all set to inValue.
+	explicit BitVector(int inSize, bool inValue = false) { Resize(inSize, inValue); }
+
+	// Copy/Move
+	BitVector(const BitVector&) = default;
+	BitVector(BitVector&& ioOther) : mWords(gMove(ioOther.mWords)), mSize(ioOther.mSize) { ioOther.mSize = 0; }
+	BitVector& operator=(const BitVector&) = default;
+	BitVector& operator=(BitVector&& ioOther);
+
+	int  Size() const		{ return mSize; }
+	bool Empty() const		{ return mSize == 0; }
+	int  Capacity() const	{ return mWords.Capacity() * 64; }
+
+	const Allocator& GetAllocator() const { return mWords.GetAllocator(); }
+	Allocator&       GetAllocator() { return mWords.GetAllocator(); }
+
+	void Clear()					{ mWords.Clear(); mSize = 0; }
+	void ClearAndFreeMemory()		{ mWords.ClearAndFreeMemory(); mSize = 0; }
+	void Reserve(int inCapacity)	{ mWords.Reserve(Details::gGetNumBitWords(inCapacity)); }
+	void ShrinkToFit()				{ mWords.ShrinkToFit(); }
+
+	// Change the number of bits. New bits are set to inValue.
+	void Resize(int inNewSize, bool inValue = false);
+
+	void PushBack(bool inValue);
+	void PopBack()					{ gAssert(mSize > 0); Resize(mSize - 1); }
+
+	bool Test(int inIndex) const				{ gBoundsCheck(inIndex, mSize); return Details::gTestBit(mWords.Data(), inIndex); }
+	bool operator[](int inIndex) const			{ return Test(inIndex); }
+
+	void Set(int inIndex)						{ Assign(inIndex, true); }
+	void Unset(int inIndex)						{ Assign(inIndex, false); }
+	void Assign(int inIndex, bool inValue)		{ gBoundsCheck(inIndex, mSize); Details::gAssignBit(mWords.Data(), inIndex, inValue); }
+
+	void SetAll()								{ Details::gSetAllBits(mWords.Data(), mSize); }
+	void UnsetAll()								{ Details::gUnsetAllBits(mWords.Data(), mWords.Size()); }
+	void Flip()									{ Details::gNotBits(mWords.Data(), mSize); }
+
+	int  CountSetBits() const					{ return Details::gCountSetBits(mWords.Data(), mWords.Size()); }
+	bool AnySet() const							{ return Details::gAnyBitSet(mWords.Data(), mWords.Size()); }
+	bool NoneSet() const						{ return !AnySet(); }
+	bool AllSet() const							{ return Details::gAllBitsSet(mWords.Data(), mSize); }
+
+	// Return the index of the first bit set/unset at or after inFromIndex, or -1 if there isn't any.
+	int  FindFirstSet(int inFromIndex = 0) const	{ return Details::gFindFirstBit<false>(mWords.Data(), mSize, inFromIndex); }
+	int  FindFirstUnset(int inFromIndex = 0) const	{ return Details::gFindFirstBit<true>(mWords.Data(), mSize, inFromIndex); }
+
+	// Call inFunc(int inIndex) for each bit set, in increasing order.
+	template <typename taFunc>
+	void ForEachSetBit(taFunc&& inFunc) const	{ Details::gForEachSetBit(mWords.Data(), mWords.Size(), inFunc); }
+
+	// Bulk operations. Both BitVectors must have the same size.
+	template <typename taOtherAllocator> BitVector& operator&=(const BitVector<taOtherAllocator>& inOther)	{ gAssert(mSize == inOther.Size()); Details::gAndBits(mWords.Data(), inOther.GetWords().Data(), mWords.Size()); return *this; }
+	template <typename taOtherAllocator> BitVector& operator|=(const BitVector<taOtherAllocator>& inOther)	{ gAssert(mSize == inOther.Size()); Details::gOrBits(mWords.Data(), inOther.GetWords().Data(), mWords.Size()); return *this; }
+	template <typename taOtherAllocator> BitVector& operator^=(const BitVector<taOtherAllocator>& inOther)	{ gAssert(mSize == inOther.Size()); Details::gXorBits(mWords.Data(), inOther.GetWords().Data(), mWords.Size()); return *this; }
+	template <typename taOtherAllocator> BitVector& AndNot(const BitVector<taOtherAllocator>& inOther)		{ gAssert(mSize == inOther.Size()); Details::gAndNotBits(mWords.Data(), inOther.GetWords().Data(), mWords.Size()); return *this; }
+
+	template <typename taOtherAllocator>
+	bool operator==(const BitVector<taOtherAllocator>& inOther) const
+	{
+		return mSize == inOther.Size() && (mWords.Empty() || gMemCmp(mWords.Data(), inOther.GetWords().Data(), mWords.Size() * (int)sizeof(uint64)) == 0);
+	}
+
+	// Access to the underlying words. The unused bits of the last word must stay 0.
+	Span<const uint64> GetWords() const			{ return mWords; }
+	Span<uint64>       GetWords()				{ return mWords; }
+
+private:
+	Vector<uint64, Allocator> mWords;
+	int                       mSize = 0;	// Number of bits.
+};
+
+
+// Alias for a BitVector using the TempAllocator.
+using TempBitVector = BitVector<TempAllocator<uint64>>;
+
+// Alias for a BitVector using the ArenaAllocator.
+// A MemArena needs to be passed to the BitVector before it can be used.
+using ArenaBitVector = BitVector<ArenaAllocator<uint64>>;
+
+
+// BitVectors can be relocated with a memcpy if their allocator can.
+template <typename taAllocator>
+inline constexpr bool cIsTriviallyRelocatable<BitVector<taAllocator>> = cIsTriviallyRelocatable<taAllocator>;
+
+
+template <typename taAllocator>
+BitVector<taAllocator>& BitVector<taAllocator>::operator=(BitVector&& ioOther)
+{
+	mWords        = gMove(ioOther.mWords);
+	mSize         = ioOther.mSize;
+	ioOther.mSize = 0;
+	return *this;
+}
+
+
+template <typename taAllocator>
+void BitVector<taAllocator>::Resize(int inNewSize, bool inValue)
+{
+	gAssert(inNewSize >= 0);
+
+	int old_size = mSize;
+	mWords.Resize(Details::gGetNumBitWords(inNewSize)); // New words are zeroed.
+	mSize = inNewSize;
+
+	if (inNewSize > old_size)
+	{
+		if (inValue)
+		{
+			// Set the new bits of the previous last word, then the new words.
+			int first_new_word = Details::gGetNumBitWords(old_size);
+			if ((old_size % 64) != 0)
+				mWords[first_new_word - 1] |= ~Details::gGetLastBitWordMask(old_size);
+
+			for (int i = first_new_word; i < mWords.Size(); ++i)
+				mWords[i] = cMaxUInt64;
+
+			mWords.Back() &= Details::gGetLastBitWordMask(inNewSize);
+		}
+	}
+	else if (!mWords.Empty())
+	{
+		// Clear the bits that aren't used anymore.
+		mWords.Back() &= Details::gGetLastBitWordMask(inNewSize);
+	}
+}
+
+
+template <typename taAllocator>
+void BitVector<taAllocator>::PushBack(bool inValue)
+{
+	if ((mSize % 64) == 0)
+		mWords.PushBack(0);
+
+	mSize++;
+	Details::gAssignBit(mWords.Data(), mSize - 1, inValue);
+}
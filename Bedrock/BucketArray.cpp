@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/BucketArray.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/String.h>
+#include <Bedrock/StringFormat.h>
+#include <Bedrock/Thread.h>
+
+
+REGISTER_TEST("BucketArray")
+{
+	BucketArray<int, 16> test;
+	TEST_TRUE(test.Empty());
+
+	for (int i = 0; i < 100; ++i)
+		test.PushBack(i);
+
+	TEST_TRUE(test.Size() == 100);
+	TEST_TRUE(test.GetNumBuckets() == 7);
+	TEST_TRUE(test.Capacity() == 7 * 16);
+	TEST_TRUE(test[42] == 42);
+
+	// Elements never move when growing.
+	int* first = &test[0];
+	for (int i = 100; i < 1000; ++i)
+		test.PushBack(i);
+	TEST_TRUE(&test[0] == first);
+
+	bool all_equal = true;
+	for (int i = 0; i < 1000; ++i)
+		all_equal &= (test[i] == i);
+	TEST_TRUE(all_equal);
+
+	// Holes are skipped and reused.
+	test.Remove(10);
+	test.Remove(500);
+	TEST_TRUE(test.Size() == 998);
+	TEST_TRUE(test.GetNumSlots() == 1000);
+	TEST_TRUE(!test.IsValidIndex(10));
+	TEST_TRUE(test.IsValidIndex(11));
+
+	int64 sum = 0;
+	test.ForEach([&sum](int inValue) { sum += inValue; });
+	TEST_TRUE(sum == (999 * 1000 / 2) - 10 - 500);
+
+	TEST_TRUE(test.Add(-1) == 500);
+	TEST_TRUE(test.Add(-2) == 10);
+	TEST_TRUE(test.Add(-3) == 1000);
+	TEST_TRUE(test[500] == -1);
+	TEST_TRUE(test.Size() == 1001);
+
+	test.PopBack();
+	TEST_TRUE(test.GetNumSlots() == 1000);
+
+	BucketArray<int, 16> moved = gMove(test);
+	TEST_TRUE(moved.Size() == 1000);
+	TEST_TRUE(&moved[0] == first);
+	TEST_TRUE(test.Empty());
+
+	moved.Clear();
+	TEST_TRUE(moved.Empty());
+	TEST_TRUE(moved.GetNumBuckets() == 63);
+	moved.PushBack(1);
+	TEST_TRUE(&moved[0] == first);
+};
+
+
+REGISTER_TEST("BucketArray NonTrivial")
+{
+	BucketArray<String, 4, TempAllocator<String>> test;
+
+	for (int i = 0; i < 10; ++i)
+		test.EmplaceBack(gTempFormat("%d", i));
+
+	test.Remove(3);
+	TEST_TRUE(test.Add("three") == 3);
+	TEST_TRUE(test[3] == "three");
+
+	test.Remove(9);
+	test.Remove(0);
+
+	int total_size = 0;
+	const BucketArray<String, 4, TempAllocator<String>>& const_test = test;
+	const_test.ForEach([&total_size](const String& inString) { total_size += inString.Size(); });
+	TEST_TRUE(total_size == 5 + 7);
+};
+
+
+REGISTER_TEST("BucketArray Parallel")
+{
+	BucketArray<int, 1024> test;
+	for (int i = 0; i < 100000; ++i)
+		test.PushBack(1);
+
+	// Process the buckets from several threads.
+	AtomicInt64 sum = 0;
+	{
+		Thread threads[4];
+		for (int t = 0; t < 4; ++t)
+		{
+			threads[t].Create({ .mName = "BucketArrayTest" }, [&test, &sum, t](Thread&)
+			{
+				int64 thread_sum = 0;
+				for (int b = t; b < test.GetNumBuckets(); b += 4)
+				{
+					test.ForEachInBucket(b, [&thread_sum](int& ioValue)
+					{
+						ioValue *= 2;
+						thread_sum += ioValue;
+					});
+				}
+
+				sum.Add(thread_sum);
+			});
+		}
+	}
+
+	TEST_TRUE(sum.Load() == 200000);
+};
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/PlacementNew.h>
+
+
+// Array made of fixed-size buckets of taBucketSize elements, allocated from taAllocator as needed.
+// Elements never move: growing only allocates a new bucket, and only the table of bucket pointers is reallocated.
+// Indexing is O(1) (a shift and a mask).
+// Elements can be removed from anywhere with Remove, the hole is then reused by the next Add (free list).
+// Buckets can be processed in parallel with ForEachInBucket (eg. one bucket per job).
+// Note: Only the buckets are allocated from taAllocator. The bookkeeping (bucket pointers, alive bits and free list) is small
+// and uses the heap: it is reallocated as the array grows, which would leave out of order frees in linear allocators
+// (eg. ArenaAllocator), and allocators that own their memory (eg. VMemAllocator) can't be shared between several arrays.
+template <typename taType, int taBucketSize = 64, typename taAllocator = DefaultAllocator<taType>>
+struct BucketArray : NoCopy, private taAllocator
+{
+	static_assert(gIsPow2(taBucketSize));
+
+	using ValueType = taType;
+	using Allocator = taAllocator;
+
+	static constexpr int cBucketSize = taBucketSize;
+
+	// Default
+	BucketArray() = default;
+	~BucketArray() { ClearAndFreeMemory(); }
+
+	// Default with Allocator
+	explicit BucketArray(Allocator&& inAllocator) : Allocator(gMove(inAllocator)) {}
+
+	// Move
+	BucketArray(BucketArray&& ioOther) { MoveFrom(gMove(ioOther)); }
+	BucketArray& operator=(BucketArray&& ioOther) { MoveFrom(gMove(ioOther)); return *this; }
+
+	int  Size() const			{ return mSize; }		// Number of elements (not including holes).
+	bool Empty() const			{ return mSize == 0; }
+	int  GetNumSlots() const	{ return mNumSlots; }	// Number of elements and holes. Valid indices are below that.
+	int  GetNumBuckets() const	{ return mBuckets.Size(); }
+	int  Capacity() const		{ return mBuckets.Size() * taBucketSize; }
+
+	const Allocator& GetAllocator() const { return *this; }
+	Allocator&       GetAllocator() { return *this; }
+
+	// Return true if there is an element at inIndex (ie. it's not a hole).
+	bool IsValidIndex(int inIndex) const
+	{
+		return inIndex >= 0 && inIndex < mNumSlots && (mAliveMasks[inIndex / 64] & (1ull << (inIndex % 64))) != 0;
+	}
+
+	taType&       operator[](int inIndex)		{ gAssert(IsValidIndex(inIndex)); return GetSlot(inIndex); }
+	const taType& operator[](int inIndex) const	{ gAssert(IsValidIndex(inIndex)); return const_cast<BucketArray*>(this)->GetSlot(inIndex); }
+
+	void Clear();				// Destroy all the elements but keep the buckets.
+	void ClearAndFreeMemory();	// Destroy all the elements and free the buckets.
+	void Reserve(int inCapacity);
+
+	// Add an element at the end.
+	void PushBack(const taType& inValue)	{ EmplaceBack(inValue); }
+	void PushBack(taType&& inValue)			{ EmplaceBack(gMove(inValue)); }
+	template <typename... taArgs>
+	taType& EmplaceBack(taArgs&&... inArgs);
+
+	// Add an element in a hole left by Remove if there is one, at the end otherwise. Return its index.
+	template <typename... taArgs>
+	int Add(taArgs&&... inArgs);
+
+	// Remove the element at inIndex. Other elements don't move, the index will be reused by the next Add.
+	void Remove(int inIndex);
+
+	// Remove the element in the last slot (must not be a hole).
+	void PopBack();
+
+	// Call inFunc(taType&) for each element of a bucket, skipping holes.
+	// Different buckets can be processed by different threads at the same time.
+	template <typename taFunc> void ForEachInBucket(int inBucket, taFunc&& inFunc);
+	template <typename taFunc> void ForEachInBucket(int inBucket, taFunc&& inFunc) const;
+
+	// Call inFunc(taType&) for each element, skipping holes.
+	template <typename taFunc> void ForEach(taFunc&& inFunc)			{ for (int i = 0; i < mBuckets.Size(); ++i) ForEachInBucket(i, inFunc); }
+	template <typename taFunc> void ForEach(taFunc&& inFunc) const	{ for (int i = 0; i < mBuckets.Size(); ++i) ForEachInBucket(i, inFunc); }
+
+private:
+	// Note: Unsigned so that the divide and modulo by a power of 2 are just a shift and a mask.
+	taType& GetSlot(int inIndex) { return mBuckets[(uint32)inIndex / taBucketSize][(uint32)inIndex % taBucketSize]; }
+
+	void SetAlive(int inIndex, bool inAlive);
+	void MoveFrom(BucketArray&& ioOther);
+
+	Vector<taType*> mBuckets;					// Pointers to the buckets. Only this table is reallocated when growing.
+	Vector<uint64>  mAliveMasks;				// One bit per slot, set if the slot contains an element.
+	Vector<int>     mFreeIndices;				// Holes left by Remove, reused in LIFO order.
+	int             mNumSlots = 0;
+	int             mSize     = 0;
+};
+
+
+// BucketArrays can be relocated with a memcpy if their allocator can (the elements themselves are not moved).
+template <typename taType, int taBucketSize, typename taAllocator>
+inline constexpr bool cIsTriviallyRelocatable<BucketArray<taType, taBucketSize, taAllocator>> = cIsTriviallyRelocatable<taAllocator>;
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::Clear()
+{
+	ForEach([](taType& ioElement) { ioElement.~taType(); });
+
+	for (uint64& mask : mAliveMasks)
+		mask = 0;
+
+	mFreeIndices.Clear();
+	mNumSlots = 0;
+	mSize     = 0;
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::ClearAndFreeMemory()
+{
+	Clear();
+
+	for (taType* bucket : mBuckets)
+		Allocator::Free(bucket, taBucketSize);
+
+	mBuckets.ClearAndFreeMemory();
+	mAliveMasks.ClearAndFreeMemory();
+	mFreeIndices.ClearAndFreeMemory();
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::Reserve(int inCapacity)
+{
+	int num_buckets = (int)gAlignUp(inCapacity, taBucketSize) / taBucketSize;
+	if (mBuckets.Size() >= num_buckets)
+		return;
+
+	mBuckets.Reserve(num_buckets);
+	while (mBuckets.Size() < num_buckets)
+		mBuckets.PushBack(Allocator::Allocate(taBucketSize));
+
+	mAliveMasks.Resize((int)gAlignUp(num_buckets * taBucketSize, 64) / 64);
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+template <typename ... taArgs>
+taType& BucketArray<taType, taBucketSize, taAllocator>::EmplaceBack(taArgs&&... inArgs)
+{
+	// Allocate a new bucket if necessary. Existing elements don't move.
+	if (mNumSlots == Capacity()) [[unlikely]]
+		Reserve(mNumSlots + 1);
+
+	int     index = mNumSlots;
+	taType& slot  = GetSlot(index);
+
+	gPlacementNew(slot, gForward<taArgs>(inArgs)...);
+	SetAlive(index, true);
+	mNumSlots++;
+	mSize++;
+
+	return slot;
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+template <typename ... taArgs>
+int BucketArray<taType, taBucketSize, taAllocator>::Add(taArgs&&... inArgs)
+{
+	if (mFreeIndices.Empty())
+	{
+		EmplaceBack(gForward<taArgs>(inArgs)...);
+		return mNumSlots - 1;
+	}
+
+	// Reuse a hole.
+	int index = mFreeIndices.Back();
+	mFreeIndices.PopBack();
+
+	gPlacementNew(GetSlot(index), gForward<taArgs>(inArgs)...);
+	SetAlive(index, true);
+	mSize++;
+
+	return index;
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::Remove(int inIndex)
+{
+	gAssert(IsValidIndex(inIndex));
+
+	GetSlot(inIndex).~taType();
+	SetAlive(inIndex, false);
+	mFreeIndices.PushBack(inIndex);
+	mSize--;
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::PopBack()
+{
+	gAssert(IsValidIndex(mNumSlots - 1));
+
+	mNumSlots--;
+	mSize--;
+	GetSlot(mNumSlots).~taType();
+	SetAlive(mNumSlots, false);
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+template <typename taFunc>
+void BucketArray<taType, taBucketSize, taAllocator>::ForEachInBucket(int inBucket, taFunc&& inFunc)
+{
+	taType* bucket    = mBuckets[inBucket];
+	int     begin     = inBucket * taBucketSize;
+	int     num_slots = gClamp(mNumSlots - begin, 0, taBucketSize);
+
+	if (mFreeIndices.Empty())
+	{
+		// No holes, no need to check the masks.
+		for (int i = 0; i < num_slots; ++i)
+			inFunc(bucket[i]);
+	}
+	else
+	{
+		for (int i = 0; i < num_slots; ++i)
+		{
+			int index = begin + i;
+			if (mAliveMasks[index / 64] & (1ull << (index % 64)))
+				inFunc(bucket[i]);
+		}
+	}
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+template <typename taFunc>
+void BucketArray<taType, taBucketSize, taAllocator>::ForEachInBucket(int inBucket, taFunc&& inFunc) const
+{
+	const_cast<BucketArray*>(this)->ForEachInBucket(inBucket, [&inFunc](const taType& inElement) { inFunc(inElement); });
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::SetAlive(int inIndex, bool inAlive)
+{
+	uint64& mask = mAliveMasks[inIndex / 64];
+	uint64  bit  = 1ull << (inIndex % 64);
+
+	if (inAlive)
+		mask |= bit;
+	else
+		mask &= ~bit;
+}
+
+
+template <typename taType, int taBucketSize, typename taAllocator>
+void BucketArray<taType, taBucketSize, taAllocator>::MoveFrom(BucketArray&& ioOther)
+{
+	// Moving from self is not allowed.
+	gAssert(this != &ioOther);
+
+	// Clear the current data.
+	ClearAndFreeMemory();
+
+	// Move the allocator.
+	GetAllocator() = gMove(ioOther.GetAllocator());
+	ioOther.GetAllocator() = Allocator();
+
+	// Move the data.
+	mBuckets     = gMove(ioOther.mBuckets);
+	mAliveMasks  = gMove(ioOther.mAliveMasks);
+	mFreeIndices = gMove(ioOther.mFreeIndices);
+	mNumSlots    = ioOther.mNumSlots;
+	mSize        = ioOther.mSize;
+
+	ioOther.mNumSlots = 0;
+	ioOther.mSize     = 0;
+}
@@ -3,11 +3,21 @@
 #include <Bedrock/Test.h>
 #include <Bedrock/Thread.h>
 
+#if defined(_WIN32)
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#else
+#error Unknown platform
+#endif
+
 
+#if defined(_WIN32)
 
 ConditionVariable::ConditionVariable()
 {
@@ -63,6 +73,87 @@ ConditionVariable::WaitResult ConditionVariable::Wait(MutexLockGuard& ioLock, Na
 }
 
 
+#elif defined(__linux__)
+
+static_assert(sizeof(OSCondVar) >= sizeof(pthread_cond_t) && alignof(OSCondVar) >= alignof(pthread_cond_t));
+
+ConditionVariable::ConditionVariable()
+{
+	// Use the monotonic clock for timeouts, the default realtime clock can jump.
+	pthread_condattr_t attributes;
+	pthread_condattr_init(&attributes);
+	pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+
+	int result = pthread_cond_init((pthread_cond_t*)&mOSCondVar, &attributes);
+	gAssert(result == 0);
+
+	pthread_condattr_destroy(&attributes);
+}
+
+
+ConditionVariable::~ConditionVariable()
+{
+	int result = pthread_cond_destroy((pthread_cond_t*)&mOSCondVar);
+	gAssert(result == 0);
+}
+
+
+void ConditionVariable::NotifyOne()
+{
+	pthread_cond_signal((pthread_cond_t*)&mOSCondVar);
+}
+
+
+void ConditionVariable::NotifyAll()
+{
+	pthread_cond_broadcast((pthread_cond_t*)&mOSCondVar);
+}
+
+
+ConditionVariable::WaitResult ConditionVariable::Wait(MutexLockGuard& ioLock, NanoSeconds inTimeout)
+{
+#ifdef ASSERTS_ENABLED
+	// Update the locking thread ID stored inside the mutex, waiting is going to unlock it.
+	Mutex* mutex = const_cast<Mutex*>(ioLock.GetMutex());
+	uint32 locking_thread_id = mutex->mLockingThreadID;
+	mutex->mLockingThreadID = Mutex::cInvalidThreadID;
+#endif
+
+	pthread_cond_t*  cond_var = (pthread_cond_t*)&mOSCondVar;
+	pthread_mutex_t* os_mutex = (pthread_mutex_t*)&ioLock.GetMutex()->mOSMutex;
+	int              ret      = 0;
+
+	if (inTimeout == cInfiniteTimeout)
+	{
+		ret = pthread_cond_wait(cond_var, os_mutex);
+	}
+	else
+	{
+		timespec end_time = {};
+		clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+		int64 end_ns      = (int64)end_time.tv_nsec + (int64)inTimeout;
+		end_time.tv_sec  += end_ns / 1'000'000'000;
+		end_time.tv_nsec  = end_ns % 1'000'000'000;
+
+		ret = pthread_cond_timedwait(cond_var, os_mutex, &end_time);
+	}
+
+#ifdef ASSERTS_ENABLED
+	// Put the locking thread ID back.
+	gAssert(mutex->mLockingThreadID == Mutex::cInvalidThreadID);
+	mutex->mLockingThreadID = locking_thread_id;
+#endif
+
+	if (ret == 0)
+		return WaitResult::Success;
+
+	gAssert(ret == ETIMEDOUT);
+	return WaitResult::Timeout;
+}
+
+#endif
+
 REGISTER_TEST("ConditionVariable")
 {
 	ConditionVariable cond;
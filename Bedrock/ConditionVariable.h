@@ -6,7 +6,11 @@
 #include <Bedrock/Time.h>
 
 
-using OSCondVar = void*;
+#ifdef _WIN32
+using OSCondVar = void*; // CONDITION_VARIABLE
+#else
+struct alignas(8) OSCondVar { uint8 mStorage[48]; }; // pthread_cond_t
+#endif
 
 
 
@@ -30,5 +34,5 @@ struct ConditionVariable : NoCopy
 	WaitResult Wait(MutexLockGuard& ioLock, NanoSeconds inTimeout = cInfiniteTimeout);
 
 private:
-	OSCondVar mOSCondVar = nullptr;
+	OSCondVar mOSCondVar = {};
 };
@@ -8,3 +8,14 @@ static_assert(gCountLeadingZeros64(1) == 63);
 static_assert(gCountLeadingZeros64(cMaxUInt64) == 0);
 static_assert(gCountLeadingZeros64(cMaxUInt32) == 32);
 
+
+// Tests for the constexpr code in gCountTrailingZeros64.
+static_assert(gCountTrailingZeros64(0) == 64);
+static_assert(gCountTrailingZeros64(1) == 0);
+static_assert(gCountTrailingZeros64(cMaxUInt64) == 0);
+static_assert(gCountTrailingZeros64((uint64)1 << 63) == 63);
+
+// Tests for the constexpr code in gCountSetBits64.
+static_assert(gCountSetBits64(0) == 0);
+static_assert(gCountSetBits64(0b1011) == 3);
+static_assert(gCountSetBits64(cMaxUInt64) == 64);
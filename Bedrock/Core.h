@@ -10,13 +10,22 @@ using int8   = signed char;
 using uint8  = unsigned char;
 using int16  = signed short;
 using uint16 = unsigned short;
+#ifdef _WIN32
 using int32  = signed long;
 using uint32 = unsigned long;
+#else
+using int32  = signed int;	 // long is 64 bits outside of Windows.
+using uint32 = unsigned int;
+#endif
 using int64  = signed long long;
 using uint64 = unsigned long long;
 
 using NullPtrType = decltype(nullptr);
 
+#ifndef _WIN32
+using size_t = decltype(sizeof(0)); // MSVC has it built-in.
+#endif
+
 constexpr int8   cMaxInt8   = 0x7F;
 constexpr uint8  cMaxUInt8  = 0xFF;
 constexpr int16  cMaxInt16  = 0x7FFF;
@@ -105,6 +114,9 @@ consteval int64 operator ""_KiB(unsigned long long inValue)	{ return (int64)inVa
 consteval int64 operator ""_MiB(unsigned long long inValue)	{ return (int64)inValue * 1024 * 1024; }
 consteval int64 operator ""_GiB(unsigned long long inValue)	{ return (int64)inValue * 1024 * 1024 * 1024; }
 
+// Size of a cache line. Data written by different threads should be at least that far apart to avoid false sharing.
+constexpr int cCacheLineSize = 64;
+
 
 // Basic functions.
 template <typename T> constexpr T gMin(T inA, T inB)				{ return inA < inB ? inA : inB; }
@@ -170,6 +182,67 @@ constexpr int gCountLeadingZeros64(uint64 inValue)
 }
 
 
+// Return the number of zero bits below the lowest bit set to 1, or 64 if inValue is 0.
+constexpr int gCountTrailingZeros64(uint64 inValue)
+{
+	if (gIsContantEvaluated())
+	{
+		int trailing_zeroes = 0;
+		for (; trailing_zeroes < 64; trailing_zeroes++)
+		{
+			if (inValue & ((uint64)1 << trailing_zeroes))
+				break; // Found a one.
+		}
+		return trailing_zeroes;
+	}
+	
+#ifdef __clang__
+
+	// Note: __builtin_ctz is undefined behavior for 0.
+	if (inValue == 0) [[unlikely]]
+		return 64;
+
+	return __builtin_ctzll(inValue);
+
+#elif _MSC_VER
+
+	unsigned char _BitScanForward64(unsigned long* _Index, unsigned __int64 _Mask);
+	uint32 index;
+	if (_BitScanForward64(&index, inValue) == 0) [[unlikely]]
+		return 64;
+	return index;
+
+#else
+#error Unknown compiler
+#endif
+}
+
+
+// Return the number of bits set to 1.
+constexpr int gCountSetBits64(uint64 inValue)
+{
+	if (gIsContantEvaluated())
+	{
+		int count = 0;
+		for (; inValue != 0; inValue &= inValue - 1)
+			count++;
+		return count;
+	}
+
+#ifdef __clang__
+
+	return __builtin_popcountll(inValue);
+
+#elif _MSC_VER
+
+	unsigned __int64 __popcnt64(unsigned __int64 _Value);
+	return (int)__popcnt64(inValue);
+
+#else
+#error Unknown compiler
+#endif
+}
+
 constexpr int64 gGetNextPow2(int64 inValue)
 {
 	if (inValue <= 1) [[unlikely]]
@@ -178,13 +251,37 @@ constexpr int64 gGetNextPow2(int64 inValue)
 }
 
 
+// Hint the CPU to start loading the cache line containing inPtr. Invalid addresses are ignored.
+force_inline void gPrefetch(const void* inPtr)
+{
+#ifdef __clang__
+
+	__builtin_prefetch(inPtr);
+
+#elif _MSC_VER
+
+	void _mm_prefetch(char const* _A, int _Sel);
+	_mm_prefetch((const char*)inPtr, 1 /* _MM_HINT_T0 */);
+
+#else
+#error Unknown compiler
+#endif
+}
+
+
 // Some useful C std function replacements to avoid an include or because the real ones aren't constexpr.
 force_inline constexpr int gStrLen(const char* inString)								{ return (int)__builtin_strlen(inString); }
 force_inline constexpr int gMemCmp(const void* inPtrA, const void* inPtrB, int inSize)	{ return __builtin_memcmp(inPtrA, inPtrB, inSize); }
+#ifdef _WIN32
 extern "C" void* __cdecl   memcpy(void* inDest, void const* inSource, size_t inSize);
 extern "C" void* __cdecl   memmove(void* inDest, void const* inSource, size_t inSize);
-force_inline void		   gMemCopy(void* inDest, const void* inSource, int inSize)		{ memcpy(inDest, inSource, inSize); }
-force_inline void		   gMemMove(void* inDest, const void* inSource, int inSize)		{ memmove(inDest, inSource, inSize); }
+force_inline void		   gMemCopy(void* inDest, const void* inSource, int64 inSize)	{ memcpy(inDest, inSource, inSize); }
+force_inline void		   gMemMove(void* inDest, const void* inSource, int64 inSize)	{ memmove(inDest, inSource, inSize); }
+#else
+// Note: glibc declares memcpy/memmove noexcept, use the builtins rather than a conflicting declaration.
+force_inline void		   gMemCopy(void* inDest, const void* inSource, int64 inSize)	{ __builtin_memcpy(inDest, inSource, inSize); }
+force_inline void		   gMemMove(void* inDest, const void* inSource, int64 inSize)	{ __builtin_memmove(inDest, inSource, inSize); }
+#endif
 
 
 // We want some no-op functions (like gMove or gToUnderlying) to be always inlined, but force_inline doesn't work in debug with MSVC by default.
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: MPL-2.0
 #include <Bedrock/Debug.h>
 #include <Bedrock/Core.h>
+#include <Bedrock/StringView.h>
+
+#if defined(_WIN32)
 
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
@@ -32,4 +35,57 @@ void gSetCurrentThreadName(const char* inName)
 	wchar_name[written_wchars] = 0;
 
 	SetThreadDescription(GetCurrentThread(), wchar_name);
-}
\ No newline at end of file
+}
+
+#elif defined(__linux__)
+
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+
+// Check if a debugger is attached.
+bool gIsDebuggerAttached()
+{
+	// The TracerPid line of /proc/self/status is non-zero when a debugger is attached.
+	int fd = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	char buffer[4096];
+	int  size = (int)read(fd, buffer, sizeof(buffer));
+	close(fd);
+
+	if (size <= 0)
+		return false;
+
+	StringView status(buffer, size);
+
+	int position = status.Find("TracerPid:");
+	if (position == -1)
+		return false;
+
+	StringView tracer_pid     = status.SubStr(position + gStrLen("TracerPid:"));
+	int        value_position = tracer_pid.FindFirstNotOf(" \t");
+
+	return value_position != -1 && tracer_pid[value_position] != '0';
+}
+
+
+// Set the name of the current thread.
+void gSetCurrentThreadName(const char* inName)
+{
+	gAssert(inName[0] != 0); // Don't set an empty name.
+
+	// Linux thread names are limited to 15 chars (plus the null terminator), truncate the rest.
+	char short_name[16];
+	int  length = gMin(gStrLen(inName), (int)gElemCount(short_name) - 1);
+	gMemCopy(short_name, inName, length);
+	short_name[length] = 0;
+
+	pthread_setname_np(pthread_self(), short_name);
+}
+
+#else
+#error Unknown platform
+#endif
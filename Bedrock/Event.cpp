@@ -2,12 +2,24 @@
 #include <Bedrock/Event.h>
 #include <Bedrock/Test.h>
 
+#if defined(_WIN32)
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <Bedrock/Ticks.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#else
+#error Unknown platform
+#endif
 
 
+#if defined(_WIN32)
+
 Event::Event(ResetMode inResetMode, bool inInitialState)
 {
 	mOSEvent = CreateEventA(nullptr, inResetMode == ManualReset, inInitialState, nullptr);
@@ -58,6 +70,99 @@ void Event::Wait() const
 }
 
 
+#elif defined(__linux__)
+
+// Wait until the eventfd is readable (ie. the event is set). A negative timeout means infinite.
+static bool sWaitForEvent(int inFD, Event::ResetMode inResetMode, int inTimeoutMs)
+{
+	int64 end_ticks  = gGetTickCount() + gMillisecondsToTicks(inTimeoutMs);
+	int   timeout_ms = inTimeoutMs;
+
+	while (true)
+	{
+		pollfd poll_fd = { .fd = inFD, .events = POLLIN };
+		int    ret     = poll(&poll_fd, 1, timeout_ms);
+
+		if (ret == 0)
+			return false; // Timeout.
+
+		if (ret > 0)
+		{
+			if (inResetMode == Event::ManualReset)
+				return true;
+
+			// Reading resets the event, but another thread may have done it first.
+			uint64 value;
+			if (read(inFD, &value, sizeof(value)) == sizeof(value))
+				return true;
+
+			gAssert(errno == EAGAIN);
+		}
+		else
+			gAssert(errno == EINTR);
+
+		// Wait again for what's left of the timeout.
+		if (timeout_ms > 0)
+			timeout_ms = gMax(0, (int)gTicksToMilliseconds(end_ticks - gGetTickCount()));
+	}
+}
+
+
+Event::Event(ResetMode inResetMode, bool inInitialState)
+{
+	// The eventfd counter is non-zero when the event is set. Reading it resets it to zero.
+	int fd = eventfd(inInitialState ? 1 : 0, EFD_CLOEXEC | EFD_NONBLOCK);
+	gAssert(fd >= 0);
+
+	mOSEvent   = (OSEvent)(int64)fd;
+	mResetMode = inResetMode;
+}
+
+
+Event::~Event()
+{
+	int result = close((int)(int64)mOSEvent);
+	gAssert(result == 0);
+}
+
+
+void Event::Set()
+{
+	// Note: Setting it several times only increases the counter, a single read still resets it.
+	uint64  value  = 1;
+	ssize_t result = write((int)(int64)mOSEvent, &value, sizeof(value));
+	gAssert(result == sizeof(value));
+}
+
+
+void Event::Reset()
+{
+	uint64 value;
+	if (read((int)(int64)mOSEvent, &value, sizeof(value)) < 0)
+		gAssert(errno == EAGAIN); // It was not set.
+}
+
+
+bool Event::TryWait() const
+{
+	return TryWaitFor(0_NS);
+}
+
+
+bool Event::TryWaitFor(NanoSeconds inTimeout) const
+{
+	return sWaitForEvent((int)(int64)mOSEvent, mResetMode, (int)gToMilliSeconds(inTimeout));
+}
+
+
+void Event::Wait() const
+{
+	bool success = sWaitForEvent((int)(int64)mOSEvent, mResetMode, -1);
+	gAssert(success);
+}
+
+#endif
+
 REGISTER_TEST("Event")
 {
 	{
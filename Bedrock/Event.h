@@ -30,4 +30,7 @@ struct Event : NoCopy
 private:
 
 	OSEvent mOSEvent = {};
+#ifndef _WIN32
+	ResetMode mResetMode = AutoReset; // Windows events know their own reset mode, eventfds don't.
+#endif
 };
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/File.h>
+#include <Bedrock/String.h>
+#include <Bedrock/Test.h>
+
+#if defined(_WIN32)
+#define VC_EXTRALEAN
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#else
+#error Unknown platform
+#endif
+
+
+MappedFile& MappedFile::operator=(MappedFile&& ioOther)
+{
+	Unmap();
+
+	mMemory  = ioOther.mMemory;
+	mIsValid = ioOther.mIsValid;
+
+	ioOther.mMemory  = {};
+	ioOther.mIsValid = false;
+
+	return *this;
+}
+
+
+#if defined(_WIN32)
+
+MappedFile gMapFileReadOnly(StringView inPath, const MapFileConfig& inConfig)
+{
+	TempString path = inPath; // Need a null terminated string.
+
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if (inConfig.mAccessHint == EFileAccessHint::Sequential)
+		flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	else if (inConfig.mAccessHint == EFileAccessHint::Random)
+		flags |= FILE_FLAG_RANDOM_ACCESS;
+
+	HANDLE file = CreateFileA(path.AsCStr(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return {};
+
+	MappedFile    mapped_file;
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size))
+	{
+		CloseHandle(file);
+		return {};
+	}
+
+	// Empty files can't be mapped, but they're still valid files.
+	if (file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		mapped_file.mIsValid = true;
+		return mapped_file;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file); // The mapping keeps the file open.
+	if (mapping == nullptr)
+		return {};
+
+	void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping); // The view keeps the mapping alive.
+	if (ptr == nullptr)
+		return {};
+
+	mapped_file.mMemory  = { (uint8*)ptr, file_size.QuadPart };
+	mapped_file.mIsValid = true;
+
+	if (inConfig.mPrefetch != EFilePrefetch::None)
+	{
+		WIN32_MEMORY_RANGE_ENTRY range = { ptr, (SIZE_T)file_size.QuadPart };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+		// There is no equivalent to MAP_POPULATE, touch every page instead.
+		if (inConfig.mPrefetch == EFilePrefetch::Blocking)
+		{
+			volatile uint8 sum = 0;
+			for (int64 i = 0; i < file_size.QuadPart; i += gVMemCommitGranularity())
+				sum += mapped_file.mMemory.mPtr[i];
+		}
+	}
+
+	return mapped_file;
+}
+
+
+void MappedFile::Unmap()
+{
+	if (mMemory.mPtr != nullptr)
+	{
+		BOOL result = UnmapViewOfFile(mMemory.mPtr);
+		gAssert(result);
+	}
+
+	mMemory  = {};
+	mIsValid = false;
+}
+
+#elif defined(__linux__)
+
+MappedFile gMapFileReadOnly(StringView inPath, const MapFileConfig& inConfig)
+{
+	TempString path = inPath; // Need a null terminated string.
+
+	int fd = open(path.AsCStr(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return {};
+
+	MappedFile  mapped_file;
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode))
+	{
+		close(fd);
+		return {};
+	}
+
+	// Empty files can't be mapped, but they're still valid files.
+	if (file_stat.st_size == 0)
+	{
+		close(fd);
+		mapped_file.mIsValid = true;
+		return mapped_file;
+	}
+
+	int flags = MAP_PRIVATE;
+	if (inConfig.mPrefetch == EFilePrefetch::Blocking)
+		flags |= MAP_POPULATE;
+
+	void* ptr = mmap(nullptr, file_stat.st_size, PROT_READ, flags, fd, 0);
+	close(fd); // The mapping keeps the file open.
+	if (ptr == MAP_FAILED)
+		return {};
+
+	mapped_file.mMemory  = { (uint8*)ptr, (int64)file_stat.st_size };
+	mapped_file.mIsValid = true;
+
+	// Hints are only hints, ignore errors.
+	if (inConfig.mAccessHint == EFileAccessHint::Sequential)
+		(void)madvise(ptr, file_stat.st_size, MADV_SEQUENTIAL);
+	else if (inConfig.mAccessHint == EFileAccessHint::Random)
+		(void)madvise(ptr, file_stat.st_size, MADV_RANDOM);
+
+	if (inConfig.mPrefetch == EFilePrefetch::Async)
+		(void)madvise(ptr, file_stat.st_size, MADV_WILLNEED);
+
+	return mapped_file;
+}
+
+
+void MappedFile::Unmap()
+{
+	if (mMemory.mPtr != nullptr)
+	{
+		int result = munmap(mMemory.mPtr, mMemory.mSize);
+		gAssert(result == 0);
+	}
+
+	mMemory  = {};
+	mIsValid = false;
+}
+
+#endif
+
+
+REGISTER_TEST("MappedFile")
+{
+	// Use the test source itself as a file to map.
+	MappedFile file = gMapFileReadOnly(__FILE__, { .mAccessHint = EFileAccessHint::Sequential, .mPrefetch = EFilePrefetch::Blocking });
+	TEST_TRUE(file.IsValid());
+	TEST_FALSE(file.IsHuge());
+	TEST_TRUE(file.GetSize() > 0);
+	TEST_TRUE(file.GetStringView().StartsWith("// SPDX-License-Identifier: MPL-2.0"));
+	TEST_TRUE(file.GetSpan().Size() == file.GetSize());
+	TEST_TRUE(file.GetStringView(3, 4) == "SPDX");
+	TEST_TRUE(file.GetSpan(3, 4)[0] == 'S');
+
+	// Move.
+	MappedFile moved = gMove(file);
+	TEST_TRUE(moved.IsValid());
+	TEST_FALSE(file.IsValid());
+	TEST_TRUE(file.GetMemBlock() == nullptr);
+
+	moved.Unmap();
+	TEST_FALSE(moved.IsValid());
+
+	// Missing file.
+	TEST_FALSE(gMapFileReadOnly("this file does not exist").IsValid());
+};
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Memory.h>
+#include <Bedrock/Span.h>
+#include <Bedrock/StringView.h>
+
+
+// Hint about how the memory of a mapped file is going to be accessed.
+enum class EFileAccessHint : int8
+{
+	Normal,		// No particular pattern.
+	Sequential,	// Read mostly front to back. The OS reads ahead more aggressively and can drop pages that were already read.
+	Random,		// Read in no particular order. The OS reads ahead less.
+};
+
+
+// How much of a mapped file is read up front.
+enum class EFilePrefetch : int8
+{
+	None,		// Pages are read on first access.
+	Async,		// Start reading the entire file in the background (MADV_WILLNEED / PrefetchVirtualMemory).
+	Blocking,	// Read the entire file and map all its pages before returning, so that accessing it later doesn't page fault (MAP_POPULATE).
+};
+
+
+struct MapFileConfig
+{
+	EFileAccessHint mAccessHint = EFileAccessHint::Normal;
+	EFilePrefetch   mPrefetch   = EFilePrefetch::None;
+};
+
+
+// Read-only view of an entire file mapped in memory. Unmaps the file when destroyed.
+// The whole file is mapped even if it is larger than 2 GiB, but Span and StringView only support int sizes: for huge files (see IsHuge),
+// use GetMemBlock or the versions of GetSpan/GetStringView that take an offset to look at the file in chunks.
+struct MappedFile : NoCopy
+{
+	MappedFile() = default;
+	~MappedFile() { Unmap(); }
+
+	MappedFile(MappedFile&& ioOther) { operator=((MappedFile&&)ioOther); }
+	MappedFile& operator=(MappedFile&& ioOther);
+
+	// Return true if the file was successfully mapped (an empty file is valid but has no memory).
+	bool              IsValid() const		{ return mIsValid; }
+	bool              IsHuge() const		{ return mMemory.mSize > cMaxInt; } // Too large for Span and StringView.
+	int64             GetSize() const		{ return mMemory.mSize; }
+
+	MemBlock          GetMemBlock() const	{ return mMemory; }
+	Span<const uint8> GetSpan() const		{ gAssert(!IsHuge()); return { mMemory.mPtr, (int)mMemory.mSize }; }
+	StringView        GetStringView() const	{ gAssert(!IsHuge()); return { (const char*)mMemory.mPtr, (int)mMemory.mSize }; }
+
+	// Return a part of the file. The part must be entirely inside the file.
+	Span<const uint8> GetSpan(int64 inOffset, int inSize) const			{ CheckRange(inOffset, inSize); return { mMemory.mPtr + inOffset, inSize }; }
+	StringView        GetStringView(int64 inOffset, int inSize) const	{ CheckRange(inOffset, inSize); return { (const char*)mMemory.mPtr + inOffset, inSize }; }
+
+	// Unmap the file. Views returned previously must not be used anymore.
+	void              Unmap();
+
+private:
+	friend MappedFile gMapFileReadOnly(StringView inPath, const MapFileConfig& inConfig);
+
+	void              CheckRange(int64 inOffset, int inSize) const { gAssert(inOffset >= 0 && inSize >= 0 && inOffset + inSize <= mMemory.mSize); }
+
+	MemBlock mMemory;
+	bool     mIsValid = false;
+};
+
+
+// Map an entire file in memory, read-only.
+// On failure, return a MappedFile that isn't valid (see MappedFile::IsValid).
+MappedFile gMapFileReadOnly(StringView inPath, const MapFileConfig& inConfig = {});
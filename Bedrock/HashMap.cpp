@@ -237,3 +237,21 @@ REGISTER_TEST("Large VMem HashSet")
 	VMemHashSet<int> set;
 	sLargeHashSetTest(set);
 };
+
+
+REGISTER_TEST("VMemHashMap ClearAndFreeMemory")
+{
+	VMemHashMap<int, int> map;
+
+	for (int i = 0; i < 100000; i++)
+		map.Insert(i, i);
+
+	map.ClearAndFreeMemory();
+	TEST_TRUE(map.Empty());
+	TEST_TRUE(map.Capacity() == 0);
+	TEST_TRUE(map.Find(1) == map.End());
+
+	// Can still be used after.
+	map.Insert(1, 1);
+	TEST_TRUE(map.At(1) == 1);
+};
@@ -92,6 +92,11 @@ struct HashMap : taHash
 	HashMap() = default;
 	~HashMap() = default;
 
+	// Default with an arena, for allocators that allocate from an external arena (eg. ArenaAllocator).
+	template <typename taArena>
+	requires requires (taArena& ioArena) { taAllocator<KeyValue>(ioArena); }
+	explicit HashMap(taArena& ioArena) : mKeyValues(taAllocator<KeyValue>(ioArena)), mBuckets(taAllocator<Bucket>(ioArena)) {}
+
 	// Move
 	HashMap(HashMap&&) = default;
 	HashMap& operator=(HashMap&& ioOther) = default;
@@ -101,6 +106,7 @@ struct HashMap : taHash
 	HashMap& operator=(const HashMap& inOther);
 
 	void Clear();
+	void ClearAndFreeMemory();
 	bool Empty() const { return mKeyValues.Empty(); }
 	bool IsFull() const	{ return mKeyValues.Size() == mKeyValues.Capacity(); }
 
@@ -698,6 +704,11 @@ private:
 };
 
 
+// HashMap can be relocated with a memcpy if its allocator can (the key-values themselves are not moved).
+template <typename taKey, typename taValue, typename taHash, template <typename> class taAllocator>
+inline constexpr bool cIsTriviallyRelocatable<HashMap<taKey, taValue, taHash, taAllocator>> = cIsTriviallyRelocatable<taAllocator<Details::HashMapBucket>> && cIsTriviallyCopyable<taHash>;
+
+
 // HashSet variant of the HashMap (no values).
 template <
 	typename taKey,
@@ -758,3 +769,10 @@ void HashMap<taKey, taValue, taHash, taAllocator>::Clear()
 }
 
 
+template <typename taKey, typename taValue, typename taHash, template <typename> class taAllocator>
+void HashMap<taKey, taValue, taHash, taAllocator>::ClearAndFreeMemory()
+{
+	// Free the buckets first since they're allocated last (see Grow).
+	mBuckets.ClearAndFreeMemory();
+	mKeyValues.ClearAndFreeMemory();
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/MPMCQueue.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/UniquePtr.h>
+#include <Bedrock/Function.h>
+
+
+REGISTER_TEST("MPMCQueue")
+{
+	MPMCQueue<int> queue(6);
+	TEST_TRUE(queue.Capacity() == 8);
+
+	int value = 0;
+	TEST_FALSE(queue.TryPop(value));
+
+	for (int i = 0; i < 8; ++i)
+		TEST_TRUE(queue.TryPush(i));
+	TEST_FALSE(queue.TryPush(8));
+	TEST_TRUE(queue.SizeApprox() == 8);
+
+	TEST_TRUE(queue.TryPop(value));
+	TEST_TRUE(value == 0);
+	TEST_TRUE(queue.TryPush(8)); // Wraps around.
+
+	for (int i = 1; i <= 8; ++i)
+	{
+		TEST_TRUE(queue.TryPop(value));
+		TEST_TRUE(value == i);
+	}
+	TEST_FALSE(queue.TryPop(value));
+	TEST_TRUE(queue.SizeApprox() == 0);
+};
+
+
+REGISTER_TEST("MPMCQueue MoveOnly")
+{
+	MPMCQueue<UniquePtr<int>> queue(2);
+	TEST_TRUE(queue.TryPush(UniquePtr(new int(1))));
+	TEST_TRUE(queue.TryEmplace(UniquePtr(new int(2))));
+
+	// A failed push doesn't move from the value.
+	UniquePtr<int> three = UniquePtr(new int(3));
+	TEST_FALSE(queue.TryPush(gMove(three)));
+	TEST_TRUE(three != nullptr);
+
+	UniquePtr<int> value;
+	TEST_TRUE(queue.TryPop(value));
+	TEST_TRUE(*value == 1);
+	// The remaining element is destroyed with the queue. Leak detection will tell.
+
+	MPMCQueue<Function<int()>> functions(4);
+	TEST_TRUE(functions.TryPush([] { return 42; }));
+
+	Function<int()> func;
+	TEST_TRUE(functions.TryPop(func));
+	TEST_TRUE(func() == 42);
+};
+
+
+REGISTER_TEST("MPMCQueue Threads")
+{
+	constexpr int  cNumProducers         = 4;
+	constexpr int  cNumConsumers         = 4;
+	constexpr int  cCountPerProducer     = 20'000;
+	constexpr int  cCount                = cNumProducers * cCountPerProducer;
+	MPMCQueue<int> queue(256);
+
+	AtomicInt32 num_popped = 0;
+	AtomicInt64 sum        = 0;
+	{
+		Thread threads[cNumProducers + cNumConsumers];
+
+		for (int p = 0; p < cNumProducers; ++p)
+		{
+			threads[p].Create({ .mName = "MPMCProducer" }, [&queue, p](Thread&)
+			{
+				for (int i = 0; i < cCountPerProducer; ++i)
+				{
+					while (!queue.TryPush(p * cCountPerProducer + i))
+						gThreadYield();
+				}
+			});
+		}
+
+		for (int c = 0; c < cNumConsumers; ++c)
+		{
+			threads[cNumProducers + c].Create({ .mName = "MPMCConsumer" }, [&](Thread&)
+			{
+				int64 local_sum = 0;
+				while (num_popped.Load(MemoryOrder::Relaxed) < cCount)
+				{
+					int value;
+					if (queue.TryPop(value))
+					{
+						local_sum += value;
+						num_popped.Add(1);
+					}
+					else
+						gThreadYield();
+				}
+				sum.Add(local_sum);
+			});
+		}
+	}
+
+	TEST_TRUE(num_popped.Load() == cCount);
+	TEST_TRUE(sum.Load() == (int64)cCount * (cCount - 1) / 2);
+	TEST_TRUE(queue.SizeApprox() == 0);
+};
+
+
+REGISTER_TEST("BlockingMPMCQueue")
+{
+	constexpr int          cNumProducers     = 3;
+	constexpr int          cNumConsumers     = 3;
+	constexpr int          cCountPerProducer = 20'000;
+	BlockingMPMCQueue<int> queue(16);
+
+	int value;
+	TEST_FALSE(queue.TryPop(value));
+
+	AtomicInt64 sum = 0;
+	{
+		Thread threads[cNumProducers + cNumConsumers];
+
+		for (int p = 0; p < cNumProducers; ++p)
+		{
+			threads[p].Create({ .mName = "MPMCProducer" }, [&queue, p](Thread&)
+			{
+				for (int i = 0; i < cCountPerProducer; ++i)
+					queue.Push(p * cCountPerProducer + i);
+			});
+		}
+
+		// Each consumer pops the same number of elements as a producer pushes.
+		for (int c = 0; c < cNumConsumers; ++c)
+		{
+			threads[cNumProducers + c].Create({ .mName = "MPMCConsumer" }, [&queue, &sum](Thread&)
+			{
+				int64 local_sum = 0;
+				for (int i = 0; i < cCountPerProducer; ++i)
+				{
+					int value;
+					queue.Pop(value);
+					local_sum += value;
+				}
+				sum.Add(local_sum);
+			});
+		}
+	}
+
+	constexpr int64 cCount = cNumProducers * cCountPerProducer;
+	TEST_TRUE(sum.Load() == cCount * (cCount - 1) / 2);
+	TEST_FALSE(queue.TryPop(value));
+
+	// Non-blocking functions.
+	for (int i = 0; i < 16; ++i)
+		TEST_TRUE(queue.TryPush(i));
+	TEST_FALSE(queue.TryPush(16));
+	TEST_TRUE(queue.TryPop(value));
+	TEST_TRUE(value == 0);
+	TEST_TRUE(queue.TryPush(16));
+};
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Atomic.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Semaphore.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/PlacementNew.h>
+
+
+namespace Details
+{
+	// A slot of the MPMCQueue, with the sequence number that tells which operation it's ready for.
+	template <typename taType>
+	struct MPMCQueueCell
+	{
+		AtomicInt64 mSequence;
+		alignas(taType) uint8 mStorage[sizeof(taType)];
+
+		taType& GetValue() { return *(taType*)mStorage; }
+	};
+}
+
+
+// Bounded lock-free queue for any number of producer and consumer threads (Dmitry Vyukov's algorithm).
+// Each slot has a sequence number telling whether it's ready to be written or read for a given position.
+// Positions are 64-bit and never wrap, so a slot can't be mistaken for one from a previous lap (no ABA).
+// Producers and consumers only contend on their own index (one compare-exchange per operation), the slots
+// themselves are never locked.
+// See BlockingMPMCQueue for a version that can wait.
+template <typename taType, template <typename> typename taAllocator = DefaultAllocator>
+struct MPMCQueue : NoCopy, private taAllocator<Details::MPMCQueueCell<taType>>
+{
+	using ValueType = taType;
+	using Cell      = Details::MPMCQueueCell<taType>;
+	using Allocator = taAllocator<Cell>;
+
+	// inCapacity is rounded up to a power of 2.
+	explicit MPMCQueue(int inCapacity, Allocator&& inAllocator = {});
+	~MPMCQueue();
+
+	int Capacity() const { return mCapacity; }
+
+	// Return the number of elements in the queue. Only exact when no other thread is pushing or popping.
+	int SizeApprox() const { return (int)gClamp(mTail.Load(MemoryOrder::Relaxed) - mHead.Load(MemoryOrder::Relaxed), (int64)0, (int64)mCapacity); }
+
+	// Add an element. Return false if the queue is full.
+	// The value is only moved from if the push succeeds.
+	bool TryPush(const taType& inValue)	{ return TryEmplace(inValue); }
+	bool TryPush(taType&& inValue)		{ return TryEmplace(gMove(inValue)); }
+	template <typename... taArgs>
+	bool TryEmplace(taArgs&&... inArgs);
+
+	// Remove the front element and move it into outValue. Return false if the queue is empty.
+	bool TryPop(taType& outValue);
+
+private:
+	// Read-only after construction.
+	Cell*       mCells    = nullptr;
+	int         mCapacity = 0;
+
+	// Separate cache lines, otherwise producers and consumers would slow each other down.
+	alignas(cCacheLineSize)
+	AtomicInt64 mTail     = 0;		// Next position to push to.
+	alignas(cCacheLineSize)
+	AtomicInt64 mHead     = 0;		// Next position to pop from.
+};
+
+
+// MPMCQueue with blocking Push and Pop. They wait on a Semaphore when the queue is full or empty.
+// The number of elements and free slots are also tracked with atomic counters, so the semaphores are only touched
+// when a thread actually needs to wait or be woken up.
+template <typename taType, template <typename> typename taAllocator = DefaultAllocator>
+struct BlockingMPMCQueue : NoCopy
+{
+	using ValueType = taType;
+	using Allocator = typename MPMCQueue<taType, taAllocator>::Allocator;
+
+	explicit BlockingMPMCQueue(int inCapacity, Allocator&& inAllocator = {});
+
+	int  Capacity() const	{ return mQueue.Capacity(); }
+	int  SizeApprox() const	{ return mQueue.SizeApprox(); }
+
+	// Add an element. TryPush returns false if the queue is full, Push waits until there is space.
+	// The value is only moved from if the push succeeds.
+	bool TryPush(const taType& inValue)		{ if (!sTryAcquire(mFreeSlots)) return false; PushAcquired(inValue); return true; }
+	bool TryPush(taType&& inValue)			{ if (!sTryAcquire(mFreeSlots)) return false; PushAcquired(gMove(inValue)); return true; }
+	void Push(const taType& inValue)		{ sAcquire(mFreeSlots, mFreeSlotsSemaphore); PushAcquired(inValue); }
+	void Push(taType&& inValue)				{ sAcquire(mFreeSlots, mFreeSlotsSemaphore); PushAcquired(gMove(inValue)); }
+
+	// Remove the front element. TryPop returns false if the queue is empty, Pop waits until there is an element.
+	bool TryPop(taType& outValue)			{ if (!sTryAcquire(mElements)) return false; PopAcquired(outValue); return true; }
+	void Pop(taType& outValue)				{ sAcquire(mElements, mElementsSemaphore); PopAcquired(outValue); }
+
+private:
+	// The counters are the number of elements/free slots minus the number of threads waiting for one.
+	static bool sTryAcquire(AtomicInt32& ioCounter);
+	static void sAcquire(AtomicInt32& ioCounter, Semaphore& ioSemaphore);
+	static void sRelease(AtomicInt32& ioCounter, Semaphore& ioSemaphore);
+
+	template <typename taValue> void PushAcquired(taValue&& inValue);
+	void PopAcquired(taType& outValue);
+
+	MPMCQueue<taType, taAllocator> mQueue;
+
+	alignas(cCacheLineSize)
+	AtomicInt32                    mElements;
+	Semaphore                      mElementsSemaphore;
+
+	alignas(cCacheLineSize)
+	AtomicInt32                    mFreeSlots;
+	Semaphore                      mFreeSlotsSemaphore;
+};
+
+
+template <typename taType, template <typename> typename taAllocator>
+MPMCQueue<taType, taAllocator>::MPMCQueue(int inCapacity, Allocator&& inAllocator)
+	: Allocator(gMove(inAllocator))
+{
+	gAssert(inCapacity > 0);
+
+	mCapacity = (int)gGetNextPow2(inCapacity);
+	mCells    = Allocator::Allocate(mCapacity);
+
+	// Each slot is initially ready to be written for its first lap.
+	for (int i = 0; i < mCapacity; ++i)
+		gPlacementNew(mCells[i].mSequence, (int64)i);
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+MPMCQueue<taType, taAllocator>::~MPMCQueue()
+{
+	// Destroy the elements that were not popped.
+	if constexpr (!cIsTriviallyDestructible<taType>)
+	{
+		for (int64 i = mHead.Load(MemoryOrder::Relaxed), end = mTail.Load(MemoryOrder::Relaxed); i < end; ++i)
+			mCells[i & (mCapacity - 1)].GetValue().~taType();
+	}
+
+	Allocator::Free(mCells, mCapacity);
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+template <typename ... taArgs>
+bool MPMCQueue<taType, taAllocator>::TryEmplace(taArgs&&... inArgs)
+{
+	int64 pos = mTail.Load(MemoryOrder::Relaxed);
+	Cell* cell;
+
+	while (true)
+	{
+		cell = &mCells[pos & (mCapacity - 1)];
+
+		int64 sequence = cell->mSequence.Load(MemoryOrder::Acquire);
+		int64 diff     = sequence - pos;
+
+		if (diff == 0)
+		{
+			// The slot is free for this lap, try to claim the position.
+			// Note: on failure pos is updated with the current tail.
+			if (mTail.CompareExchange(pos, pos + 1))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// The slot still contains the element from the previous lap, the queue is full.
+			return false;
+		}
+		else
+		{
+			// Another producer claimed this position already, reload.
+			pos = mTail.Load(MemoryOrder::Relaxed);
+		}
+	}
+
+	gPlacementNew(cell->GetValue(), gForward<taArgs>(inArgs)...);
+
+	// Publish the element to the consumer of this position.
+	cell->mSequence.Store(pos + 1, MemoryOrder::Release);
+	return true;
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+bool MPMCQueue<taType, taAllocator>::TryPop(taType& outValue)
+{
+	int64 pos = mHead.Load(MemoryOrder::Relaxed);
+	Cell* cell;
+
+	while (true)
+	{
+		cell = &mCells[pos & (mCapacity - 1)];
+
+		int64 sequence = cell->mSequence.Load(MemoryOrder::Acquire);
+		int64 diff     = sequence - (pos + 1);
+
+		if (diff == 0)
+		{
+			// The slot contains the element for this position, try to claim it.
+			// Note: on failure pos is updated with the current head.
+			if (mHead.CompareExchange(pos, pos + 1))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// The slot hasn't been written yet, the queue is empty.
+			return false;
+		}
+		else
+		{
+			// Another consumer claimed this position already, reload.
+			pos = mHead.Load(MemoryOrder::Relaxed);
+		}
+	}
+
+	taType& element = cell->GetValue();
+	outValue = gMove(element);
+	element.~taType();
+
+	// Give the slot back to the producer of the next lap.
+	cell->mSequence.Store(pos + mCapacity, MemoryOrder::Release);
+	return true;
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+BlockingMPMCQueue<taType, taAllocator>::BlockingMPMCQueue(int inCapacity, Allocator&& inAllocator)
+	: mQueue(inCapacity, gMove(inAllocator))
+	, mElements(0)
+	, mElementsSemaphore(0, cMaxInt32)
+	, mFreeSlots(mQueue.Capacity())
+	, mFreeSlotsSemaphore(0, cMaxInt32)
+{
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+bool BlockingMPMCQueue<taType, taAllocator>::sTryAcquire(AtomicInt32& ioCounter)
+{
+	int32 count = ioCounter.Load(MemoryOrder::Relaxed);
+	while (count > 0)
+	{
+		if (ioCounter.CompareExchange(count, count - 1))
+			return true;
+	}
+
+	return false;
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+void BlockingMPMCQueue<taType, taAllocator>::sAcquire(AtomicInt32& ioCounter, Semaphore& ioSemaphore)
+{
+	// If the counter goes negative, wait for a release.
+	if (ioCounter.Sub(1) <= 0)
+		ioSemaphore.Acquire();
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+void BlockingMPMCQueue<taType, taAllocator>::sRelease(AtomicInt32& ioCounter, Semaphore& ioSemaphore)
+{
+	// If the counter was negative, a thread is waiting, wake it up.
+	if (ioCounter.Add(1) < 0)
+		ioSemaphore.Release();
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+template <typename taValue>
+void BlockingMPMCQueue<taType, taAllocator>::PushAcquired(taValue&& inValue)
+{
+	// A free slot was acquired, but the consumer that freed the slot at our position might not be done with it yet
+	// (consumers can finish out of order). That's a short wait.
+	while (!mQueue.TryPush(gForward<taValue>(inValue)))
+		gThreadYield();
+
+	sRelease(mElements, mElementsSemaphore);
+}
+
+
+template <typename taType, template <typename> typename taAllocator>
+void BlockingMPMCQueue<taType, taAllocator>::PopAcquired(taType& outValue)
+{
+	// An element was acquired, but the producer writing the element at our position might not be done yet
+	// (producers can finish out of order). That's a short wait.
+	while (!mQueue.TryPop(outValue))
+		gThreadYield();
+
+	sRelease(mFreeSlots, mFreeSlotsSemaphore);
+}
@@ -1,18 +1,102 @@
 // SPDX-License-Identifier: MPL-2.0
 #include <Bedrock/Memory.h>
+#include <Bedrock/MemoryStats.h>
+#include <Bedrock/StringView.h>
 #include <Bedrock/Test.h>
 
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+#include <Bedrock/SizeClassHeap.h>
+#endif
+
 #include <stdlib.h>
+#include <malloc.h>
+
+#if defined(_WIN32)
+#define VC_EXTRALEAN
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#else
+#error Unknown platform
+#endif
 
-MemBlock gMemAlloc(int64 inSize)
+// Allocate from the underlying heap. Memory isn't tracked.
+static force_inline MemBlock sHeapAlloc(int64 inSize)
 {
-	MemBlock memory = { (uint8*)malloc(inSize), inSize };
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+	return gSizeClassHeapAlloc(inSize);
+#else
+	return { (uint8*)malloc(inSize), inSize };
+#endif
+}
+
+
+// Free memory allocated with sHeapAlloc. Memory isn't tracked.
+static force_inline void sHeapFree(MemBlock inMemory)
+{
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+	gSizeClassHeapFree(inMemory);
+#else
+	free(inMemory.mPtr);
+#endif
+}
+
+
+// Return the number of bytes that can actually be used in memory allocated with sHeapAlloc.
+static int64 sHeapGetUsableSize(MemBlock inMemory)
+{
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+	if (inMemory.mSize <= cSizeClassHeapMaxSize)
+		return gSizeClassHeapGetUsableSize(inMemory.mSize);
+#endif
+
+#if defined(_WIN32)
+	return (int64)_msize(inMemory.mPtr);
+#else
+	return (int64)malloc_usable_size(inMemory.mPtr);
+#endif
+}
+
+
+// Round down the usable size to a multiple of inSizeGranularity. Can't go below inSize which is already a multiple.
+static force_inline int64 sRoundUsableSize(int64 inUsableSize, int64 inSize, int inSizeGranularity)
+{
+	return gMax(inSize, inUsableSize - (inUsableSize % inSizeGranularity));
+}
+
+
+static force_inline void sTrackAlloc(MemBlock inMemory)
+{
+	gGetMemCounters(EMemoryKind::Heap).OnAlloc(inMemory.mSize);
 
 #ifdef TESTS_ENABLED
 	if (gIsRunningTest()) 
-		gRegisterAlloc(memory);
+		gRegisterAlloc(inMemory);
 #endif
+}
+
+
+static force_inline void sTrackFree(MemBlock inMemory)
+{
+	gGetMemCounters(EMemoryKind::Heap).OnFree(inMemory.mSize);
+
+#ifdef TESTS_ENABLED
+	if (gIsRunningTest()) 
+		gRegisterFree(inMemory);
+#endif
+}
+
+
+MemBlock gMemAlloc(int64 inSize)
+{
+	MemBlock memory = sHeapAlloc(inSize);
+
+	if (memory.mPtr != nullptr) [[likely]]
+		sTrackAlloc(memory);
 
 	return memory;
 }
@@ -23,15 +107,141 @@ void gMemFree(MemBlock inMemory)
 	gAssert(inMemory.mPtr != nullptr);
 	gAssert(inMemory.mSize > 0);
 
-#ifdef TESTS_ENABLED
-	if (gIsRunningTest()) 
-		gRegisterFree(inMemory);
+	sTrackFree(inMemory);
+	sHeapFree(inMemory);
+}
+
+
+MemBlock gMemAllocAtLeast(int64 inSize, int inSizeGranularity)
+{
+	gAssert(inSizeGranularity > 0 && (inSize % inSizeGranularity) == 0);
+
+	MemBlock memory = sHeapAlloc(inSize);
+
+	if (memory.mPtr != nullptr) [[likely]]
+	{
+		memory.mSize = sRoundUsableSize(sHeapGetUsableSize(memory), inSize, inSizeGranularity);
+		sTrackAlloc(memory);
+	}
+
+	return memory;
+}
+
+
+MemBlock gMemRealloc(MemBlock inMemory, int64 inNewSize, int inSizeGranularity)
+{
+	gAssert(inMemory.mPtr != nullptr);
+	gAssert(inNewSize > 0);
+	gAssert(inSizeGranularity > 0 && (inNewSize % inSizeGranularity) == 0);
+
+	MemBlock new_memory;
+
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+	// Small allocations are in size classes, they can't be resized.
+	if (inMemory.mSize <= cSizeClassHeapMaxSize || inNewSize <= cSizeClassHeapMaxSize)
+	{
+		new_memory = sHeapAlloc(inNewSize);
+		if (new_memory == nullptr) [[unlikely]]
+			return {};
+
+		gMemCopy(new_memory.mPtr, inMemory.mPtr, gMin(inMemory.mSize, inNewSize));
+		sHeapFree(inMemory);
+	}
+	else
 #endif
+	{
+		// realloc can grow in place, or move pages without copying them (eg. with mremap).
+		new_memory = { (uint8*)realloc(inMemory.mPtr, inNewSize), inNewSize };
+		if (new_memory == nullptr) [[unlikely]]
+			return {}; // inMemory is left untouched.
+	}
 
-	free(inMemory.mPtr);
+	new_memory.mSize = sRoundUsableSize(sHeapGetUsableSize(new_memory), inNewSize, inSizeGranularity);
+
+	sTrackFree(inMemory);
+	sTrackAlloc(new_memory);
+
+	return new_memory;
+}
+
+
+MemBlock gMemAllocAligned(int64 inSize, int inAlignment)
+{
+	gAssert(gIsPow2(inAlignment));
+
+	if (inAlignment <= cMemDefaultAlignment) [[likely]]
+		return gMemAlloc(inSize);
+
+	// Over-allocate and store the original pointer just before the aligned one.
+	// Since gMemAlloc returns memory aligned to cMemDefaultAlignment, there is always room for it.
+	MemBlock memory = gMemAlloc(inSize + inAlignment);
+	if (memory == nullptr) [[unlikely]]
+		return {};
+
+	uint8* aligned_ptr         = (uint8*)gAlignUp((uint64)memory.mPtr + 1, (uint64)inAlignment);
+	((uint8**)aligned_ptr)[-1] = memory.mPtr;
+
+	return { aligned_ptr, inSize };
+}
+
+
+void gMemFreeAligned(MemBlock inMemory, int inAlignment)
+{
+	gAssert(gIsPow2(inAlignment));
+
+	if (inAlignment <= cMemDefaultAlignment) [[likely]]
+		return gMemFree(inMemory);
+
+	gAssert(((uint64)inMemory.mPtr % inAlignment) == 0);
+
+	uint8* original_ptr = ((uint8**)inMemory.mPtr)[-1];
+	gMemFree({ original_ptr, inMemory.mSize + inAlignment });
+}
+
+
+// Align the memory block boundaries to commit granularity, rounding outward.
+static MemBlock sAlignToCommitGranularityOutward(MemBlock inBlock)
+{
+	int64 begin = (int64)inBlock.mPtr;
+	int64 end   = begin + inBlock.mSize;
+
+	int64 granularity = gVMemCommitGranularity();
+	begin             = gAlignDown(begin, granularity);
+	end               = gAlignUp(end, granularity);
+
+	return { (uint8*)begin, end - begin };
 }
 
 
+// Align the memory block boundaries to commit granularity, rounding inward (only keep whole pages).
+static MemBlock sAlignToCommitGranularityInward(MemBlock inBlock)
+{
+	int64 begin = (int64)inBlock.mPtr;
+	int64 end   = begin + inBlock.mSize;
+
+	int64 granularity = gVMemCommitGranularity();
+	begin             = gAlignUp(begin, granularity);
+	end               = gAlignDown(end, granularity);
+
+	if (end <= begin)
+		return {};
+
+	return { (uint8*)begin, end - begin };
+}
+
+
+static int sVMemLargePageSizeOverride = 0;
+
+
+void Details::SetVMemLargePageSizeOverride(int inLargePageSize)
+{
+	gAssert(inLargePageSize == 0 || (gIsPow2(inLargePageSize) && inLargePageSize > gVMemCommitGranularity()));
+	sVMemLargePageSizeOverride = inLargePageSize;
+}
+
+
+#if defined(_WIN32)
+
 int gVMemReserveGranularity()
 {
     static const int sReserveGranularity = []()
@@ -62,8 +272,21 @@ int gVMemCommitGranularity()
 }
 
 
-MemBlock gVMemReserve(int64 inSize)
+int gVMemLargePageSize()
+{
+	if (sVMemLargePageSizeOverride != 0) [[unlikely]]
+		return sVMemLargePageSizeOverride;
+
+	// Windows large pages (MEM_LARGE_PAGES) need a privilege and have to be committed when they're reserved,
+	// which doesn't work with the reserve/commit model used here. Consider them not available.
+	return 0;
+}
+
+
+MemBlock gVMemReserve(int64 inSize, EVMemPageSize inPageSize)
 {
+	(void)inPageSize; // Large pages are never available (unless faked for tests), see gVMemLargePageSize.
+
 	inSize = gAlignUp(inSize, gVMemReserveGranularity());
 	void* ptr = VirtualAlloc(nullptr, inSize, MEM_RESERVE, PAGE_NOACCESS);
 
@@ -86,16 +309,7 @@ void gVMemFree(MemBlock inBlock)
 
 MemBlock gVMemCommit(MemBlock inBlock)
 {
-	int64 begin = (int64)inBlock.mPtr;
-	int64 end   = begin + inBlock.mSize;
-
-	// Align the memory block boundaries to page sizes (in case they weren't).
-	int64 granularity = gVMemCommitGranularity();
-	begin             = gAlignDown(begin, granularity);
-	end               = gAlignUp(end, granularity);
-
-	inBlock.mPtr  = (uint8*)begin;
-	inBlock.mSize = end - begin;
+	inBlock = sAlignToCommitGranularityOutward(inBlock);
 
 	void* ptr = VirtualAlloc(inBlock.mPtr, inBlock.mSize, MEM_COMMIT, PAGE_READWRITE);
 
@@ -106,4 +320,299 @@ MemBlock gVMemCommit(MemBlock inBlock)
 	}
 
 	return inBlock;
-}
\ No newline at end of file
+}
+
+
+MemBlock gVMemDecommit(MemBlock inBlock)
+{
+	inBlock = sAlignToCommitGranularityInward(inBlock);
+
+	if (inBlock == nullptr)
+		return {};
+
+	BOOL success = VirtualFree(inBlock.mPtr, inBlock.mSize, MEM_DECOMMIT);
+	gAssert(success);
+
+	return inBlock;
+}
+
+#elif defined(__linux__)
+
+int gVMemReserveGranularity()
+{
+	// There is no separate allocation granularity on Linux, mmap works with pages.
+	return gVMemCommitGranularity();
+}
+
+
+int gVMemCommitGranularity()
+{
+	static const int sCommitGranularity = []()
+	{
+		int page_size = (int)sysconf(_SC_PAGESIZE);
+
+		gAssert(gIsPow2(page_size));
+		return page_size;
+	}();
+
+	return sCommitGranularity;
+}
+
+
+// Read a small text file into inBuffer. Return the number of bytes read, or 0 on failure.
+static int sReadSmallFile(const char* inPath, char* outBuffer, int inBufferSize)
+{
+	int fd = open(inPath, O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	int size = (int)read(fd, outBuffer, inBufferSize - 1);
+	close(fd);
+
+	if (size <= 0)
+		return 0;
+
+	outBuffer[size] = 0;
+	return size;
+}
+
+
+int gVMemLargePageSize()
+{
+	if (sVMemLargePageSizeOverride != 0) [[unlikely]]
+		return sVMemLargePageSizeOverride;
+
+	// Use Transparent Huge Pages rather than explicit huge pages (MAP_HUGETLB). Explicit huge pages need to be pre-allocated
+	// by the admin and are reserved by mmap, which doesn't work with the reserve/commit model used here.
+	static const int sLargePageSize = []()
+	{
+		char buffer[256];
+
+		// THP is either enabled "always", on "madvise" or "never". Only the last one is a problem.
+		if (sReadSmallFile("/sys/kernel/mm/transparent_hugepage/enabled", buffer, sizeof(buffer)) == 0)
+			return 0;
+
+		if (StringView(buffer).Contains("[never]"))
+			return 0;
+
+		int64 large_page_size = 0;
+		if (sReadSmallFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", buffer, sizeof(buffer)) != 0)
+		{
+			for (const char* str = buffer; *str >= '0' && *str <= '9'; str++)
+				large_page_size = large_page_size * 10 + (*str - '0');
+		}
+
+		if (large_page_size <= gVMemCommitGranularity() || large_page_size > 1_GiB || !gIsPow2(large_page_size))
+			return 0;
+
+		return (int)large_page_size;
+	}();
+
+	return sLargePageSize;
+}
+
+
+MemBlock gVMemReserve(int64 inSize, EVMemPageSize inPageSize)
+{
+	int64 alignment = gVMemReserveGranularity();
+
+	if (inPageSize == EVMemPageSize::Large && gVMemLargePageSize() != 0)
+		alignment = gVMemLargePageSize();
+
+	inSize = gAlignUp(inSize, alignment);
+
+	// mmap only guarantees page alignment, reserve a bit more to be able to align the pointer.
+	int64 reserved_size = inSize;
+	if (alignment > gVMemReserveGranularity())
+		reserved_size += alignment;
+
+	// Reserve address space only: PROT_NONE pages can't be accessed, and MAP_NORESERVE avoids counting them against the overcommit limit.
+	void* ptr = mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+	if (ptr == MAP_FAILED) [[unlikely]]
+	{
+		gAssert(false);
+		return {};
+	}
+
+	if (reserved_size != inSize)
+	{
+		// Give back the parts before and after the aligned block.
+		uint8* begin         = (uint8*)ptr;
+		uint8* aligned_begin = (uint8*)gAlignUp((int64)begin, alignment);
+		uint8* aligned_end   = aligned_begin + inSize;
+		uint8* end           = begin + reserved_size;
+
+		if (aligned_begin != begin)
+			munmap(begin, aligned_begin - begin);
+		if (aligned_end != end)
+			munmap(aligned_end, end - aligned_end);
+
+		ptr = aligned_begin;
+
+		// Ask for the memory to be backed by huge pages once it's committed.
+		// Note: This can fail if THP is not compiled in, but it's only a hint anyway.
+		madvise(ptr, inSize, MADV_HUGEPAGE);
+	}
+
+	return { (uint8*)ptr, inSize };
+}
+
+
+void gVMemFree(MemBlock inBlock)
+{
+	int result = munmap(inBlock.mPtr, inBlock.mSize);
+	gAssert(result == 0);
+}
+
+
+MemBlock gVMemCommit(MemBlock inBlock)
+{
+	inBlock = sAlignToCommitGranularityOutward(inBlock);
+
+	// Pages become accessible, but physical memory is only used once they are touched.
+	if (mprotect(inBlock.mPtr, inBlock.mSize, PROT_READ | PROT_WRITE) != 0) [[unlikely]]
+	{
+		gAssert(false);
+		return {};
+	}
+
+	return inBlock;
+}
+
+
+MemBlock gVMemDecommit(MemBlock inBlock)
+{
+	inBlock = sAlignToCommitGranularityInward(inBlock);
+
+	if (inBlock == nullptr)
+		return {};
+
+	// Note: MADV_DONTNEED releases the pages immediately (and they'll read as zero if committed again).
+	// MADV_FREE is cheaper but only releases them under memory pressure, so RSS wouldn't go down.
+	int result = madvise(inBlock.mPtr, inBlock.mSize, MADV_DONTNEED);
+	gAssert(result == 0);
+
+	// Make the pages inaccessible again, to behave like Windows.
+	result = mprotect(inBlock.mPtr, inBlock.mSize, PROT_NONE);
+	gAssert(result == 0);
+
+	return inBlock;
+}
+
+#endif
+
+
+REGISTER_TEST("VMem")
+{
+	int64    page_size = gVMemCommitGranularity();
+	MemBlock reserved  = gVMemReserve(page_size * 4);
+	TEST_TRUE(reserved != nullptr);
+	TEST_TRUE(reserved.mSize >= page_size * 4);
+
+	// Commit rounds outward to whole pages.
+	MemBlock committed = gVMemCommit({ reserved.mPtr + 1, page_size * 2 });
+	TEST_TRUE(committed.mPtr == reserved.mPtr);
+	TEST_TRUE(committed.mSize == page_size * 3);
+	for (int64 i = 0; i < committed.mSize; i += page_size)
+		committed.mPtr[i] = 1;
+
+	// Decommit rounds inward, only whole pages are decommitted.
+	MemBlock decommitted = gVMemDecommit({ reserved.mPtr + 1, page_size * 2 });
+	TEST_TRUE(decommitted.mPtr == reserved.mPtr + page_size);
+	TEST_TRUE(decommitted.mSize == page_size);
+
+	// Less than a whole page, nothing to decommit.
+	TEST_TRUE(gVMemDecommit({ reserved.mPtr + 1, page_size }) == nullptr);
+
+	// The other pages are still committed.
+	TEST_TRUE(reserved.mPtr[0] == 1);
+	TEST_TRUE(reserved.mPtr[page_size * 2] == 1);
+
+	// Committing again gives zeroed pages.
+	committed = gVMemCommit(decommitted);
+	TEST_TRUE(committed.mPtr[0] == 0);
+
+	gVMemFree(reserved);
+};
+
+
+REGISTER_TEST("MemAllocAligned")
+{
+	// Default alignment doesn't waste anything.
+	MemBlock a = gMemAllocAligned(100, 8);
+	TEST_TRUE(a.mSize == 100);
+	TEST_TRUE(((uint64)a.mPtr % cMemDefaultAlignment) == 0);
+
+	MemBlock b = gMemAllocAligned(100, 64);
+	MemBlock c = gMemAllocAligned(3, 4096);
+	TEST_TRUE(b.mSize == 100);
+	TEST_TRUE(((uint64)b.mPtr % 64) == 0);
+	TEST_TRUE(((uint64)c.mPtr % 4096) == 0);
+	b.mPtr[0]  = 1;
+	b.mPtr[99] = 1;
+	c.mPtr[2]  = 1;
+
+	gMemFreeAligned(c, 4096);
+	gMemFreeAligned(b, 64);
+	gMemFreeAligned(a, 8);
+};
+
+
+REGISTER_TEST("MemRealloc")
+{
+	// The usable size is at least the requested size, and a multiple of the granularity.
+	MemBlock memory = gMemAllocAtLeast(12 * 5, 12);
+	TEST_TRUE(memory.mSize >= 12 * 5);
+	TEST_TRUE((memory.mSize % 12) == 0);
+
+	for (int64 i = 0; i < memory.mSize; ++i)
+		memory.mPtr[i] = (uint8)i;
+
+	// Grow to a large size, the content is preserved.
+	int64 old_size = memory.mSize;
+	memory         = gMemRealloc(memory, 1_MiB);
+	TEST_TRUE(memory.mSize >= 1_MiB);
+
+	bool content_preserved = true;
+	for (int64 i = 0; i < old_size; ++i)
+		content_preserved &= (memory.mPtr[i] == (uint8)i);
+	TEST_TRUE(content_preserved);
+
+	memory.mPtr[1_MiB - 1] = 1;
+
+	memory = gMemRealloc(memory, 2_MiB);
+	TEST_TRUE(memory.mSize >= 2_MiB);
+	TEST_TRUE(memory.mPtr[1_MiB - 1] == 1);
+
+	// Shrink back, the beginning is preserved.
+	memory = gMemRealloc(memory, 16);
+	TEST_TRUE(memory.mSize >= 16);
+
+	content_preserved = true;
+	for (int64 i = 0; i < 16; ++i)
+		content_preserved &= (memory.mPtr[i] == (uint8)i);
+	TEST_TRUE(content_preserved);
+
+	gMemFree(memory);
+};
+
+
+#ifdef BEDROCK_ENABLE_SIZE_CLASS_HEAP
+
+REGISTER_TEST("MemAlloc SizeClassHeap")
+{
+	// Small allocations come from the size-class heap, their usable size is the size of their class.
+	MemBlock memory = gMemAllocAtLeast(20);
+	TEST_TRUE(memory.mSize == gSizeClassHeapGetUsableSize(20));
+	memory.mPtr[0] = 42;
+
+	// Reallocating between size classes copies the content.
+	memory = gMemRealloc(memory, 1000);
+	TEST_TRUE(memory.mSize == gSizeClassHeapGetUsableSize(1000));
+	TEST_TRUE(memory.mPtr[0] == 42);
+
+	gMemFree(memory);
+};
+
+#endif
@@ -13,20 +13,58 @@ struct MemBlock
 
 
 // Heap
+// Uses malloc/free by default, or the size-class heap (see SizeClassHeap.h) if BEDROCK_ENABLE_SIZE_CLASS_HEAP is defined.
+
+constexpr int cMemDefaultAlignment = 16; // Alignment of the memory returned by gMemAlloc.
 
 MemBlock gMemAlloc(int64 inSize);     // Allocate heap memory.
-void     gMemFree(MemBlock inMemory); // Free heap memory.
+void     gMemFree(MemBlock inMemory); // Free heap memory. inMemory.mSize must be the size that was passed to gMemAlloc (or returned by gMemAllocAtLeast/gMemRealloc).
+
+MemBlock gMemAllocAtLeast(int64 inSize, int inSizeGranularity = 1);
+									  // Allocate at least inSize bytes of heap memory. The returned mSize is the usable size of the
+									  // allocation, rounded down to a multiple of inSizeGranularity (eg. an element size). It must be
+									  // passed to gMemFree or gMemRealloc.
+MemBlock gMemRealloc(MemBlock inMemory, int64 inNewSize, int inSizeGranularity = 1);
+									  // Resize heap memory, growing it in place if possible, otherwise moving it (the content is copied
+									  // bytewise, or pages are remapped). The returned mSize is the usable size, like gMemAllocAtLeast.
+									  // On failure, return a nullptr MemBlock and inMemory stays valid.
+
+MemBlock gMemAllocAligned(int64 inSize, int inAlignment);     // Allocate heap memory aligned to inAlignment (a power of 2).
+															  // Same as gMemAlloc if inAlignment <= cMemDefaultAlignment, otherwise
+															  // over-allocates by inAlignment bytes.
+void     gMemFreeAligned(MemBlock inMemory, int inAlignment); // Free memory allocated with gMemAllocAligned, with the same size and alignment.
 
 
 // Virtual Memory
 
-int      gVMemReserveGranularity();      // Return the granularity at which memory can be reserved.
-int      gVMemCommitGranularity();       // Return the granularity at which memory can be committed.
-MemBlock gVMemReserve(int64 inSize);     // Reserve some memory. inSize will be rounded up to reserve granularity.
-void     gVMemFree(MemBlock inMemory);   // Free previously reserved memory.
-MemBlock gVMemCommit(MemBlock inMemory); // Commit some reserved memory.
-										 // On success, return the committed MemBlock (inMemory rounded up/down to commit granularity).
-										 // On failure, return a nullptr MemBlock.
+enum class EVMemPageSize : int8
+{
+	Normal, // Regular pages (usually 4 KiB).
+	Large,  // Large pages (usually 2 MiB), to reduce TLB misses. Falls back to regular pages if the OS doesn't support them.
+};
+
+int      gVMemReserveGranularity();        // Return the granularity at which memory can be reserved.
+int      gVMemCommitGranularity();         // Return the granularity at which memory can be committed.
+int      gVMemLargePageSize();             // Return the size of large pages, or 0 if large pages are not available.
+MemBlock gVMemReserve(int64 inSize, EVMemPageSize inPageSize = EVMemPageSize::Normal);
+										   // Reserve some memory. inSize will be rounded up to reserve granularity.
+										   // With large pages, inSize and the returned pointer are aligned to the large page size. Committed
+										   // memory will be backed by large pages when possible, as long as it is committed by large page
+										   // sized blocks.
+void     gVMemFree(MemBlock inMemory);     // Free previously reserved memory.
+MemBlock gVMemCommit(MemBlock inMemory);   // Commit some reserved memory.
+										   // On success, return the committed MemBlock (inMemory rounded up/down to commit granularity).
+										   // On failure, return a nullptr MemBlock.
+MemBlock gVMemDecommit(MemBlock inMemory); // Decommit some committed memory and give the physical pages back to the OS. The memory stays reserved.
+										   // Only the pages entirely inside inMemory are decommitted (inMemory rounded down/up to commit granularity).
+										   // Return the decommitted MemBlock, or a nullptr MemBlock if inMemory didn't contain any whole page.
+
+namespace Details
+{
+	// Make gVMemLargePageSize return inLargePageSize instead of the real size (0 to stop overriding).
+	// Only meant for tests, to exercise the large page code paths on machines that don't have large pages (eg. Windows).
+	void SetVMemLargePageSizeOverride(int inLargePageSize);
+}
 
 
 
@@ -41,3 +41,275 @@ REGISTER_TEST("MemArena")
 	TEST_TRUE(arena.GetAllocatedSize() == 0);
 	TEST_TRUE(arena.GetNumPendingFree() == 0);
 };
+
+
+REGISTER_TEST("VMemArena Trim")
+{
+	int page_size = gVMemCommitGranularity();
+	VMemArena<> arena(1_MiB, page_size, page_size * 4);
+
+	// Grow the arena.
+	MemBlock b1 = arena.Alloc(page_size * 8);
+	MemBlock b2 = arena.Alloc(page_size);
+	TEST_TRUE(arena.GetCommittedSize() >= page_size * 9);
+
+	// Freeing a small block doesn't decommit anything (below the threshold).
+	int committed_size = arena.GetCommittedSize();
+	arena.Free(b2);
+	TEST_TRUE(arena.GetCommittedSize() == committed_size);
+
+	// Freeing a large block decommits everything except the commit increase size.
+	arena.Free(b1);
+	TEST_TRUE(arena.GetAllocatedSize() == 0);
+	TEST_TRUE(arena.GetCommittedSize() == page_size);
+
+	// Memory can be committed again.
+	b1 = arena.Alloc(page_size * 8);
+	b1.mPtr[b1.mSize - 1] = 1;
+	TEST_TRUE(arena.GetCommittedSize() >= page_size * 8);
+
+	// Shrinking the last allocation also trims.
+	TEST_TRUE(arena.TryRealloc(b1, 1));
+	TEST_TRUE(arena.GetCommittedSize() == page_size * 2);
+
+	// Explicit trim.
+	arena.Trim();
+	TEST_TRUE(arena.GetCommittedSize() == page_size); // The first page is still used.
+	arena.Free(b1);
+	arena.Trim();
+	TEST_TRUE(arena.GetCommittedSize() == 0);
+
+	// Automatic trimming can be disabled.
+	VMemArena<> no_trim_arena(1_MiB, page_size, VMemArena<>::cNoTrim);
+	no_trim_arena.Free(no_trim_arena.Alloc(page_size * 8));
+	TEST_TRUE(no_trim_arena.GetCommittedSize() >= page_size * 8);
+};
+
+
+REGISTER_TEST("VMemArena Large Pages")
+{
+	VMemArena<> arena(8_MiB, 64_KiB, VMemArena<>::cDefaultTrimThreshold, EVMemPageSize::Large);
+
+	// Large pages might not be available, in which case the arena falls back to regular pages.
+	int large_page_size = gVMemLargePageSize();
+	if (large_page_size == 0)
+		TEST_TRUE(arena.GetPageSize() == EVMemPageSize::Normal);
+	else
+		TEST_TRUE(arena.GetPageSize() == EVMemPageSize::Large);
+
+	int commit_granularity = (arena.GetPageSize() == EVMemPageSize::Large) ? large_page_size : gVMemCommitGranularity();
+
+	MemBlock b1 = arena.Alloc(100);
+	TEST_TRUE(((int64)b1.mPtr % commit_granularity) == 0);
+	TEST_TRUE((arena.GetCommittedSize() % commit_granularity) == 0);
+	b1.mPtr[0] = 1;
+
+	MemBlock b2 = arena.Alloc(commit_granularity);
+	TEST_TRUE((arena.GetCommittedSize() % commit_granularity) == 0);
+	TEST_TRUE(arena.GetCommittedSize() >= commit_granularity + 100);
+	b2.mPtr[b2.mSize - 1] = 1;
+
+	arena.Free(b2);
+	arena.Free(b1);
+	arena.Trim();
+	TEST_TRUE(arena.GetCommittedSize() == 0);
+};
+
+
+REGISTER_TEST("VMemArena Fake Large Pages")
+{
+	// Large pages are often not available (and never on Windows), fake them to make sure commits and decommits are rounded to their size.
+	int page_size       = gVMemCommitGranularity();
+	int large_page_size = page_size * 16;
+	Details::SetVMemLargePageSizeOverride(large_page_size);
+	defer { Details::SetVMemLargePageSizeOverride(0); };
+
+	VMemArena<> arena(large_page_size * 8, page_size, VMemArena<>::cNoTrim, EVMemPageSize::Large);
+	TEST_TRUE(arena.GetPageSize() == EVMemPageSize::Large);
+
+	// The commit increase size is rounded up to a large page.
+	MemBlock b1 = arena.Alloc(100);
+	TEST_TRUE(arena.GetCommittedSize() == large_page_size);
+	b1.mPtr[0] = 1;
+
+	// Going over by a few bytes commits another whole large page.
+	MemBlock b2 = arena.Alloc(large_page_size);
+	TEST_TRUE(arena.GetCommittedSize() == large_page_size * 2);
+	b2.mPtr[b2.mSize - 1] = 1;
+
+	// Trimming keeps the large page that is still partially used.
+	arena.Free(b2);
+	arena.Trim();
+	TEST_TRUE(arena.GetCommittedSize() == large_page_size);
+
+	// The size to keep committed is rounded up to a large page as well.
+	arena.Trim(1);
+	TEST_TRUE(arena.GetCommittedSize() == large_page_size);
+
+	arena.Free(b1);
+	arena.Trim(1);
+	TEST_TRUE(arena.GetCommittedSize() == large_page_size);
+	arena.Trim();
+	TEST_TRUE(arena.GetCommittedSize() == 0);
+};
+
+
+REGISTER_TEST("MemArena Rewind")
+{
+	alignas(MemArena<>::cAlignment) uint8 buffer[MemArena<>::cAlignment * 8];
+	MemArena<2> arena({ buffer, sizeof(buffer) });
+
+	MemBlock b1 = arena.Alloc(1);
+	MemBlock b2 = arena.Alloc(1);
+
+	MemArena<2>::Marker marker = arena.GetMarker();
+
+	MemBlock b3 = arena.Alloc(1);
+	MemBlock b4 = arena.Alloc(1);
+	arena.Alloc(1);
+
+	// Pending frees on both sides of the marker, merged into a single block.
+	arena.Free(b2);
+	arena.Free(b3);
+	arena.Free(b4);
+	TEST_TRUE(arena.GetNumPendingFree() == 1);
+
+	// Rewinding frees everything after the marker, and the pending free just before it.
+	arena.Rewind(marker);
+	TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	// Rewinding again does nothing.
+	arena.Rewind(marker);
+	TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment);
+
+	arena.Free(b1);
+	TEST_TRUE(arena.GetAllocatedSize() == 0);
+};
+
+
+REGISTER_TEST("MemArena Scope")
+{
+	alignas(MemArena<>::cAlignment) uint8 buffer[MemArena<>::cAlignment * 8];
+	MemArena<0> arena({ buffer, sizeof(buffer) }); // No pending frees supported at all.
+
+	MemBlock b1 = arena.Alloc(1);
+
+	{
+		MemArenaScope scope(arena);
+
+		MemBlock b2 = arena.Alloc(1);
+		MemBlock b3 = arena.Alloc(1);
+
+		{
+			MemArenaScope inner_scope(arena);
+
+			// Out of order frees are fine inside a scope.
+			MemBlock b4 = arena.Alloc(1);
+			arena.Alloc(1);
+			arena.Free(b4);
+			arena.Free(b2);
+			TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment * 5);
+		}
+
+		TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment * 3);
+
+		// In order frees still free immediately.
+		arena.Free(b3);
+		TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment * 2);
+	}
+
+	TEST_TRUE(arena.GetAllocatedSize() == MemArena<>::cAlignment);
+	arena.Free(b1);
+	TEST_TRUE(arena.GetAllocatedSize() == 0);
+};
+
+
+REGISTER_TEST("MemArena Alignment")
+{
+	alignas(64) uint8 buffer[512];
+	MemArena arena({ buffer, sizeof(buffer) });
+
+	// No padding with the default alignment.
+	MemBlock b1 = arena.Alloc(1);
+	MemBlock b2 = arena.Alloc(1, 8);
+	TEST_TRUE(b2.mPtr == b1.mPtr + MemArena<>::cAlignment);
+
+	// Larger alignment adds padding, its size is stored just before the allocation.
+	MemBlock b3 = arena.Alloc(1, 64);
+	TEST_TRUE(((uint64)b3.mPtr % 64) == 0);
+	TEST_TRUE(b3.mPtr == buffer + 64);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	MemBlock b4 = arena.Alloc(64, 64);
+	TEST_TRUE(b4.mPtr == buffer + 128);
+
+	// Freeing in order also frees the padding.
+	arena.Free(b4, 64);
+	arena.Free(b3, 64);
+	TEST_TRUE(arena.GetAllocatedSize() == 32);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	// Freeing out of order tracks the padding along with the allocation.
+	b3 = arena.Alloc(1, 64);
+	b4 = arena.Alloc(64, 64);
+	arena.Free(b3, 64);
+	TEST_TRUE(arena.GetNumPendingFree() == 1);
+	arena.Free(b4, 64);
+	TEST_TRUE(arena.GetAllocatedSize() == 32);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	// Inside a scope, the padding is freed when the scope ends.
+	{
+		MemArenaScope scope(arena);
+		TEST_TRUE(((uint64)arena.Alloc(1, 256).mPtr % 256) == 0);
+		TEST_TRUE(arena.GetNumPendingFree() == 0);
+	}
+	TEST_TRUE(arena.GetAllocatedSize() == 32);
+
+	// Arenas that don't support out of order frees can pad as well. An allocation at the beginning doesn't need any padding.
+	MemArena<0> arena0({ buffer + 256, 256 });
+	MemBlock    b5 = arena0.Alloc(1, 64);
+	TEST_TRUE(b5.mPtr == buffer + 256);
+	MemBlock    b6 = arena0.Alloc(1, 64);
+	TEST_TRUE(b6.mPtr == buffer + 256 + 64);
+	arena0.Free(b6, 64);
+	arena0.Free(b5, 64);
+	TEST_TRUE(arena0.GetAllocatedSize() == 0);
+
+	arena.Free(b2);
+	arena.Free(b1);
+};
+
+
+REGISTER_TEST("MemArena Many Aligned Allocs")
+{
+	// The padding isn't a pending free, there can be more over-aligned allocations alive than cDefaultMaxPendingFrees.
+	alignas(64) uint8 buffer[64 * 64];
+	MemArena<> arena({ buffer, sizeof(buffer) });
+
+	MemBlock blocks[cDefaultMaxPendingFrees * 2 + 8];
+	for (MemBlock& block : blocks)
+	{
+		block = arena.Alloc(16, 64);
+		TEST_TRUE(block != nullptr);
+		TEST_TRUE(((uint64)block.mPtr % 64) == 0);
+	}
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	// Free the second half in order.
+	constexpr int cHalf = (int)gElemCount(blocks) / 2;
+	for (int i = (int)gElemCount(blocks) - 1; i >= cHalf; --i)
+		arena.Free(blocks[i], 64);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+
+	// Free the first half out of order.
+	for (int i = 0; i < cHalf; i += 2)
+		arena.Free(blocks[i], 64);
+	TEST_TRUE(arena.GetNumPendingFree() == cHalf / 2);
+
+	for (int i = cHalf - 1; i >= 0; i -= 2)
+		arena.Free(blocks[i], 64);
+	TEST_TRUE(arena.GetNumPendingFree() == 0);
+	TEST_TRUE(arena.GetAllocatedSize() == 0);
+};
@@ -3,6 +3,7 @@
 
 #include <Bedrock/Core.h>
 #include <Bedrock/Memory.h>
+#include <Bedrock/MemoryStats.h>
 
 namespace Details
 {
@@ -18,6 +19,7 @@ namespace Details
 	{
 		no_inline    void AddPendingFree(FreeBlock inFreeBlock);
 		no_inline    void TryRemovePendingFree(int& ioCurrentOffset);
+		no_inline    void RemovePendingFreesAfter(int inOffset);
 		force_inline int  GetNumPendingFree() const { return mCount; }
 
 		int       mCount = 0;				
@@ -29,6 +31,7 @@ namespace Details
 	{
 		force_inline static void AddPendingFree(FreeBlock inFreeBlock)		{ CRASH; }
 		force_inline static void TryRemovePendingFree(int& ioCurrentOffset)	{}
+		force_inline static void RemovePendingFreesAfter(int inOffset)		{}
 		force_inline static int  GetNumPendingFree()						{ return 0; }
 	}; 
 }
@@ -64,11 +67,13 @@ struct MemArena : Details::PendingFreeArray<taMaxPendingFrees>
 		mBeginPtr        = ioOther.mBeginPtr;
 		mEndOffset       = ioOther.mEndOffset;
 		mCurrentOffset   = ioOther.mCurrentOffset;
+		mScopeOffset     = ioOther.mScopeOffset;
 		Base::operator=((Base&&)ioOther);
 
 		ioOther.mBeginPtr        = nullptr;
 		ioOther.mEndOffset       = 0;
 		ioOther.mCurrentOffset   = 0;
+		ioOther.mScopeOffset     = cMaxInt;
 		ioOther.Base::operator=({});
 
 		return *this;
@@ -92,24 +97,34 @@ struct MemArena : Details::PendingFreeArray<taMaxPendingFrees>
 		return { mBeginPtr, mEndOffset };
 	}
 
-	// Allocate memory.
-	MemBlock Alloc(int inSize)
+	// Allocate memory. Allocations are aligned to cAlignment, or to inAlignment if it is larger.
+	// A larger alignment may need some padding before the allocation. The size of the padding is stored just before the allocation
+	// so that Free can give it back, which means the same alignment must be passed to Free.
+	MemBlock Alloc(int inSize, int inAlignment = cAlignment)
 	{
 		gAssert(mBeginPtr != nullptr); // Need to initialize with a MemBlock first.
+		gAssert(gIsPow2(inAlignment));
 
 		int aligned_size   = (int)gAlignUp(inSize, cAlignment);
 		int current_offset = mCurrentOffset;
 
+		if (inAlignment > cAlignment) [[unlikely]]
+			current_offset = GetOverAlignedOffset(current_offset, inAlignment);
+
 		if (current_offset + aligned_size > mEndOffset)
 			return {}; // Allocation failed.
 
-		mCurrentOffset += aligned_size;
+		if (current_offset != mCurrentOffset) [[unlikely]]
+			GetPaddingSize(mBeginPtr + current_offset) = current_offset - mCurrentOffset;
+
+		mCurrentOffset = current_offset + aligned_size;
 
 		return { mBeginPtr + current_offset, inSize };
 	}
 
 	// Free memory. inMemory should be the last allocation, or the arena should support enough out-of-order frees.
-	void Free(MemBlock inMemory)
+	// inAlignment must be the alignment passed to Alloc.
+	void Free(MemBlock inMemory, int inAlignment = cAlignment)
 	{
 		gAssert(inMemory.mPtr != nullptr);
 		gAssert(inMemory.mSize > 0);
@@ -118,6 +133,10 @@ struct MemArena : Details::PendingFreeArray<taMaxPendingFrees>
 		int aligned_size = (int)gAlignUp(inMemory.mSize, cAlignment);
 		int end_offset   = (int)(inMemory.mPtr + aligned_size - mBeginPtr);
 
+		// Free the padding before the allocation along with it (see Alloc).
+		if (inAlignment > cAlignment && inMemory.mPtr != mBeginPtr) [[unlikely]]
+			aligned_size += GetPaddingSize(inMemory.mPtr);
+
 		// If it's the last alloc, free immediately.
 		if (end_offset == mCurrentOffset) [[likely]]
 		{
@@ -127,11 +146,13 @@ struct MemArena : Details::PendingFreeArray<taMaxPendingFrees>
 			if (GetNumPendingFree() > 0) [[unlikely]]
 				TryRemovePendingFree(mCurrentOffset);
 		}
-		else
+		else if (end_offset - aligned_size < mScopeOffset)
 		{
 			// Otherwise add it to the list of pending frees.
 			AddPendingFree({ end_offset, aligned_size });
 		}
+
+		// Otherwise it was allocated inside a scope and will be freed when the scope ends, no need to keep track of it.
 	}
 
 	// Try resizing ioMemory. Return true on success. Can fail if ioMemory isn't the last block or not enough free memory for inNewSize.
@@ -172,24 +193,115 @@ struct MemArena : Details::PendingFreeArray<taMaxPendingFrees>
 		return mCurrentOffset;
 	}
 
+	// Position in the arena that can be rewound to.
+	struct Marker
+	{
+		int mOffset          = 0;
+		int mPrevScopeOffset = cMaxInt;
+	};
+
+	// Return a marker of the current position in the arena.
+	Marker GetMarker() const
+	{
+		return { mCurrentOffset, mScopeOffset };
+	}
+
+	// Free everything allocated after inMarker at once, including pending frees.
+	// The allocations made after inMarker must not be used (or freed) anymore.
+	void Rewind(Marker inMarker)
+	{
+		if (inMarker.mOffset >= mCurrentOffset)
+			return; // Nothing allocated after the marker, or it was already freed.
+
+		mCurrentOffset = inMarker.mOffset;
+
+		// Forget the pending frees that were rewound. The one just before the marker might be freeable now.
+		if (GetNumPendingFree() > 0) [[unlikely]]
+		{
+			RemovePendingFreesAfter(mCurrentOffset);
+			TryRemovePendingFree(mCurrentOffset);
+		}
+	}
+
+	// Begin a scope. When the scope ends, everything allocated inside it is freed at once (see Rewind).
+	// Inside a scope, out of order frees of memory allocated in the scope are free: they don't need to be tracked, which means they
+	// don't count towards taMaxPendingFrees. Scopes can be nested but must end in reverse order. Prefer using MemArenaScope.
+	Marker BeginScope()
+	{
+		Marker marker = GetMarker();
+		mScopeOffset  = gMin(mScopeOffset, mCurrentOffset);
+		return marker;
+	}
+
+	// End a scope. inMarker is the value returned by the matching BeginScope.
+	void EndScope(Marker inMarker)
+	{
+		Rewind(inMarker);
+		mScopeOffset = inMarker.mPrevScopeOffset;
+	}
+
 	using Base::GetNumPendingFree;
 
 protected:
+	// Return the first offset at or after inOffset which is aligned to inAlignment in memory.
+	int GetAlignedOffset(int inOffset, int inAlignment) const
+	{
+		return (int)(gAlignUp((uint64)(mBeginPtr + inOffset), (uint64)inAlignment) - (uint64)mBeginPtr);
+	}
+
+	// Return the offset of an allocation made at inOffset with an alignment larger than cAlignment.
+	// The allocation is moved forward if needed so that the padding is at least cAlignment bytes, and there is room to store its size.
+	// Only an allocation at the beginning of the arena can have no padding at all.
+	int GetOverAlignedOffset(int inOffset, int inAlignment) const
+	{
+		int aligned_offset = GetAlignedOffset(inOffset, inAlignment);
+
+		if (aligned_offset == inOffset && inOffset != 0)
+			aligned_offset += inAlignment;
+
+		return aligned_offset;
+	}
+
+	// Return the size of the padding before an over-aligned allocation (see Alloc).
+	static int& GetPaddingSize(uint8* inAllocPtr) { return ((int*)inAllocPtr)[-1]; }
+
 	uint8* mBeginPtr      = nullptr;
 	int    mEndOffset     = 0;
 	int    mCurrentOffset = 0;
+	int    mScopeOffset   = cMaxInt; // Offset of the outermost active scope (cMaxInt if there are none).
 	
 	using Base::AddPendingFree;
 	using Base::TryRemovePendingFree;
+	using Base::RemovePendingFreesAfter;
+};
+
+
+// Helper to begin/end a scope in a MemArena.
+// Containers allocating from the arena inside the scope must be destroyed before the scope ends (ie. declared after it),
+// and containers declared before the scope must not allocate inside it.
+template <typename taMemArena>
+struct MemArenaScope : NoCopy
+{
+	MemArenaScope(taMemArena& ioArena) : mArena(&ioArena), mMarker(ioArena.BeginScope()) {}
+	~MemArenaScope() { mArena->EndScope(mMarker); }
+
+private:
+	using Marker = typename taMemArena::Marker;
+
+	taMemArena* mArena;
+	Marker      mMarker;
 };
 
 
 // Version of MemArena that embeds a fixed-size buffer and allocates from it.
-template <int taSize, int taMaxPendingFrees = cDefaultMaxPendingFrees>
+// The buffer is aligned to taBufferAlignment, so that the first allocation doesn't need padding if it uses that alignment.
+template <int taSize, int taMaxPendingFrees = cDefaultMaxPendingFrees, int taBufferAlignment = MemArena<>::cAlignment>
 struct FixedMemArena : MemArena<taMaxPendingFrees>
 {
 	using Base = MemArena<taMaxPendingFrees>;
 
+	static_assert(taBufferAlignment >= Base::cAlignment && gIsPow2(taBufferAlignment));
+
 	FixedMemArena() : Base({ mBuffer, (int64)taSize }) {}
 	~FixedMemArena() { gAssert(Base::GetAllocatedSize() == 0); }
 
@@ -198,7 +310,7 @@ struct FixedMemArena : MemArena<taMaxPendingFrees>
 	FixedMemArena& operator=(FixedMemArena&&) = delete;
 
 private:
-	alignas(Base::cAlignment) uint8 mBuffer[taSize];
+	alignas(taBufferAlignment) uint8 mBuffer[taSize];
 };
 
 
@@ -208,25 +320,40 @@ struct VMemArena : MemArena<taMaxPendingFrees>
 {
 	using Base = MemArena<taMaxPendingFrees>;
 
-	static constexpr int64 cDefaultReservedSize = 100_MiB; // By default the arena will reserve that much virtual memory.
-	static constexpr int64 cDefaultCommitSize   =  64_KiB; // By default the arena will commit that much virtual memory every time it grows.
+	static constexpr int64 cDefaultReservedSize  = 100_MiB; // By default the arena will reserve that much virtual memory.
+	static constexpr int64 cDefaultCommitSize    =  64_KiB; // By default the arena will commit that much virtual memory every time it grows.
+	static constexpr int64 cDefaultTrimThreshold =   1_MiB; // By default the arena will decommit memory when more than that is committed but unused.
+	static constexpr int64 cNoTrim               = cMaxInt; // Pass as trim threshold to disable automatic trimming (Trim can still be called manually).
 
 	VMemArena() = default;
 	~VMemArena() { FreeReserved(); }
 
 	// Initialize this arena with reserved memory (but no committed memory yet). 
-	VMemArena(int64 inReservedSize, int64 inCommitIncreaseSize)
+	// When more than inTrimThreshold bytes are committed but unused after a Free, the unused memory is decommitted (except for
+	// inCommitIncreaseSize bytes, to avoid committing/decommitting the same pages over and over).
+	// With large pages, memory is committed and decommitted by multiples of the large page size (see gVMemLargePageSize).
+	VMemArena(int64 inReservedSize, int64 inCommitIncreaseSize, int64 inTrimThreshold = cDefaultTrimThreshold, EVMemPageSize inPageSize = EVMemPageSize::Normal)
 	{
 		// Replace parameters by defaults if necessary.
 		if (inReservedSize <= 0)
 			inReservedSize = cDefaultReservedSize;
 		if (inCommitIncreaseSize <= 0)
 			inCommitIncreaseSize = cDefaultCommitSize;
+		if (inTrimThreshold <= 0)
+			inTrimThreshold = cDefaultTrimThreshold;
+
+		// Large pages fall back to regular pages if they're not available.
+		if (inPageSize == EVMemPageSize::Large && gVMemLargePageSize() == 0)
+			inPageSize = EVMemPageSize::Normal;
 
-		mCommitIncreaseSize = (int)gAlignUp(inCommitIncreaseSize, gVMemCommitGranularity());
+		mPageSize           = inPageSize;
+		mCommitGranularity  = (inPageSize == EVMemPageSize::Large) ? gVMemLargePageSize() : gVMemCommitGranularity();
+		mCommitIncreaseSize = (int)gAlignUp(inCommitIncreaseSize, mCommitGranularity);
+		mTrimThreshold      = (int)gMin(inTrimThreshold, (int64)cMaxInt);
+		mTrimThreshold      = gMax(mTrimThreshold, mCommitIncreaseSize); // Trimming below the commit increase size would only cause extra commits.
 
 		// Reserve the memory.
-		MemBlock reserved_mem = gVMemReserve(inReservedSize);
+		MemBlock reserved_mem = gVMemReserve(inReservedSize, inPageSize);
 		mEndReservedOffset    = (int)reserved_mem.mSize;
 
 		// Initialize the parent MemArena with a zero-sized block (no memory is committed yet).
@@ -242,13 +369,19 @@ struct VMemArena : MemArena<taMaxPendingFrees>
 
 		mCommitIncreaseSize         = ioOther.mCommitIncreaseSize;
 		mEndReservedOffset          = ioOther.mEndReservedOffset;
+		mTrimThreshold              = ioOther.mTrimThreshold;
+		mCommitGranularity          = ioOther.mCommitGranularity;
+		mPageSize                   = ioOther.mPageSize;
 		ioOther.mEndReservedOffset  = 0;
 		ioOther.mCommitIncreaseSize = 0;
+		ioOther.mTrimThreshold      = 0;
+		ioOther.mCommitGranularity  = 0;
+		ioOther.mPageSize           = EVMemPageSize::Normal;
 
 		return *this;
 	}
 
-	MemBlock Alloc(int inSize)
+	MemBlock Alloc(int inSize, int inAlignment = cAlignment)
 	{
 		// If the arena wasn't initialized yet, do it now (with default values).
 		// It's better to do it lazily than reserving virtual memory in every container default constructor.
@@ -258,11 +391,14 @@ struct VMemArena : MemArena<taMaxPendingFrees>
 		int aligned_size       = (int)gAlignUp(inSize, cAlignment);
 		int new_current_offset = mCurrentOffset + aligned_size;
 
+		if (inAlignment > cAlignment) [[unlikely]]
+			new_current_offset = Base::GetOverAlignedOffset(mCurrentOffset, inAlignment) + aligned_size;
+
 		// Check if we need to commit more memory.
 		if (new_current_offset > mEndOffset) [[unlikely]]
 			CommitMore(new_current_offset);
 
-		return Base::Alloc(inSize);
+		return Base::Alloc(inSize, inAlignment);
 	}
 
 	bool TryRealloc(MemBlock& ioMemory, int inNewSize)
@@ -277,10 +413,45 @@ struct VMemArena : MemArena<taMaxPendingFrees>
 		if (new_current_offset > mEndOffset) [[unlikely]]
 			CommitMore(new_current_offset);
 
-		return Base::TryRealloc(ioMemory, inNewSize);
+		if (!Base::TryRealloc(ioMemory, inNewSize)) [[unlikely]]
+			return false;
+
+		// If the allocation shrunk, check if we should give some memory back.
+		TryTrim();
+
+		return true;
+	}
+
+	void Free(MemBlock inMemory, int inAlignment = cAlignment)
+	{
+		Base::Free(inMemory, inAlignment);
+
+		// Check if we should give some memory back.
+		TryTrim();
+	}
+
+	void Rewind(typename Base::Marker inMarker)
+	{
+		Base::Rewind(inMarker);
+
+		// Check if we should give some memory back.
+		TryTrim();
+	}
+
+	void EndScope(typename Base::Marker inMarker)
+	{
+		Base::EndScope(inMarker);
+
+		// Check if we should give some memory back.
+		TryTrim();
 	}
 
-	int GetReservedSize() const { return mEndReservedOffset; }
+	// Decommit the memory past the current allocations, except for inKeepCommittedSize bytes.
+	void Trim(int inKeepCommittedSize = 0);
+
+	int           GetReservedSize() const  { return mEndReservedOffset; }
+	int           GetCommittedSize() const { return mEndOffset; }
+	EVMemPageSize GetPageSize() const      { return mPageSize; } // Note: Normal if large pages were requested but not available.
 
 	using Base::IsLastAlloc;
 	using Base::cAlignment;
@@ -289,12 +460,21 @@ private:
 	void CommitMore(int inNewEndOffset);
 	void FreeReserved();
 
+	force_inline void TryTrim()
+	{
+		if (mEndOffset - mCurrentOffset > mTrimThreshold) [[unlikely]]
+			Trim(mCommitIncreaseSize);
+	}
+
 	using Base::mBeginPtr;
 	using Base::mCurrentOffset;
 	using Base::mEndOffset;
 
-	int mEndReservedOffset  = 0;
-	int mCommitIncreaseSize = 64_KiB;
+	int           mEndReservedOffset  = 0;
+	int           mCommitIncreaseSize = 64_KiB;
+	int           mTrimThreshold      = 1_MiB;
+	int           mCommitGranularity  = 0;
+	EVMemPageSize mPageSize           = EVMemPageSize::Normal;
 };
 
 
@@ -380,20 +560,70 @@ void Details::PendingFreeArray<taSize>::TryRemovePendingFree(int& ioCurrentOffse
 }
 
 
+template <int taSize>
+void Details::PendingFreeArray<taSize>::RemovePendingFreesAfter(int inOffset)
+{
+	// Pending blocks are sorted, so the ones after inOffset are at the back.
+	while (mCount > 0 && mBlocks[mCount - 1].BeginOffset() >= inOffset)
+		mCount--;
+
+	// The last one might straddle inOffset, cut it.
+	if (mCount > 0 && mBlocks[mCount - 1].mEndOffset > inOffset)
+	{
+		mBlocks[mCount - 1].mSize      -= mBlocks[mCount - 1].mEndOffset - inOffset;
+		mBlocks[mCount - 1].mEndOffset  = inOffset;
+	}
+}
+
+
 template <int taMaxPendingFrees>
 void VMemArena<taMaxPendingFrees>::CommitMore(int inNewEndOffset)
 {
 	gAssert(inNewEndOffset > mEndOffset);
 
-	int64    commit_size   = gMax(mCommitIncreaseSize, (inNewEndOffset - mEndOffset));
-	MemBlock committed_mem = gVMemCommit({ mBeginPtr + mEndOffset, commit_size });
+	// If it doesn't fit in the reserved memory, don't commit anything and let the allocation fail.
+	if (inNewEndOffset > mEndReservedOffset) [[unlikely]]
+		return;
+
+	int64 commit_size    = gMax(mCommitIncreaseSize, (inNewEndOffset - mEndOffset));
+	int64 new_end_offset = gAlignUp(mEndOffset + commit_size, (int64)mCommitGranularity);
+
+	// Don't go past the reserved memory because of the alignment.
+	new_end_offset = gMax((int64)inNewEndOffset, gMin(new_end_offset, (int64)mEndReservedOffset));
+
+	MemBlock committed_mem = gVMemCommit({ mBeginPtr + mEndOffset, new_end_offset - mEndOffset });
+	if (committed_mem == nullptr) [[unlikely]]
+		return;
+
+	int previous_end_offset = mEndOffset;
+	mEndOffset              = (int)(committed_mem.mPtr + committed_mem.mSize - mBeginPtr);
 
-	mEndOffset = (int)(committed_mem.mPtr + committed_mem.mSize - mBeginPtr);
+	gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(mEndOffset - previous_end_offset);
 }
 
+template <int taMaxPendingFrees>
+void VMemArena<taMaxPendingFrees>::Trim(int inKeepCommittedSize)
+{
+	gAssert(inKeepCommittedSize >= 0);
+
+	int64 new_end_offset = gAlignUp((int64)mCurrentOffset + inKeepCommittedSize, (int64)mCommitGranularity);
+
+	if (new_end_offset >= mEndOffset)
+		return; // Nothing to decommit.
+
+	gVMemDecommit({ mBeginPtr + new_end_offset, mEndOffset - new_end_offset });
+	gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(new_end_offset - mEndOffset);
+
+	mEndOffset = (int)new_end_offset;
+}
+
+
 template <int taMaxPendingFrees>
 void VMemArena<taMaxPendingFrees>::FreeReserved()
 {
 	if (mBeginPtr != nullptr)
+	{
 		gVMemFree({ mBeginPtr, mEndReservedOffset });
+		gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(-mEndOffset);
+	}
 }
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/MemoryPool.h>
+#include <Bedrock/Test.h>
+
+
+MemPool::MemPool(int inBlockSize, int64 inReservedSize, int64 inCommitIncreaseSize)
+{
+	gAssert(inBlockSize > 0);
+
+	// Replace parameters by defaults if necessary.
+	if (inReservedSize <= 0)
+		inReservedSize = cDefaultReservedSize;
+	if (inCommitIncreaseSize <= 0)
+		inCommitIncreaseSize = cDefaultCommitSize;
+
+	mBlockSize          = (int)gAlignUp(gMax(inBlockSize, (int)sizeof(FreeNode)), cAlignment);
+	mCommitIncreaseSize = (int)gAlignUp(gMax(inCommitIncreaseSize, (int64)mBlockSize), (int64)gVMemCommitGranularity());
+	mOwnerThreadID      = gGetCurrentThreadID();
+
+	// Reserve the memory.
+	MemBlock reserved_mem = gVMemReserve(inReservedSize);
+	mBeginPtr             = reserved_mem.mPtr;
+	mCurrentPtr           = reserved_mem.mPtr;
+	mEndCommittedPtr      = reserved_mem.mPtr;
+	mEndReservedPtr       = reserved_mem.mPtr + reserved_mem.mSize;
+}
+
+
+MemPool& MemPool::operator=(MemPool&& ioOther)
+{
+	FreeReserved();
+
+	mFreeList           = ioOther.mFreeList;
+	mNumAllocatedBlocks = ioOther.mNumAllocatedBlocks;
+	mBeginPtr           = ioOther.mBeginPtr;
+	mCurrentPtr         = ioOther.mCurrentPtr;
+	mEndCommittedPtr    = ioOther.mEndCommittedPtr;
+	mEndReservedPtr     = ioOther.mEndReservedPtr;
+	mBlockSize          = ioOther.mBlockSize;
+	mCommitIncreaseSize = ioOther.mCommitIncreaseSize;
+	mOwnerThreadID      = ioOther.mOwnerThreadID;
+	mRemoteFreeList.Store(ioOther.mRemoteFreeList.Exchange(nullptr));
+	mNumRemoteFreedBlocks.Store(ioOther.mNumRemoteFreedBlocks.Exchange(0));
+
+	ioOther.mFreeList           = nullptr;
+	ioOther.mNumAllocatedBlocks = 0;
+	ioOther.mBeginPtr           = nullptr;
+	ioOther.mCurrentPtr         = nullptr;
+	ioOther.mEndCommittedPtr    = nullptr;
+	ioOther.mEndReservedPtr     = nullptr;
+	ioOther.mBlockSize          = 0;
+	ioOther.mCommitIncreaseSize = 0;
+	ioOther.mOwnerThreadID      = 0;
+
+	return *this;
+}
+
+
+MemBlock MemPool::AllocSlow()
+{
+	gAssert(mFreeList == nullptr);
+
+	// Take back the blocks freed by other threads, if any.
+	FreeNode* remote_free_list = mRemoteFreeList.Exchange(nullptr);
+	if (remote_free_list != nullptr)
+	{
+		mFreeList = remote_free_list->mNext;
+		mNumAllocatedBlocks++;
+		gGetMemCounters(EMemoryKind::Pool).OnAlloc(mBlockSize);
+		return { (uint8*)remote_free_list, mBlockSize };
+	}
+
+	// Otherwise allocate a block that was never allocated before, committing more memory if necessary.
+	if (mCurrentPtr + mBlockSize > mEndCommittedPtr) [[unlikely]]
+	{
+		int64 commit_size = gMin((int64)mCommitIncreaseSize, (int64)(mEndReservedPtr - mEndCommittedPtr));
+		if (commit_size < mBlockSize) [[unlikely]]
+			return {}; // The pool is full.
+
+		MemBlock committed_mem = gVMemCommit({ mEndCommittedPtr, commit_size });
+		if (committed_mem == nullptr) [[unlikely]]
+			return {}; // Out of memory.
+
+		mEndCommittedPtr = committed_mem.mPtr + committed_mem.mSize;
+		gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(committed_mem.mSize);
+	}
+
+	uint8* block_ptr = mCurrentPtr;
+	mCurrentPtr += mBlockSize;
+	mNumAllocatedBlocks++;
+	gGetMemCounters(EMemoryKind::Pool).OnAlloc(mBlockSize);
+
+	return { block_ptr, mBlockSize };
+}
+
+
+void MemPool::FreeRemote(FreeNode* inNode)
+{
+	// Lock-free push. Only the owner thread pops from this list, and it always takes the entire list at once,
+	// so there is no ABA problem.
+	FreeNode* head = mRemoteFreeList.Load(MemoryOrder::Relaxed);
+	do
+	{
+		inNode->mNext = head;
+	} while (!mRemoteFreeList.CompareExchange(head, inNode));
+
+	mNumRemoteFreedBlocks.Add(1);
+}
+
+
+void MemPool::FreeReserved()
+{
+	if (mBeginPtr == nullptr)
+		return;
+
+	gAssert(GetNumAllocatedBlocks() == 0);
+
+	gVMemFree({ mBeginPtr, mEndReservedPtr - mBeginPtr });
+	gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(-(mEndCommittedPtr - mBeginPtr));
+	mBeginPtr = nullptr;
+}
+
+
+REGISTER_TEST("MemPool")
+{
+	MemPool pool(24, 1_MiB, 4_KiB);
+	TEST_TRUE(pool.GetBlockSize() == 32);
+	TEST_TRUE(pool.GetCommittedSize() == 0);
+
+	MemBlock a = pool.Alloc();
+	MemBlock b = pool.Alloc();
+	MemBlock c = pool.Alloc();
+	TEST_TRUE(a.mSize == 32);
+	TEST_TRUE(b.mPtr == a.mPtr + 32);
+	TEST_TRUE(c.mPtr == b.mPtr + 32);
+	TEST_TRUE(pool.GetNumAllocatedBlocks() == 3);
+
+	// Free out of order, blocks are reused in LIFO order.
+	pool.Free(b);
+	pool.Free(a);
+	TEST_TRUE(pool.Alloc().mPtr == a.mPtr);
+	TEST_TRUE(pool.Alloc().mPtr == b.mPtr);
+	TEST_TRUE(pool.Alloc().mPtr == c.mPtr + 32);
+	TEST_TRUE(pool.GetNumAllocatedBlocks() == 4);
+
+	pool.Free(a);
+	pool.Free(b);
+	pool.Free(c);
+	pool.Free({ c.mPtr + 32, 32 });
+	TEST_TRUE(pool.GetNumAllocatedBlocks() == 0);
+
+	// Fill the pool entirely.
+	int num_blocks = 0;
+	while (pool.Alloc() != nullptr)
+		num_blocks++;
+
+	TEST_TRUE(num_blocks == 1_MiB / 32);
+	TEST_TRUE(pool.GetCommittedSize() == 1_MiB);
+
+	for (int i = 0; i < num_blocks; ++i)
+		pool.Free({ a.mPtr + i * 32, 32 });
+
+	TEST_TRUE(pool.GetNumAllocatedBlocks() == 0);
+};
+
+
+REGISTER_TEST("MemPool Remote Free")
+{
+	constexpr int cNumBlocks = 10000;
+
+	MemPool  pool(64);
+	MemBlock blocks[cNumBlocks];
+
+	for (MemBlock& block : blocks)
+		block = pool.Alloc();
+
+	int64 committed_size = pool.GetCommittedSize();
+
+	// Free everything from other threads, concurrently.
+	{
+		Thread threads[2];
+		for (int t = 0; t < 2; ++t)
+		{
+			threads[t].Create({ .mName = "MemPoolTest" }, [&pool, &blocks, t](Thread&)
+			{
+				for (int i = t; i < cNumBlocks; i += 2)
+					pool.Free(blocks[i]);
+			});
+		}
+	}
+
+	TEST_TRUE(pool.GetNumAllocatedBlocks() == 0);
+
+	// The blocks freed by other threads are reused by the owner thread.
+	for (MemBlock& block : blocks)
+		block = pool.Alloc();
+
+	TEST_TRUE(pool.GetCommittedSize() == committed_size);
+
+	for (MemBlock& block : blocks)
+		pool.Free(block);
+};
+
+
+REGISTER_TEST("ObjectPool")
+{
+	struct Object
+	{
+		Object(int inValue, int& ioAliveCount) : mValue(inValue), mAliveCount(ioAliveCount) { mAliveCount++; }
+		~Object() { mAliveCount--; }
+
+		int  mValue;
+		int& mAliveCount;
+	};
+
+	int                alive_count = 0;
+	ObjectPool<Object> pool;
+
+	Object* a = pool.New(1, alive_count);
+	Object* b = pool.New(2, alive_count);
+	TEST_TRUE(alive_count == 2);
+	TEST_TRUE(a->mValue == 1);
+	TEST_TRUE(b->mValue == 2);
+
+	pool.Delete(a);
+	TEST_TRUE(alive_count == 1);
+
+	Object* c = pool.New(3, alive_count);
+	TEST_TRUE(c == a);
+	TEST_TRUE(c->mValue == 3);
+
+	pool.Delete(b);
+	pool.Delete(c);
+	TEST_TRUE(alive_count == 0);
+	TEST_TRUE(pool.GetMemPool().GetNumAllocatedBlocks() == 0);
+};
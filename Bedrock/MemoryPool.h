@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Memory.h>
+#include <Bedrock/MemoryStats.h>
+#include <Bedrock/Atomic.h>
+#include <Bedrock/PlacementNew.h>
+#include <Bedrock/Thread.h>
+
+
+// Pool of fixed-size blocks. Blocks can be allocated and freed in any order, in O(1).
+// Uses virtual memory as backing: memory is reserved up front and committed as the pool grows. It is never decommitted.
+// Alloc must be called from the thread that owns the pool (the thread that created it). Free can be called from any thread:
+// blocks freed by other threads go into a lock-free list that the owner thread takes back when its own free list is empty.
+// Deals only in bytes. For a typed version, see ObjectPool.
+struct MemPool : NoCopy
+{
+	static constexpr int   cAlignment           = 16;
+	static constexpr int64 cDefaultReservedSize = 100_MiB; // By default the pool will reserve that much virtual memory.
+	static constexpr int64 cDefaultCommitSize   =  64_KiB; // By default the pool will commit that much virtual memory every time it grows.
+
+	MemPool() = default;
+	~MemPool() { FreeReserved(); }
+
+	// Initialize this pool with reserved memory (but no committed memory yet).
+	// inBlockSize is rounded up to cAlignment.
+	MemPool(int inBlockSize, int64 inReservedSize = cDefaultReservedSize, int64 inCommitIncreaseSize = cDefaultCommitSize);
+
+	MemPool(MemPool&& ioOther) { operator=((MemPool&&)ioOther); }
+	MemPool& operator=(MemPool&& ioOther);
+
+	// Allocate a block. Must be called from the owner thread.
+	// Return a nullptr MemBlock if the pool is full.
+	MemBlock Alloc()
+	{
+		gAssert(gGetCurrentThreadID() == mOwnerThreadID);
+
+		FreeNode* node = mFreeList;
+		if (node == nullptr) [[unlikely]]
+			return AllocSlow();
+
+		mFreeList = node->mNext;
+		mNumAllocatedBlocks++;
+		gGetMemCounters(EMemoryKind::Pool).OnAlloc(mBlockSize);
+
+		return { (uint8*)node, mBlockSize };
+	}
+
+	// Free a block. Can be called from any thread.
+	void Free(MemBlock inMemory)
+	{
+		gAssert(inMemory.mPtr != nullptr);
+		gAssert(inMemory.mSize <= mBlockSize);
+		gAssert(Owns(inMemory.mPtr));
+
+		FreeNode* node = (FreeNode*)inMemory.mPtr;
+
+		gGetMemCounters(EMemoryKind::Pool).OnFree(mBlockSize);
+
+		if (gGetCurrentThreadID() == mOwnerThreadID) [[likely]]
+		{
+			node->mNext = mFreeList;
+			mFreeList   = node;
+			mNumAllocatedBlocks--;
+		}
+		else
+		{
+			FreeRemote(node);
+		}
+	}
+
+	// Return true if inMemoryPtr is inside this pool.
+	bool Owns(const void* inMemoryPtr) const
+	{
+		return ((const uint8*)inMemoryPtr >= mBeginPtr && (const uint8*)inMemoryPtr < mEndReservedPtr);
+	}
+
+	int    GetBlockSize() const          { return mBlockSize; }
+	int64  GetReservedSize() const       { return mEndReservedPtr - mBeginPtr; }
+	int64  GetCommittedSize() const      { return mEndCommittedPtr - mBeginPtr; }
+	int64  GetNumAllocatedBlocks() const { return mNumAllocatedBlocks - mNumRemoteFreedBlocks.Load(MemoryOrder::Relaxed); } // Note: Only accurate on the owner thread if no other thread is freeing blocks.
+	uint32 GetOwnerThreadID() const      { return mOwnerThreadID; }
+
+	// Change the owner thread. The pool must not be used concurrently while doing this.
+	void   SetOwnerThreadID(uint32 inThreadID) { mOwnerThreadID = inThreadID; }
+
+private:
+	// Free blocks store the free list link in place.
+	struct FreeNode
+	{
+		FreeNode* mNext;
+	};
+
+	MemBlock AllocSlow();
+	void     FreeRemote(FreeNode* inNode);
+	void     FreeReserved();
+
+	FreeNode*         mFreeList             = nullptr; // Blocks freed by the owner thread.
+	int64             mNumAllocatedBlocks   = 0;       // Number of blocks allocated, minus the number of blocks freed by the owner thread.
+	uint8*            mBeginPtr             = nullptr;
+	uint8*            mCurrentPtr           = nullptr; // Blocks past this pointer were never allocated.
+	uint8*            mEndCommittedPtr      = nullptr;
+	uint8*            mEndReservedPtr       = nullptr;
+	int               mBlockSize            = 0;
+	int               mCommitIncreaseSize   = 0;
+	uint32            mOwnerThreadID        = 0;
+	Atomic<FreeNode*> mRemoteFreeList       = nullptr; // Blocks freed by other threads.
+	AtomicInt64       mNumRemoteFreedBlocks = 0;       // Number of blocks freed by other threads.
+};
+
+
+// Pool of objects of a single type. Objects can be created and destroyed in any order, in O(1).
+// Same threading rules as MemPool: New must be called from the owner thread, Delete can be called from any thread.
+template <typename taType>
+struct ObjectPool : NoCopy
+{
+	static_assert(alignof(taType) <= MemPool::cAlignment);
+
+	ObjectPool(int64 inReservedSize = MemPool::cDefaultReservedSize, int64 inCommitIncreaseSize = MemPool::cDefaultCommitSize)
+		: mPool((int)sizeof(taType), inReservedSize, inCommitIncreaseSize) {}
+
+	// Allocate and construct an object. Return nullptr if the pool is full.
+	template <typename... taArgs>
+	taType* New(taArgs&&... inArgs)
+	{
+		MemBlock memory = mPool.Alloc();
+		if (memory == nullptr) [[unlikely]]
+			return nullptr;
+
+		taType* object = (taType*)memory.mPtr;
+		gPlacementNew(*object, gForward<taArgs>(inArgs)...);
+		return object;
+	}
+
+	// Destroy and free an object.
+	void Delete(taType* inObject)
+	{
+		inObject->~taType();
+		mPool.Free({ (uint8*)inObject, (int64)sizeof(taType) });
+	}
+
+	MemPool&       GetMemPool()       { return mPool; }
+	const MemPool& GetMemPool() const { return mPool; }
+
+private:
+	MemPool mPool;
+};
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/MemoryStats.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/Trace.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/Test.h>
+
+
+const char* gToString(EMemoryKind inKind)
+{
+	switch (inKind)
+	{
+	case EMemoryKind::Heap:				return "Heap";
+	case EMemoryKind::Temp:				return "Temp";
+	case EMemoryKind::TempFallback:		return "TempFallback";
+	case EMemoryKind::VMem:				return "VMem";
+	case EMemoryKind::Fixed:			return "Fixed";
+	case EMemoryKind::Arena:			return "Arena";
+	case EMemoryKind::Pool:				return "Pool";
+	case EMemoryKind::VMemCommitted:	return "VMemCommitted";
+	case EMemoryKind::_Count:			break;
+	}
+
+	gAssert(false);
+	return "";
+}
+
+
+static constinit Atomic<MemTag*> sFirstMemTag = nullptr;
+
+
+MemTag::MemTag(const char* inName, int64 inBudget)
+{
+	mName   = inName;
+	mBudget = inBudget;
+
+	// Add it to the global list (lock-free, tags are never removed).
+	MemTag* first = sFirstMemTag.Load(MemoryOrder::Relaxed);
+	do
+	{
+		mNext = first;
+	} while (!sFirstMemTag.CompareExchange(first, this));
+}
+
+
+MemTag* gGetFirstMemTag()
+{
+	return sFirstMemTag.Load();
+}
+
+
+static void sTraceMemStats(const char* inName, MemStats inStats, int64 inBudget = 0)
+{
+	bool over_budget = inBudget > 0 && inStats.mLiveBytes > inBudget;
+
+	gTrace("  %-16s live: %10lld bytes (%8lld allocs)  peak: %10lld bytes  total allocs: %10lld%s",
+		inName, inStats.mLiveBytes, inStats.mLiveCount, inStats.mPeakBytes, inStats.mTotalCount, over_budget ? "  OVER BUDGET" : "");
+}
+
+
+void gTraceMemoryReport()
+{
+	gTrace("Memory report:");
+
+	// Note: The kinds overlap (see EMemoryKind), there is no total on purpose.
+	for (int i = 0; i < cMemoryKindCount; ++i)
+		sTraceMemStats(gToString((EMemoryKind)i), gGetMemStats((EMemoryKind)i));
+
+	for (MemTag* tag = gGetFirstMemTag(); tag != nullptr; tag = tag->GetNext())
+		sTraceMemStats(tag->GetName(), tag->GetStats(), tag->GetBudget());
+}
+
+
+
+REGISTER_TEST("MemCounters")
+{
+	MemCounters counters;
+	counters.OnAlloc(100);
+	counters.OnAlloc(50);
+	TEST_TRUE(counters.GetStats().mPeakBytes == 150);
+
+	counters.OnFree(100);
+	counters.OnResize(20);
+
+	MemStats stats = counters.GetStats();
+	TEST_TRUE(stats.mLiveBytes == 70);
+	TEST_TRUE(stats.mLiveCount == 1);
+	TEST_TRUE(stats.mPeakBytes == 150);
+	TEST_TRUE(stats.mTotalCount == 2);
+
+	counters.ResetPeak();
+	TEST_TRUE(counters.GetStats().mPeakBytes == 70);
+
+	// Spikes between two queries are not missed.
+	counters.OnAlloc(1000);
+	counters.OnFree(1000);
+	counters.OnResize(500);
+	counters.OnResize(-500);
+	TEST_TRUE(counters.GetStats().mPeakBytes == 1070);
+	TEST_TRUE(counters.GetStats().mLiveBytes == 70);
+};
+
+
+REGISTER_TEST("MemCounters Threads")
+{
+	MemCounters counters;
+
+	// Allocate on several threads (in different shards), free on this one.
+	Thread threads[4];
+	for (Thread& thread : threads)
+		thread.Create({ .mTempMemSize = 0 }, [&counters](Thread&)
+		{
+			for (int i = 0; i < 1000; ++i)
+				counters.OnAlloc(16);
+		});
+
+	for (Thread& thread : threads)
+		thread.Join();
+
+	for (int i = 0; i < 4000; ++i)
+		counters.OnFree(16);
+
+	MemStats stats = counters.GetStats();
+	TEST_TRUE(stats.mLiveBytes == 0);
+	TEST_TRUE(stats.mLiveCount == 0);
+	TEST_TRUE(stats.mTotalCount == 4000);
+	TEST_TRUE(stats.mPeakBytes == 4000 * 16);
+
+	// Do it again. The shards of the threads have a positive balance and the shard of this thread a negative one,
+	// but the peak should not drift up.
+	for (Thread& thread : threads)
+		thread.Create({ .mTempMemSize = 0 }, [&counters](Thread&)
+		{
+			for (int i = 0; i < 1000; ++i)
+				counters.OnAlloc(16);
+		});
+
+	for (Thread& thread : threads)
+		thread.Join();
+
+	for (int i = 0; i < 4000; ++i)
+		counters.OnFree(16);
+
+	stats = counters.GetStats();
+	TEST_TRUE(stats.mLiveBytes == 0);
+	TEST_TRUE(stats.mPeakBytes == 4000 * 16);
+};
+
+
+static MemTag sTestMemTag("Test", 1_KiB);
+
+REGISTER_TEST("MemTag")
+{
+	bool found = false;
+	for (MemTag* tag = gGetFirstMemTag(); tag != nullptr; tag = tag->GetNext())
+		found |= (tag == &sTestMemTag);
+	TEST_TRUE(found);
+
+	{
+		Vector<int, TaggedAllocator<int, sTestMemTag>> values;
+		values.Reserve(100);
+		TEST_TRUE(sTestMemTag.GetStats().mLiveBytes == values.Capacity() * sizeof(int)); // Capacity includes the slack of the allocation.
+		TEST_TRUE(sTestMemTag.GetStats().mLiveCount == 1);
+		TEST_TRUE(!sTestMemTag.IsOverBudget());
+
+		values.Reserve(1000);
+		TEST_TRUE(sTestMemTag.GetStats().mLiveBytes == values.Capacity() * sizeof(int));
+		TEST_TRUE(sTestMemTag.IsOverBudget());
+	}
+
+	TEST_TRUE(sTestMemTag.GetStats().mLiveBytes == 0);
+	TEST_TRUE(sTestMemTag.GetStats().mLiveCount == 0);
+};
+
+
+REGISTER_TEST("MemStats Kinds")
+{
+	MemStats heap_before  = gGetMemStats(EMemoryKind::Heap);
+	MemStats temp_before  = gGetMemStats(EMemoryKind::Temp);
+	MemStats fixed_before = gGetMemStats(EMemoryKind::Fixed);
+
+	{
+		Vector<int>        heap_values  = { 1, 2, 3 };
+		TempVector<int>    temp_values  = { 1, 2, 3 };
+		FixedVector<int, 4> fixed_values = { 1, 2, 3 };
+
+		TEST_TRUE(gGetMemStats(EMemoryKind::Heap).mTotalCount == heap_before.mTotalCount + 1);
+		TEST_TRUE(gGetMemStats(EMemoryKind::Temp).mTotalCount == temp_before.mTotalCount + 1);
+		TEST_TRUE(gGetMemStats(EMemoryKind::Fixed).mTotalCount == fixed_before.mTotalCount + 1);
+	}
+
+	// Note: Only check the current thread's counters didn't leak. Other threads can't allocate during tests.
+	TEST_TRUE(gGetMemStats(EMemoryKind::Heap).mLiveBytes == heap_before.mLiveBytes);
+	TEST_TRUE(gGetMemStats(EMemoryKind::Temp).mLiveBytes == temp_before.mLiveBytes);
+	TEST_TRUE(gGetMemStats(EMemoryKind::Fixed).mLiveBytes == fixed_before.mLiveBytes);
+
+	gTraceMemoryReport();
+};
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Atomic.h>
+
+
+// Kinds of memory that are tracked.
+// Note: The kinds are not disjoint, don't add them up to get a total:
+// - TempFallback allocations are made with gMemAlloc, so they are also counted in Heap.
+// - VMemCommitted is the memory backing some of the other kinds (eg. VMem, Temp, Pool).
+enum class EMemoryKind : int8
+{
+	Heap,			// Allocated with gMemAlloc (DefaultAllocator, TaggedAllocator, TempAllocator fallbacks, etc.).
+	Temp,			// Allocated by TempAllocator in temp memory.
+	TempFallback,	// Allocated by TempAllocator on the heap because temp memory ran out. Also counted in Heap.
+	VMem,			// Allocated by VMemAllocator.
+	Fixed,			// Allocated by FixedAllocator, or in the internal buffer of SmallAllocator.
+	Arena,			// Allocated by ArenaAllocator.
+	Pool,			// Allocated by MemPool/ObjectPool.
+	VMemCommitted,	// Virtual memory committed by VMemArena, MemPool and the size-class heap. Only bytes are tracked, not allocations.
+	_Count
+};
+
+constexpr int cMemoryKindCount = (int)EMemoryKind::_Count;
+
+// Return the name of a memory kind.
+const char* gToString(EMemoryKind inKind);
+
+
+// Snapshot of the memory stats of a kind or a tag.
+struct MemStats
+{
+	int64 mLiveBytes  = 0; // Number of bytes currently allocated.
+	int64 mLiveCount  = 0; // Number of allocations currently alive.
+	int64 mPeakBytes  = 0; // Highest value of mLiveBytes (see MemCounters about its precision).
+	int64 mTotalCount = 0; // Number of allocations ever made.
+};
+
+
+namespace Details
+{
+	constexpr int cMemCounterShards = 16;
+
+	inline constinit AtomicInt32      gNextMemCounterShard = 0;
+	inline constinit thread_local int gMemCounterShard     = -1;
+
+	// Return the shard of memory counters used by the current thread. Shards are assigned round-robin on first use.
+	force_inline int GetMemCounterShard()
+	{
+		if (gMemCounterShard < 0) [[unlikely]]
+			gMemCounterShard = gNextMemCounterShard.Add(1, MemoryOrder::Relaxed) % cMemCounterShards;
+
+		return gMemCounterShard;
+	}
+}
+
+
+// Memory counters. Lock-free, can be updated from any thread.
+// The counters are split in shards, and each thread updates its own shard, so that threads allocating at the same time
+// don't fight over the same cache line. The shards are only summed when the stats are queried.
+// Each shard also keeps its own peak, so that spikes between two queries are not missed. Querying the stats adds up the
+// shard peaks and restarts them from the current values.
+// Note: Shards don't necessarily peak at the same time, so the peak can be over-estimated, by at most the number of bytes
+// allocated since the previous query.
+struct MemCounters : NoCopy
+{
+	void OnAlloc(int64 inSize)
+	{
+		Shard& shard      = mShards[Details::GetMemCounterShard()];
+		int64  live_bytes = shard.mLiveBytes.Add(inSize, MemoryOrder::Relaxed) + inSize;
+		shard.mPeakBytes.Max(live_bytes, MemoryOrder::Relaxed);
+		shard.mLiveCount.Add(1, MemoryOrder::Relaxed);
+		shard.mTotalCount.Add(1, MemoryOrder::Relaxed);
+	}
+
+	void OnFree(int64 inSize)
+	{
+		Shard& shard = mShards[Details::GetMemCounterShard()];
+		shard.mLiveBytes.Sub(inSize, MemoryOrder::Relaxed);
+		shard.mLiveCount.Sub(1, MemoryOrder::Relaxed);
+	}
+
+	// Change the size of an allocation (or the number of bytes, for kinds that don't track allocations).
+	void OnResize(int64 inSizeDelta)
+	{
+		Shard& shard      = mShards[Details::GetMemCounterShard()];
+		int64  live_bytes = shard.mLiveBytes.Add(inSizeDelta, MemoryOrder::Relaxed) + inSizeDelta;
+
+		if (inSizeDelta > 0)
+			shard.mPeakBytes.Max(live_bytes, MemoryOrder::Relaxed);
+	}
+
+	// Sum the shards and update the peak.
+	MemStats GetStats() const
+	{
+		MemStats stats;
+		int64    peak_bytes = 0;
+		for (const Shard& shard : mShards)
+		{
+			int64 live_bytes   = shard.mLiveBytes.Load(MemoryOrder::Relaxed);
+			stats.mLiveBytes  += live_bytes;
+			stats.mLiveCount  += shard.mLiveCount.Load(MemoryOrder::Relaxed);
+			stats.mTotalCount += shard.mTotalCount.Load(MemoryOrder::Relaxed);
+
+			// Restart the shard peak from the current value. Otherwise memory allocated in one shard and freed in another
+			// would make the peak of the first shard (and the sum) grow forever.
+			peak_bytes += gMax(shard.mPeakBytes.Exchange(live_bytes, MemoryOrder::Relaxed), live_bytes);
+		}
+
+		stats.mPeakBytes = gMax(mPeakBytes.Max(peak_bytes, MemoryOrder::Relaxed), peak_bytes);
+		return stats;
+	}
+
+	// Reset the peak to the current number of live bytes.
+	void ResetPeak()
+	{
+		int64 live_bytes = 0;
+		for (Shard& shard : mShards)
+		{
+			int64 shard_live_bytes = shard.mLiveBytes.Load(MemoryOrder::Relaxed);
+			shard.mPeakBytes.Store(shard_live_bytes, MemoryOrder::Relaxed);
+			live_bytes += shard_live_bytes;
+		}
+
+		mPeakBytes.Store(live_bytes, MemoryOrder::Relaxed);
+	}
+
+private:
+	struct alignas(cCacheLineSize) Shard // Aligned to avoid false sharing between shards.
+	{
+		AtomicInt64         mLiveBytes  = 0;
+		mutable AtomicInt64 mPeakBytes  = 0; // Highest value of mLiveBytes since the last query.
+		AtomicInt64         mLiveCount  = 0;
+		AtomicInt64         mTotalCount = 0;
+	};
+
+	Shard               mShards[Details::cMemCounterShards];
+	mutable AtomicInt64 mPeakBytes = 0;
+};
+
+
+namespace Details
+{
+	inline constinit MemCounters gMemCounters[cMemoryKindCount];
+}
+
+// Return the counters of a memory kind.
+inline MemCounters& gGetMemCounters(EMemoryKind inKind)	{ return Details::gMemCounters[(int)inKind]; }
+
+// Return the stats of a memory kind.
+inline MemStats gGetMemStats(EMemoryKind inKind)		{ return gGetMemCounters(inKind).GetStats(); }
+
+
+// User-defined memory tag, with an optional budget. Use with TaggedAllocator, or update the counters manually.
+// Tags should be global variables. They register themselves in a global list (used by gTraceMemoryReport).
+//
+//		inline MemTag gPhysicsMemTag("Physics", 64_MiB);
+//		Vector<Body, TaggedAllocator<Body, gPhysicsMemTag>> bodies;
+//
+struct MemTag : NoCopy
+{
+	MemTag(const char* inName, int64 inBudget = 0);
+
+	const char*  GetName() const		{ return mName; }
+	int64        GetBudget() const		{ return mBudget; }		// 0 means no budget.
+	MemStats     GetStats() const		{ return mCounters.GetStats(); }
+	bool         IsOverBudget() const	{ return mBudget > 0 && GetStats().mLiveBytes > mBudget; }
+	MemCounters& GetCounters()			{ return mCounters; }
+	MemTag*      GetNext() const		{ return mNext; }			// Next tag in the global list.
+
+private:
+	MemCounters  mCounters;
+	const char*  mName   = nullptr;
+	int64        mBudget = 0;
+	MemTag*      mNext   = nullptr;
+};
+
+// Return the first tag of the global list of tags. Use MemTag::GetNext to iterate.
+MemTag* gGetFirstMemTag();
+
+
+// Trace the stats of all the memory kinds and tags.
+void gTraceMemoryReport();
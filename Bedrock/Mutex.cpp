@@ -3,11 +3,20 @@
 #include <Bedrock/Test.h>
 #include <Bedrock/Move.h>
 
+#if defined(_WIN32)
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <unistd.h>
+#else
+#error Unknown platform
+#endif
+
 
+#if defined(_WIN32)
 
 Mutex::Mutex()
 {
@@ -20,14 +29,43 @@ Mutex::~Mutex()
 }
 
 
+static force_inline void sLock(OSMutex& ioMutex)		{ AcquireSRWLockExclusive((PSRWLOCK)&ioMutex); }
+static force_inline void sUnlock(OSMutex& ioMutex)		{ ReleaseSRWLockExclusive((PSRWLOCK)&ioMutex); }
+static force_inline uint32 sGetCurrentThreadID()		{ return GetCurrentThreadId(); }
+
+#elif defined(__linux__)
+
+static_assert(sizeof(OSMutex) >= sizeof(pthread_mutex_t) && alignof(OSMutex) >= alignof(pthread_mutex_t));
+
+Mutex::Mutex()
+{
+	int result = pthread_mutex_init((pthread_mutex_t*)&mOSMutex, nullptr);
+	gAssert(result == 0);
+}
+
+
+Mutex::~Mutex()
+{
+	int result = pthread_mutex_destroy((pthread_mutex_t*)&mOSMutex);
+	gAssert(result == 0);
+}
+
+
+static force_inline void sLock(OSMutex& ioMutex)		{ pthread_mutex_lock((pthread_mutex_t*)&ioMutex); }
+static force_inline void sUnlock(OSMutex& ioMutex)		{ pthread_mutex_unlock((pthread_mutex_t*)&ioMutex); }
+static force_inline uint32 sGetCurrentThreadID()		{ return (uint32)gettid(); }
+
+#endif
+
+
 void Mutex::Lock()
 {
 #ifdef ASSERTS_ENABLED
-	uint32 current_thread_id = GetCurrentThreadId();
+	uint32 current_thread_id = sGetCurrentThreadID();
 	gAssert(mLockingThreadID != current_thread_id); // Recursive locking is not allowed.
 #endif
 
-	AcquireSRWLockExclusive((PSRWLOCK)&mOSMutex);
+	sLock(mOSMutex);
 
 #ifdef ASSERTS_ENABLED
 	mLockingThreadID = current_thread_id;
@@ -38,11 +76,11 @@ void Mutex::Lock()
 void Mutex::Unlock()
 {
 #ifdef ASSERTS_ENABLED
-	gAssert(mLockingThreadID == GetCurrentThreadId());
+	gAssert(mLockingThreadID == sGetCurrentThreadID());
 	mLockingThreadID = cInvalidThreadID;
 #endif
 
-	ReleaseSRWLockExclusive((PSRWLOCK)&mOSMutex);
+	sUnlock(mOSMutex);
 }
 
 
@@ -5,7 +5,11 @@
 
 struct ConditionVariable;
 
-using OSMutex  = void*;
+#ifdef _WIN32
+using OSMutex  = void*; // SRWLOCK
+#else
+struct alignas(8) OSMutex { uint8 mStorage[40]; }; // pthread_mutex_t
+#endif
 using OSThread = void*;
 
 
@@ -20,7 +24,7 @@ struct Mutex : NoCopy
 private:
 	static constexpr uint32 cInvalidThreadID = 0;
 
-	OSMutex  mOSMutex         = nullptr;
+	OSMutex  mOSMutex         = {};
 #ifdef ASSERTS_ENABLED
 	uint32   mLockingThreadID = cInvalidThreadID;
 #endif
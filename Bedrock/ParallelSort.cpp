@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/ParallelSort.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/String.h>
+#include <Bedrock/Random.h>
+
+
+REGISTER_TEST("ParallelSort")
+{
+	// Large enough to use several threads (see cParallelSortMinSizePerThread).
+	constexpr int cSize = 100003;
+
+	uint32      seed = 2468;
+	Vector<int> values;
+	values.Resize(cSize);
+
+	for (int thread_count : { 1, 2, 3, 4 })
+	{
+		for (int pattern = 0; pattern < 5; ++pattern)
+		{
+			for (int i = 0; i < cSize; ++i)
+			{
+				switch (pattern)
+				{
+				case 0: values[i] = (int)(seed = gRand32(seed));			break; // Random
+				case 1: values[i] = i;										break; // Sorted
+				case 2: values[i] = cSize - i;								break; // Reverse sorted
+				case 3: values[i] = 42;										break; // All equal
+				case 4: values[i] = (int)((seed = gRand32(seed)) % 4);		break; // Few unique
+				}
+			}
+
+			Vector<int> sorted = values;
+			gSort(sorted);
+
+			gParallelSort(values, Less{}, thread_count);
+			TEST_TRUE(gEquals(values, sorted));
+		}
+	}
+
+	// Custom comparison.
+	for (int& value : values)
+		value = (int)(seed = gRand32(seed));
+
+	auto greater = [](int inA, int inB) { return inA > inB; };
+	gParallelSort(values, greater, 3);
+	TEST_TRUE(gIsSorted(values, greater));
+
+	// Small ranges are sorted on the calling thread.
+	int small[] = { 3, 1, 2 };
+	gParallelSort(small);
+	TEST_TRUE(small[0] == 1 && small[1] == 2 && small[2] == 3);
+};
+
+
+REGISTER_TEST("ParallelSort Deterministic")
+{
+	struct Element
+	{
+		int mKey;
+		int mIndex;
+
+		bool operator==(const Element&) const = default;
+	};
+
+	auto less_key = [](const Element& inA, const Element& inB) { return inA.mKey < inB.mKey; };
+
+	uint32          seed = 9753;
+	Vector<Element> elements;
+	for (int i = 0; i < 70000; ++i)
+		elements.PushBack({ (int)((seed = gRand32(seed)) % 16), i });
+
+	// Same input and thread count, same order of equal elements.
+	Vector<Element> first = elements;
+	Vector<Element> second = elements;
+	gParallelSort(first, less_key, 4);
+	gParallelSort(second, less_key, 4);
+
+	TEST_TRUE(gIsSorted(first, less_key));
+	TEST_TRUE(gEquals(first, second));
+};
+
+
+REGISTER_TEST("ParallelSort String")
+{
+	// Non-trivial type, moved through the temp memory of each thread.
+	uint32         seed = 1122;
+	Vector<String> strings;
+	for (int i = 0; i < 40000; ++i)
+	{
+		String string = "a string long enough to allocate ";
+		for (int c = 0; c < 4; ++c)
+		{
+			char ch = (char)('a' + (seed = gRand32(seed)) % 26);
+			string.Append(&ch, 1);
+		}
+		strings.PushBack(gMove(string));
+	}
+
+	Vector<String> sorted = strings;
+	gSort(sorted);
+
+	gParallelSort(strings, Less{}, 2);
+	TEST_TRUE(gEquals(strings, sorted));
+};
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Sort.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/Event.h>
+
+
+// Parallel sample sort (PSRS: parallel sorting by regular sampling).
+// 1. The range is split into one chunk per thread, each thread sorts its chunk with gSort and takes regularly spaced samples.
+// 2. The samples are sorted, and splitters are picked from them to divide the values into one bucket per thread.
+// 3. Each thread merges the parts of all the chunks that belong to its bucket into its own temp memory, then moves
+//    the result back to the position of its bucket in the range.
+// The result doesn't depend on thread timing: for a given thread count, equal elements always end up in the same order.
+// It is not stable though, and a different thread count can give a different order of equal elements.
+// Note: Many equal elements end up in the same bucket, which limits parallelism on ranges with very few unique values.
+
+
+namespace Details
+{
+	// Below this number of elements per thread, starting threads costs more than it saves.
+	constexpr int cParallelSortMinSizePerThread = 16384;
+	constexpr int cParallelSortMaxThreads       = 64;
+
+	// Number of samples taken from each chunk to choose the splitters. More samples give more evenly sized buckets.
+	constexpr int cParallelSortSamplesPerChunk  = 32;
+
+
+	// Single-use barrier. Wait returns once inCount threads have called it.
+	struct SortBarrier : NoCopy
+	{
+		explicit SortBarrier(int inCount) : mRemaining(inCount) {}
+
+		void Wait()
+		{
+			if (mRemaining.Sub(1) == 1)
+				mEvent.Set();	// Last one, wake up the others.
+			else
+				mEvent.Wait();
+		}
+
+		AtomicInt32 mRemaining;
+		Event       mEvent { Event::ManualReset };
+	};
+
+
+	// Call inFunc(int inThreadIndex) once for each index in [0, inThreadCount), each on a different thread.
+	// Index 0 runs on the calling thread. Returns when all calls are done.
+	template <typename taFunc>
+	void RunOnThreads(int inThreadCount, const taFunc& inFunc)
+	{
+		int     num_threads = inThreadCount - 1;
+		Thread* threads     = TempAllocator<Thread>::Allocate(num_threads);
+
+		for (int i = 0; i < num_threads; ++i)
+		{
+			gPlacementNew(threads[i]);
+
+			// Temp memory is lazily initialized, the amount needed depends on the size of the range.
+			threads[i].Create({ .mName = "ParallelSort", .mTempMemSize = 0 }, [&inFunc, i](Thread&) { inFunc(i + 1); });
+		}
+
+		inFunc(0);
+
+		// The Thread destructor waits for the thread to finish.
+		for (int i = 0; i < num_threads; ++i)
+			threads[i].~Thread();
+
+		TempAllocator<Thread>::Free(threads, num_threads);
+	}
+
+
+	// Move the sorted ranges inA and inB into the uninitialized memory at outDest, merged.
+	// The source elements are destroyed, only one copy of each element stays alive.
+	template <typename taType, typename taLess>
+	void MergeMove(Span<taType> inA, Span<taType> inB, taType* outDest, taLess& inLess)
+	{
+		taType* a     = inA.Begin();
+		taType* a_end = inA.End();
+		taType* b     = inB.Begin();
+		taType* b_end = inB.End();
+
+		// Take from B only if strictly less, equal elements stay in chunk order.
+		while (a != a_end && b != b_end)
+		{
+			taType* src = inLess(*b, *a) ? b++ : a++;
+			gPlacementNew(*outDest++, gMove(*src));
+			src->~taType();
+		}
+
+		for (; a != a_end; ++a)
+		{
+			gPlacementNew(*outDest++, gMove(*a));
+			a->~taType();
+		}
+
+		for (; b != b_end; ++b)
+		{
+			gPlacementNew(*outDest++, gMove(*b));
+			b->~taType();
+		}
+	}
+
+
+	template <typename taType, typename taLess>
+	void ParallelSort(taType* ioData, int inSize, int inThreadCount, taLess& inLess)
+	{
+		const int thread_count = inThreadCount;
+		const int chunk_size   = inSize / thread_count;
+
+		auto get_chunk_begin = [&](int inChunk) { return inChunk * chunk_size; };
+		auto get_chunk_end   = [&](int inChunk) { return inChunk == thread_count - 1 ? inSize : (inChunk + 1) * chunk_size; };
+
+		// 1. Sort the chunks and take the samples.
+		// Samples are pointers to the elements, so that they don't need to be copied.
+		int      num_samples = thread_count * cParallelSortSamplesPerChunk;
+		taType** samples     = TempAllocator<taType*>::Allocate(num_samples);
+
+		RunOnThreads(thread_count, [&](int inThreadIndex)
+		{
+			taType* begin = ioData + get_chunk_begin(inThreadIndex);
+			taType* end   = ioData + get_chunk_end(inThreadIndex);
+			gSort(begin, end, inLess);
+
+			int size = (int)(end - begin);
+			for (int i = 0; i < cParallelSortSamplesPerChunk; ++i)
+				samples[inThreadIndex * cParallelSortSamplesPerChunk + i] = begin + (int)((int64)size * i / cParallelSortSamplesPerChunk);
+		});
+
+		// 2. Sort the samples and use regularly spaced ones as splitters.
+		// Then find the boundaries of the buckets in each chunk: bounds[chunk][bucket] is the start of the bucket in the chunk.
+		gSort(samples, samples + num_samples, [&inLess](const taType* inA, const taType* inB) { return inLess(*inA, *inB); });
+
+		int  bounds_stride = thread_count + 1;
+		int* bounds        = TempAllocator<int>::Allocate(thread_count * bounds_stride);
+		for (int chunk = 0; chunk < thread_count; ++chunk)
+		{
+			int* chunk_bounds = bounds + chunk * bounds_stride;
+			taType* begin     = ioData + get_chunk_begin(chunk);
+			taType* end       = ioData + get_chunk_end(chunk);
+
+			chunk_bounds[0] = get_chunk_begin(chunk);
+			for (int bucket = 1; bucket < thread_count; ++bucket)
+			{
+				const taType& splitter = *samples[bucket * cParallelSortSamplesPerChunk];
+				begin = gLowerBound(begin, end, splitter, inLess); // Splitters are sorted, start from the previous bound.
+				chunk_bounds[bucket] = (int)(begin - ioData);
+			}
+			chunk_bounds[thread_count] = get_chunk_end(chunk);
+		}
+
+		// 3. Merge each bucket into temp memory, then move it back in place.
+		// All the threads need to be done reading the range before any of them can write into it, hence the barrier.
+		SortBarrier barrier(thread_count);
+
+		RunOnThreads(thread_count, [&](int inBucket)
+		{
+			// Gather the parts of the bucket in each chunk, and the position of the bucket in the sorted range.
+			Span<taType> runs[cParallelSortMaxThreads];
+			int          num_runs    = 0;
+			int          bucket_size = 0;
+			int          bucket_pos  = 0;
+			for (int chunk = 0; chunk < thread_count; ++chunk)
+			{
+				int* chunk_bounds = bounds + chunk * bounds_stride;
+				int  begin        = chunk_bounds[inBucket];
+				int  end          = chunk_bounds[inBucket + 1];
+
+				bucket_pos += begin - chunk_bounds[0];
+				if (end > begin)
+				{
+					runs[num_runs++] = { ioData + begin, ioData + end };
+					bucket_size += end - begin;
+				}
+			}
+
+			// Nothing to do for an empty bucket, but the others still need to wait for this thread at the barrier.
+			if (num_runs == 0)
+			{
+				barrier.Wait();
+				return;
+			}
+
+			// Merge the runs in pairs, alternating between two buffers. The first round reads from the range itself.
+			// Note: The second buffer is only needed if there are more than two runs.
+			int     buffer_count = num_runs > 2 ? 2 : 1;
+			taType* buffers      = TempAllocator<taType>::Allocate(bucket_size * buffer_count);
+			taType* dest         = buffers;
+			taType* other        = buffers + (buffer_count - 1) * bucket_size;
+
+			do
+			{
+				int     num_merged_runs = 0;
+				taType* out             = dest;
+				for (int i = 0; i < num_runs; i += 2)
+				{
+					Span<taType> b = i + 1 < num_runs ? runs[i + 1] : Span<taType>();
+					MergeMove(runs[i], b, out, inLess);
+
+					int merged_size = runs[i].Size() + b.Size();
+					runs[num_merged_runs++] = { out, merged_size };
+					out += merged_size;
+				}
+
+				num_runs = num_merged_runs;
+				gSwap(dest, other);
+
+			} while (num_runs > 1);
+
+			barrier.Wait();
+
+			// Move the bucket to its final position.
+			MergeMove(runs[0], {}, ioData + bucket_pos, inLess);
+
+			TempAllocator<taType>::Free(buffers, bucket_size * buffer_count);
+		});
+
+		TempAllocator<int>::Free(bounds, thread_count * bounds_stride);
+		TempAllocator<taType*>::Free(samples, num_samples);
+	}
+}
+
+
+// Sort the range [inBegin, inEnd) using up to inThreadCount threads (see above). Not stable.
+// Uses temp memory for a buffer the size of the range (twice for some buckets), spread across the threads.
+template <typename taType, typename taLess = Less>
+void gParallelSort(taType* inBegin, taType* inEnd, taLess inLess = {}, int inThreadCount = gThreadHardwareConcurrency())
+{
+	int size         = (int)(inEnd - inBegin);
+	int thread_count = gMin(gMin(inThreadCount, size / Details::cParallelSortMinSizePerThread), Details::cParallelSortMaxThreads);
+
+	if (thread_count <= 1)
+	{
+		gSort(inBegin, inEnd, inLess);
+		return;
+	}
+
+	Details::ParallelSort(inBegin, size, thread_count, inLess);
+}
+
+
+// Sort a container using up to inThreadCount threads. Not stable.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+void gParallelSort(taContainer&& ioContainer, taLess inLess = {}, int inThreadCount = gThreadHardwareConcurrency())
+{
+	Span span(ioContainer);
+	gParallelSort(span.Begin(), span.End(), inLess, inThreadCount);
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/RadixSort.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/String.h>
+#include <Bedrock/Random.h>
+
+
+REGISTER_TEST("RadixSort Integers")
+{
+	uint32 seed = 2468;
+
+	for (int size : { 0, 1, 10, 64, 65, 1000, 100000 })
+	{
+		Vector<uint64> values;
+		for (int i = 0; i < size; ++i)
+		{
+			seed = gRand32(seed);
+			uint64 high = seed;
+			seed = gRand32(seed);
+			values.PushBack((high << 32) | seed);
+		}
+
+		Vector<uint64> sorted = values;
+		gSort(sorted);
+
+		gRadixSort(values);
+		TEST_TRUE(gEquals(values, sorted));
+	}
+
+	// Signed values, and small values (most passes skipped).
+	Vector<int> values;
+	for (int i = 0; i < 1000; ++i)
+	{
+		seed = gRand32(seed);
+		values.PushBack((int)(seed % 2000) - 1000);
+	}
+	values.PushBack(cMaxInt32);
+	values.PushBack(-cMaxInt32 - 1);
+
+	gRadixSort(values);
+	TEST_TRUE(gIsSorted(values));
+	TEST_TRUE(values.Front() == -cMaxInt32 - 1);
+	TEST_TRUE(values.Back() == cMaxInt32);
+
+	int8 small[] = { 5, -3, 127, -128, 0, -1 };
+	gRadixSort(small);
+	TEST_TRUE(gIsSorted(small));
+};
+
+
+REGISTER_TEST("RadixSort Floats")
+{
+	uint32        seed = 1357;
+	Vector<float> values;
+	for (int i = 0; i < 1000; ++i)
+	{
+		seed = gRand32(seed);
+		values.PushBack(((float)seed / 1000.0f - 1000000.0f) * ((i % 3) == 0 ? 1e-6f : 1.0f));
+	}
+	values.PushBack(0.0f);
+	values.PushBack(1e30f);
+	values.PushBack(-1e30f);
+
+	gRadixSort(values);
+	TEST_TRUE(gIsSorted(values));
+
+	Vector<double> doubles = { 3.5, -2.25, 0.0, -100.0, 1e100, -1e-100 };
+	for (int i = 0; i < 100; ++i)
+		doubles.PushBack((double)i * -0.5);
+
+	gRadixSort(doubles);
+	TEST_TRUE(gIsSorted(doubles));
+	TEST_TRUE(doubles.Front() == -100.0);
+	TEST_TRUE(doubles.Back() == 1e100);
+};
+
+
+REGISTER_TEST("RadixSort Keys")
+{
+	struct Item
+	{
+		uint32 mID;
+		int    mIndex;
+	};
+
+	uint32       seed = 9753;
+	Vector<Item> items;
+	for (int i = 0; i < 5000; ++i)
+	{
+		seed = gRand32(seed);
+		items.PushBack({ seed % 100, i });
+	}
+
+	// Stable: equal keys keep their original order.
+	gRadixSort(items, [](const Item& inItem) { return inItem.mID; });
+	TEST_TRUE(gIsSorted(items, [](const Item& inA, const Item& inB)
+	{
+		return inA.mID < inB.mID || (inA.mID == inB.mID && inA.mIndex < inB.mIndex);
+	}));
+
+	// Trivially relocatable but not trivially copyable elements.
+	Vector<String> strings;
+	for (int i = 0; i < 200; ++i)
+	{
+		String string = "a string long enough to allocate";
+		string.Append((i % 2) ? "1" : "0");
+		strings.PushBack(gMove(string));
+	}
+
+	gRadixSort(strings, [](const String& inString) { return inString.Back(); });
+	TEST_TRUE(strings.Front().Back() == '0');
+	TEST_TRUE(strings.Back().Back() == '1');
+	TEST_TRUE(gIsSorted(strings));
+};
+
+
+REGISTER_TEST("RadixSort Strings")
+{
+	StringView words[] = { "banana", "apple", "", "app", "apple", "band", "ban", "b", "cherry", "apricot", "\xff", "a" };
+	gRadixSort(words);
+	TEST_TRUE(gIsSorted(words));
+	TEST_TRUE(words[0] == "");
+	TEST_TRUE(words[11] == "\xff");
+
+	// Larger set with long common prefixes.
+	uint32         seed = 8642;
+	Vector<String> strings;
+	for (int i = 0; i < 2000; ++i)
+	{
+		String string = "common/prefix/";
+		for (int c = 0, length = (int)(gRand32(seed + i) % 6); c < length; ++c)
+		{
+			seed = gRand32(seed);
+			char ch = (char)('a' + seed % 4);
+			string.Append(&ch, 1);
+		}
+		strings.PushBack(gMove(string));
+	}
+
+	gRadixSort(strings);
+	TEST_TRUE(gIsSorted(strings));
+
+	// Key extracted from a struct.
+	struct Named
+	{
+		StringView mName;
+		int        mValue;
+	};
+
+	Named named[] = { { "zeta", 0 }, { "alpha", 1 }, { "mu", 2 } };
+	gRadixSort(named, [](const Named& inNamed) { return inNamed.mName; });
+	TEST_TRUE(named[0].mValue == 1 && named[1].mValue == 2 && named[2].mValue == 0);
+};
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Sort.h>
+#include <Bedrock/StringView.h>
+#include <Bedrock/TypeTraits.h>
+
+
+// Radix sorts. Faster than comparison sorts for large arrays of numbers or strings.
+// - Integer and floating point keys: LSD radix sort, one pass per 11 bits of the key (passes where all keys have the same digit
+//   are skipped). Stable. Uses temp memory for a buffer the size of the range, and needs trivially relocatable elements.
+// - StringView keys (or anything that converts to StringView, like String): MSD multikey quicksort. In place, not stable.
+// The key is the element itself, or is extracted with inGetKey (eg. [](const Item& inItem) { return inItem.mID; }).
+
+
+namespace Details
+{
+	// Below this size, radix sorts fall back to an insertion sort.
+	constexpr int cRadixSortThreshold = 64;
+
+	// Number of bits sorted per LSD pass. A pass with 11 bits costs about the same as with 8 bits (it's limited by memory
+	// bandwidth), but 64-bit keys need only 6 passes instead of 8, and 32-bit keys 3 instead of 4.
+	constexpr int cRadixDigitBits  = 11;
+	constexpr int cRadixNumBuckets = 1 << cRadixDigitBits;
+
+	template <typename taKey>
+	constexpr bool cIsRadixKey = (cIsIntegral<taKey> && !cIsSame<::RemoveCV<taKey>, bool>) || cIsSame<::RemoveCV<taKey>, float> || cIsSame<::RemoveCV<taKey>, double>;
+
+	template <typename taKey>
+	constexpr bool cIsStringKey = cIsConvertible<const taKey&, StringView>;
+
+	// Convert a key to an unsigned integer that sorts in the same order.
+	template <typename taKey>
+	force_inline constexpr auto ToRadixKey(taKey inKey)
+	{
+		using UInt = ::UnsignedOfSize<sizeof(taKey)>;
+		constexpr UInt cSignBit = (UInt)1 << (sizeof(taKey) * 8 - 1);
+
+		UInt bits = __builtin_bit_cast(UInt, inKey);
+
+		if constexpr (cIsFloatingPoint<taKey>)
+			return (bits & cSignBit) ? (UInt)~bits : (UInt)(bits | cSignBit);	// Negative: flip all bits to reverse their order. Positive: flip the sign bit to put them after.
+		else if constexpr (cIsSigned<taKey>)
+			return (UInt)(bits ^ cSignBit);										// Flip the sign bit to put negative values first.
+		else
+			return bits;
+	}
+
+
+	struct RadixKeyIdentity
+	{
+		template <typename taType>
+		constexpr const taType& operator()(const taType& inValue) const { return inValue; }
+	};
+
+
+	// LSD radix sort, cRadixDigitBits per pass.
+	template <typename taType, typename taGetKey>
+	void RadixSortLSD(taType* ioData, int inSize, taGetKey& inGetKey)
+	{
+		static_assert(cIsTriviallyRelocatable<taType>, "Elements are moved around with memcpy");
+
+		using Key = decltype(ToRadixKey(inGetKey(*ioData)));
+		constexpr int cNumPasses = (sizeof(Key) * 8 + cRadixDigitBits - 1) / cRadixDigitBits;
+
+		// Build the histograms of all the passes at once.
+		int histograms[cNumPasses][cRadixNumBuckets] = {};
+		for (int i = 0; i < inSize; ++i)
+		{
+			Key key = ToRadixKey(inGetKey(ioData[i]));
+			for (int pass = 0; pass < cNumPasses; ++pass)
+				histograms[pass][(key >> (pass * cRadixDigitBits)) & (cRadixNumBuckets - 1)]++;
+		}
+
+		taType* buffer = TempAllocator<taType>::Allocate(inSize);
+		taType* source = ioData;
+		taType* dest   = buffer;
+
+		for (int pass = 0; pass < cNumPasses; ++pass)
+		{
+			int* offsets = histograms[pass];
+			int  shift   = pass * cRadixDigitBits;
+
+			// Skip the pass if all keys have the same digit (common in the high bits of ids or small values).
+			if (offsets[(ToRadixKey(inGetKey(*source)) >> shift) & (cRadixNumBuckets - 1)] == inSize)
+				continue;
+
+			// Turn the counts into offsets.
+			int offset = 0;
+			for (int& count : histograms[pass])
+			{
+				int bucket_size = count;
+				count  = offset;
+				offset += bucket_size;
+			}
+
+			// Scatter. Elements are relocated without calling constructors/destructors, each element lives in only one of the two buffers.
+			for (int i = 0; i < inSize; ++i)
+			{
+				int bucket = (int)((ToRadixKey(inGetKey(source[i])) >> shift) & (cRadixNumBuckets - 1));
+				gMemCopy((void*)&dest[offsets[bucket]++], &source[i], sizeof(taType));
+			}
+
+			gSwap(source, dest);
+		}
+
+		// After an odd number of passes the result is in the buffer.
+		if (source != ioData)
+			gMemCopy((void*)ioData, source, (int64)inSize * sizeof(taType));
+
+		TempAllocator<taType>::Free(buffer, inSize);
+	}
+
+
+	// Return the character at inDepth as an unsigned value, or -1 if the string is shorter.
+	force_inline int GetCharAt(StringView inString, int inDepth)
+	{
+		return inDepth < inString.Size() ? (int)(uint8)inString.Data()[inDepth] : -1;
+	}
+
+
+	// Multikey quicksort (Bentley & Sedgewick): a 3-way quicksort on the character at inDepth. Elements with the same character
+	// as the pivot are then sorted on the next character. Each character is only compared once per partitioning step,
+	// instead of comparing entire strings.
+	template <typename taType, typename taGetKey>
+	void MultikeyQuickSort(taType* ioData, int inSize, int inDepth, taGetKey& inGetKey)
+	{
+		while (inSize > cInsertionSortThreshold)
+		{
+			// Median of 3 pivot.
+			int a     = GetCharAt(inGetKey(ioData[0]), inDepth);
+			int b     = GetCharAt(inGetKey(ioData[inSize / 2]), inDepth);
+			int c     = GetCharAt(inGetKey(ioData[inSize - 1]), inDepth);
+			int pivot = gMax(gMin(a, b), gMin(gMax(a, b), c));
+
+			// 3-way partition: [0, less) < pivot, [less, greater) == pivot, [greater, inSize) > pivot.
+			int less    = 0;
+			int greater = inSize;
+			for (int i = 0; i < greater;)
+			{
+				int ch = GetCharAt(inGetKey(ioData[i]), inDepth);
+				if (ch < pivot)
+					gSwap(ioData[less++], ioData[i++]);
+				else if (ch > pivot)
+					gSwap(ioData[i], ioData[--greater]);
+				else
+					i++;
+			}
+
+			MultikeyQuickSort(ioData, less, inDepth, inGetKey);
+			MultikeyQuickSort(ioData + greater, inSize - greater, inDepth, inGetKey);
+
+			// If the pivot is the end of the string, all the elements in the middle are equal.
+			if (pivot == -1)
+				return;
+
+			// Loop on the middle part with the next character.
+			ioData += less;
+			inSize  = greater - less;
+			inDepth++;
+		}
+
+		// Small range, the first inDepth characters are known to be equal.
+		auto less_suffix = [&inGetKey, inDepth](const taType& inA, const taType& inB)
+		{
+			StringView a = inGetKey(inA);
+			StringView b = inGetKey(inB);
+			return a.SubStr(inDepth) < b.SubStr(inDepth);
+		};
+		InsertionSort(ioData, ioData + inSize, less_suffix);
+	}
+}
+
+
+// True if a Span can be made from taContainer and inGetKey returns a key usable by gRadixSort from its elements.
+template <typename taContainer, typename taGetKey>
+concept cIsRadixSortable = requires (taContainer& ioContainer, taGetKey& inGetKey) { inGetKey(Span(ioContainer)[0]); };
+
+
+// Sort the range [inBegin, inEnd) by key, using a radix sort (see above).
+template <typename taType, typename taGetKey = Details::RadixKeyIdentity>
+void gRadixSort(taType* inBegin, taType* inEnd, taGetKey inGetKey = {})
+{
+	using Key = RemoveCV<RemoveReference<decltype(inGetKey(*inBegin))>>;
+	static_assert(Details::cIsRadixKey<Key> || Details::cIsStringKey<Key>, "Keys must be integers, floats or strings");
+
+	int size = (int)(inEnd - inBegin);
+
+	if constexpr (Details::cIsStringKey<Key>)
+	{
+		Details::MultikeyQuickSort(inBegin, size, 0, inGetKey);
+	}
+	else
+	{
+		if (size <= Details::cRadixSortThreshold)
+		{
+			auto less_key = [&inGetKey](const taType& inA, const taType& inB) { return Details::ToRadixKey(inGetKey(inA)) < Details::ToRadixKey(inGetKey(inB)); };
+			Details::InsertionSort(inBegin, inEnd, less_key);
+			return;
+		}
+
+		Details::RadixSortLSD(inBegin, size, inGetKey);
+	}
+}
+
+
+// Sort a container by key, using a radix sort (see above).
+template <typename taContainer, typename taGetKey = Details::RadixKeyIdentity>
+requires cIsRadixSortable<taContainer, taGetKey>
+void gRadixSort(taContainer&& ioContainer, taGetKey inGetKey = {})
+{
+	Span span(ioContainer);
+	gRadixSort(span.Begin(), span.End(), inGetKey);
+}
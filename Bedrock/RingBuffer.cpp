@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/RingBuffer.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/String.h>
+#include <Bedrock/StringFormat.h>
+
+
+REGISTER_TEST("RingBuffer")
+{
+	RingBuffer<int> test;
+	TEST_TRUE(test.Empty());
+
+	// FIFO.
+	for (int i = 0; i < 5; ++i)
+		test.PushBack(i);
+
+	TEST_TRUE(test.Size() == 5);
+	TEST_TRUE(test.Capacity() == 8);
+	TEST_TRUE(test.Front() == 0);
+	TEST_TRUE(test.Back() == 4);
+
+	test.PopFront();
+	test.PopFront();
+	TEST_TRUE(test.Front() == 2);
+
+	// Wrap around without growing.
+	for (int i = 5; i < 10; ++i)
+		test.PushBack(i);
+
+	TEST_TRUE(test.Size() == 8);
+	TEST_TRUE(test.Capacity() == 8);
+	TEST_TRUE(test.GetFirstSpan().Size() == 6);
+	TEST_TRUE(test.GetSecondSpan().Size() == 2);
+	TEST_TRUE(test.GetSecondSpan()[0] == 8);
+
+	int expected = 2;
+	bool all_equal = true;
+	for (int value : test)
+		all_equal &= (value == expected++);
+	TEST_TRUE(all_equal);
+
+	// Grow while wrapped around, order is kept.
+	test.PushBack(10);
+	TEST_TRUE(test.Capacity() == 16);
+	TEST_TRUE(test.Size() == 9);
+
+	all_equal = true;
+	for (int i = 0; i < test.Size(); ++i)
+		all_equal &= (test[i] == i + 2);
+	TEST_TRUE(all_equal);
+
+	// Deque operations.
+	test.PushFront(1);
+	test.PushFront(0);
+	TEST_TRUE(test.Front() == 0);
+	TEST_TRUE(test[2] == 2);
+	test.PopBack();
+	TEST_TRUE(test.Back() == 9);
+
+	// Bulk operations.
+	int values[] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+	test.PopFront(8);
+	TEST_TRUE(test.Front() == 8);
+	test.PushBack(values);
+	TEST_TRUE(test.Size() == 10);
+	TEST_TRUE(test.GetFirstSpan().Size() + test.GetSecondSpan().Size() == 10);
+	TEST_TRUE(test.Back() == 17);
+
+	RingBuffer<int> copy = test;
+	TEST_TRUE(copy.Size() == test.Size());
+	TEST_TRUE(copy.GetFirstSpan().Size() == 10);
+	TEST_TRUE(copy[9] == 17);
+
+	RingBuffer<int> moved = gMove(copy);
+	TEST_TRUE(moved.Size() == 10);
+	TEST_TRUE(copy.Empty());
+};
+
+
+REGISTER_TEST("RingBuffer NonTrivial")
+{
+	RingBuffer<String> test;
+
+	// Keep a sliding window of the last 5 values, which wraps around many times.
+	for (int i = 0; i < 100; ++i)
+	{
+		test.PushBack(gTempFormat("%d", i));
+		if (test.Size() > 5)
+			test.PopFront();
+	}
+
+	TEST_TRUE(test.Size() == 5);
+	TEST_TRUE(test.Capacity() == 8);
+	TEST_TRUE(test.Front() == "95");
+	TEST_TRUE(test.Back() == "99");
+
+	// Grow while wrapped around.
+	test.PushFront("94");
+	test.PushFront("93");
+	test.PushFront("92");
+	test.PushFront("91");
+	TEST_TRUE(test.Capacity() == 16);
+	TEST_TRUE(test.Front() == "91");
+	TEST_TRUE(test[8] == "99");
+
+	RingBuffer<String> copy = test;
+	TEST_TRUE(copy[4] == "95");
+
+	test.PopFront(3);
+	TEST_TRUE(test.Front() == "94");
+};
+
+
+REGISTER_TEST("FixedRingBuffer")
+{
+	FixedRingBuffer<int, 16> test;
+	TEST_TRUE(test.MaxSize() == 16);
+
+	int* data = nullptr;
+	for (int i = 0; i < 16; ++i)
+	{
+		test.PushBack(i);
+		if (i == 0)
+			data = &test.Front();
+	}
+
+	// Grew in place in the fixed buffer.
+	TEST_TRUE(test.Capacity() == 16);
+	TEST_TRUE(&test[0] == data);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		test.PopFront();
+		test.PushBack(16 + i);
+	}
+
+	TEST_TRUE(test.Front() == 100);
+	TEST_TRUE(test.Back() == 115);
+};
+
+
+REGISTER_TEST("TempRingBuffer")
+{
+	TempRingBuffer<int> test;
+	test.PushBack(1);
+	test.PushBack(2);
+	test.PopFront();
+	test.PushBack(3);
+	test.PushBack(4); // Wraps around, then grows in place.
+	TEST_TRUE(gTempMemArena.Owns(&test.Front()));
+	TEST_TRUE(test.Front() == 2);
+	TEST_TRUE(test.Back() == 4);
+	TEST_TRUE(test.Size() == 3);
+};
@@ -0,0 +1,427 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/TypeTraits.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Span.h>
+#include <Bedrock/PlacementNew.h>
+
+
+// Double-ended queue stored in a circular buffer. Adding and removing elements at either end is O(1).
+// The capacity is always a power of 2, so that wrapping around is just a mask.
+// The elements are in up to two contiguous parts, see GetFirstSpan and GetSecondSpan.
+template <typename taType, typename taAllocator = DefaultAllocator<taType>>
+struct RingBuffer : private taAllocator
+{
+	static_assert(!cIsConst<taType>);
+
+	using ValueType = taType;
+	using Allocator = taAllocator;
+
+	// Default
+	constexpr RingBuffer() = default;
+	~RingBuffer();
+
+	// Default with Allocator
+	constexpr explicit RingBuffer(Allocator&& inAllocator) : Allocator(gMove(inAllocator)) {}
+
+	// Move
+	RingBuffer(RingBuffer&& ioOther);
+	RingBuffer& operator=(RingBuffer&& ioOther);
+
+	// Copy
+	RingBuffer(const RingBuffer& inOther);
+	RingBuffer& operator=(const RingBuffer& inOther);
+
+	int Size() const { return mSize; }
+	int Capacity() const { return mCapacity; }
+	bool Empty() const { return mSize == 0; }
+
+	static constexpr bool cHasMaxSize = requires { taAllocator().MaxSize(); };
+
+	// Return the max size that this ring buffer can have.
+	// Note: This method only exists for allocators that have an actual max size.
+	int MaxSize() const requires cHasMaxSize
+	{
+		return GetAllocator().MaxSize();
+	}
+
+	const Allocator& GetAllocator() const { return *this; }
+	Allocator&       GetAllocator() { return *this; }
+
+	// Access elements in order from the front (index 0) to the back (index Size() - 1).
+	taType&       operator[](int inIndex)		{ gBoundsCheck(inIndex, mSize); return mData[(mHead + inIndex) & (mCapacity - 1)]; }
+	const taType& operator[](int inIndex) const	{ gBoundsCheck(inIndex, mSize); return mData[(mHead + inIndex) & (mCapacity - 1)]; }
+
+	taType&       Front()		{ return operator[](0); }
+	taType&       Back()		{ return operator[](mSize - 1); }
+	const taType& Front() const	{ return operator[](0); }
+	const taType& Back() const	{ return operator[](mSize - 1); }
+
+	// The elements are stored in two contiguous parts: the first span starts at the front, the second one (possibly empty) ends at the back.
+	Span<taType>       GetFirstSpan()			{ return { mData + mHead, gMin(mSize, mCapacity - mHead) }; }
+	Span<taType>       GetSecondSpan()			{ return { mData, gMax(mHead + mSize - mCapacity, 0) }; }
+	Span<const taType> GetFirstSpan() const		{ return { mData + mHead, gMin(mSize, mCapacity - mHead) }; }
+	Span<const taType> GetSecondSpan() const	{ return { mData, gMax(mHead + mSize - mCapacity, 0) }; }
+
+	void Clear();
+	void ClearAndFreeMemory();
+	void Reserve(int inCapacity);	// Note: The capacity is rounded up to a power of 2.
+
+	void PushBack(const taType& inValue)	{ EmplaceBack(inValue); }
+	void PushBack(taType&& inValue)			{ EmplaceBack(gMove(inValue)); }
+	void PushBack(Span<const taType> inValues);
+	template <typename... taArgs>
+	taType& EmplaceBack(taArgs&&... inArgs);
+
+	void PushFront(const taType& inValue)	{ EmplaceFront(inValue); }
+	void PushFront(taType&& inValue)		{ EmplaceFront(gMove(inValue)); }
+	template <typename... taArgs>
+	taType& EmplaceFront(taArgs&&... inArgs);
+
+	void PopBack();
+	void PopFront();
+	void PopFront(int inCount);
+
+	template <typename taValueType>
+	struct IteratorBase
+	{
+		taValueType& operator*() const							{ return mData[mIndex & mMask]; }
+		IteratorBase& operator++()								{ mIndex++; return *this; }
+		bool operator!=(const IteratorBase& inOther) const		{ return mIndex != inOther.mIndex; }
+
+		taValueType* mData;
+		int          mMask;
+		int          mIndex; // Not wrapped around, the mask is applied when dereferencing.
+	};
+
+	using Iterator      = IteratorBase<taType>;
+	using ConstIterator = IteratorBase<const taType>;
+
+	Iterator      begin()		{ return { mData, mCapacity - 1, mHead }; }
+	Iterator      end()			{ return { mData, mCapacity - 1, mHead + mSize }; }
+	ConstIterator begin() const	{ return { mData, mCapacity - 1, mHead }; }
+	ConstIterator end() const	{ return { mData, mCapacity - 1, mHead + mSize }; }
+
+private:
+	// Move-construct inCount elements from inSource into inDest and destroy the source elements (or memcpy them if possible).
+	static void RelocateElements(taType* inDest, taType* inSource, int inCount);
+	// Copy-construct inCount elements from inSource into inDest.
+	static void CopyElements(taType* inDest, const taType* inSource, int inCount);
+
+	void MoveFrom(RingBuffer&& ioOther);
+	void CopyFrom(const RingBuffer& inOther);
+	void Grow(int inCapacity);
+
+	taType* mData     = nullptr;
+	int     mHead     = 0;	// Index of the front element in mData.
+	int     mSize     = 0;
+	int     mCapacity = 0;	// Always 0 or a power of 2.
+};
+
+
+// Alias for a RingBuffer using the TempAllocator.
+// Resizable cheaply as long as it's the last Temp allocation. Allocates from the heap as a fallback.
+template <typename taType>
+using TempRingBuffer = RingBuffer<taType, TempAllocator<taType>>;
+
+// Alias for a RingBuffer using the ArenaAllocator.
+// A MemArena needs to be passed to the RingBuffer before it can be used.
+template <typename taType>
+using ArenaRingBuffer = RingBuffer<taType, ArenaAllocator<taType>>;
+
+// Alias for a RingBuffer using a FixedAllocator.
+// It contains a fixed size buffer large enough to store taSize elements. taSize must be a power of 2.
+template <typename taType, int taSize>
+requires (gIsPow2(taSize))
+using FixedRingBuffer = RingBuffer<taType, FixedAllocator<taType, taSize>>;
+
+
+// RingBuffers can be relocated with a memcpy if their allocator can (the elements themselves are not moved).
+template<class taType, typename taAllocator> inline constexpr bool cIsTriviallyRelocatable<RingBuffer<taType, taAllocator>> = cIsTriviallyRelocatable<taAllocator>;
+
+
+template <typename taType, typename taAllocator>
+RingBuffer<taType, taAllocator>::~RingBuffer()
+{
+	ClearAndFreeMemory();
+}
+
+
+template <typename taType, typename taAllocator>
+RingBuffer<taType, taAllocator>::RingBuffer(RingBuffer&& ioOther)
+{
+	MoveFrom(gMove(ioOther));
+}
+
+
+template <typename taType, typename taAllocator>
+RingBuffer<taType, taAllocator>& RingBuffer<taType, taAllocator>::operator=(RingBuffer&& ioOther)
+{
+	MoveFrom(gMove(ioOther));
+	return *this;
+}
+
+
+template <typename taType, typename taAllocator>
+RingBuffer<taType, taAllocator>::RingBuffer(const RingBuffer& inOther)
+{
+	CopyFrom(inOther);
+}
+
+
+template <typename taType, typename taAllocator>
+RingBuffer<taType, taAllocator>& RingBuffer<taType, taAllocator>::operator=(const RingBuffer& inOther)
+{
+	CopyFrom(inOther);
+	return *this;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::Clear()
+{
+	for (taType& element : GetFirstSpan())
+		element.~taType();
+	for (taType& element : GetSecondSpan())
+		element.~taType();
+
+	mHead = 0;
+	mSize = 0;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::ClearAndFreeMemory()
+{
+	Clear();
+
+	if (mData != nullptr)
+	{
+		Allocator::Free(mData, mCapacity);
+		mData     = nullptr;
+		mCapacity = 0;
+	}
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::Reserve(int inCapacity)
+{
+	if (mCapacity >= inCapacity)
+		return;
+
+	int new_capacity = (int)gGetNextPow2(inCapacity);
+
+	// Try to grow the allocation.
+	if (mData != nullptr && Allocator::TryRealloc(mData, mCapacity, new_capacity))
+	{
+		// If the elements wrap around, move the second part after the first one.
+		// The capacity at least doubled, so there is enough room.
+		int second_size = GetSecondSpan().Size();
+		RelocateElements(mData + mCapacity, mData, second_size);
+
+		mCapacity = new_capacity;
+		return;
+	}
+
+	// Allocate new data and move the elements there, with the front element first.
+	taType* new_data = Allocator::Allocate(new_capacity);
+
+	if (mData != nullptr)
+	{
+		Span<taType> first_span  = GetFirstSpan();
+		Span<taType> second_span = GetSecondSpan();
+		RelocateElements(new_data, first_span.Data(), first_span.Size());
+		RelocateElements(new_data + first_span.Size(), second_span.Data(), second_span.Size());
+
+		Allocator::Free(mData, mCapacity);
+	}
+
+	mData     = new_data;
+	mHead     = 0;
+	mCapacity = new_capacity;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::PushBack(Span<const taType> inValues)
+{
+	// Copying from self is not allowed.
+	gAssert(inValues.End() <= mData || inValues.Begin() >= (mData + mCapacity) || inValues.Empty());
+
+	Grow(mSize + inValues.Size());
+
+	// Copy in up to two contiguous parts.
+	int tail        = (mHead + mSize) & (mCapacity - 1);
+	int first_count = gMin(inValues.Size(), mCapacity - tail);
+	CopyElements(mData + tail, inValues.Data(), first_count);
+	CopyElements(mData, inValues.Data() + first_count, inValues.Size() - first_count);
+
+	mSize += inValues.Size();
+}
+
+
+template <typename taType, typename taAllocator>
+template <typename ... taArgs>
+taType& RingBuffer<taType, taAllocator>::EmplaceBack(taArgs&&... inArgs)
+{
+	Grow(mSize + 1);
+
+	taType& back = mData[(mHead + mSize) & (mCapacity - 1)];
+
+	gPlacementNew(back, gForward<taArgs>(inArgs)...);
+	mSize++;
+
+	return back;
+}
+
+
+template <typename taType, typename taAllocator>
+template <typename ... taArgs>
+taType& RingBuffer<taType, taAllocator>::EmplaceFront(taArgs&&... inArgs)
+{
+	Grow(mSize + 1);
+
+	int     head  = (mHead - 1) & (mCapacity - 1);
+	taType& front = mData[head];
+
+	gPlacementNew(front, gForward<taArgs>(inArgs)...);
+	mHead = head;
+	mSize++;
+
+	return front;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::PopBack()
+{
+	gAssert(mSize >= 1);
+	Back().~taType();
+	mSize--;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::PopFront()
+{
+	gAssert(mSize >= 1);
+	Front().~taType();
+	mHead = (mHead + 1) & (mCapacity - 1);
+	mSize--;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::PopFront(int inCount)
+{
+	gAssert(inCount >= 0 && inCount <= mSize);
+
+	if constexpr (!cIsTriviallyDestructible<taType>)
+	{
+		for (int i = 0; i < inCount; ++i)
+			operator[](i).~taType();
+	}
+
+	if (inCount != 0)
+		mHead = (mHead + inCount) & (mCapacity - 1);
+	mSize -= inCount;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::RelocateElements(taType* inDest, taType* inSource, int inCount)
+{
+	if constexpr (cIsTriviallyRelocatable<taType>)
+	{
+		if (inCount != 0)
+			gMemCopy(inDest, inSource, inCount * (int64)sizeof(taType));
+	}
+	else
+	{
+		for (int i = 0; i < inCount; ++i)
+		{
+			gPlacementNew(inDest[i], gMove(inSource[i]));
+			inSource[i].~taType();
+		}
+	}
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::CopyElements(taType* inDest, const taType* inSource, int inCount)
+{
+	if constexpr (cIsTriviallyCopyable<taType>)
+	{
+		if (inCount != 0)
+			gMemCopy(inDest, inSource, inCount * (int64)sizeof(taType));
+	}
+	else
+	{
+		for (int i = 0; i < inCount; ++i)
+			gPlacementNew(inDest[i], inSource[i]);
+	}
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::MoveFrom(RingBuffer&& ioOther)
+{
+	// Moving from self is not allowed.
+	gAssert(mData != ioOther.mData || mData == nullptr);
+
+	// Clear the current data.
+	ClearAndFreeMemory();
+
+	// Move the allocator.
+	GetAllocator() = gMove(ioOther.GetAllocator());
+	ioOther.GetAllocator() = Allocator();
+
+	// Move the data.
+	mData     = ioOther.mData;
+	mHead     = ioOther.mHead;
+	mSize     = ioOther.mSize;
+	mCapacity = ioOther.mCapacity;
+
+	ioOther.mData     = nullptr;
+	ioOther.mHead     = 0;
+	ioOther.mSize     = 0;
+	ioOther.mCapacity = 0;
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::CopyFrom(const RingBuffer& inOther)
+{
+	// Copying from self is not allowed.
+	gAssert(mData != inOther.mData || mData == nullptr);
+
+	// Note: Currently the allocator of inOther is never copied (same as Vector).
+
+	Clear();
+	PushBack(inOther.GetFirstSpan());
+	PushBack(inOther.GetSecondSpan());
+}
+
+
+template <typename taType, typename taAllocator>
+void RingBuffer<taType, taAllocator>::Grow(int inCapacity)
+{
+	if (mCapacity >= inCapacity) [[likely]]
+		return;
+
+	// Grow by 100% (Reserve rounds up to a power of 2 anyway).
+	int new_capacity = mCapacity * 2;
+
+	// If the allocator has max size, make sure we don't accidentally go over it.
+	if constexpr (cHasMaxSize)
+		new_capacity = gMin(new_capacity, MaxSize());
+
+	// Make sure we get at least the requested capacity.
+	// If this goes above max size, it'll fail to allocate (as expected).
+	new_capacity = gMax(new_capacity, inCapacity);
+
+	Reserve(new_capacity);
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/SPSCQueue.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Thread.h>
+#include <Bedrock/String.h>
+
+
+REGISTER_TEST("SPSCQueue")
+{
+	SPSCQueue<int> queue(6);
+	TEST_TRUE(queue.Capacity() == 8);
+
+	int value = 0;
+	TEST_FALSE(queue.TryPop(value));
+
+	for (int i = 0; i < 8; ++i)
+		TEST_TRUE(queue.TryPush(i));
+	TEST_FALSE(queue.TryPush(8));
+	TEST_TRUE(queue.SizeApprox() == 8);
+
+	TEST_TRUE(queue.TryPop(value));
+	TEST_TRUE(value == 0);
+	TEST_TRUE(queue.TryPush(8)); // Wraps around.
+
+	// Batches.
+	int values[16] = {};
+	TEST_TRUE(queue.TryPopN(values) == 8);
+	TEST_TRUE(values[0] == 1);
+	TEST_TRUE(values[7] == 8);
+	TEST_TRUE(queue.TryPopN(values) == 0);
+
+	int to_push[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+	TEST_TRUE(queue.TryPushN(to_push) == 8);
+	TEST_TRUE(queue.TryPushN(to_push) == 0);
+	TEST_TRUE(queue.TryPopN(Span(values, 3)) == 3);
+	TEST_TRUE(values[2] == 12);
+	TEST_TRUE(queue.TryPushN(to_push) == 3);
+	TEST_TRUE(queue.SizeApprox() == 8);
+};
+
+
+REGISTER_TEST("SPSCQueue NonTrivial")
+{
+	// Elements left in the queue are destroyed with it. Leak detection will tell.
+	SPSCQueue<String> queue(4);
+	TEST_TRUE(queue.TryPush("a long enough string to allocate"));
+	TEST_TRUE(queue.TryEmplace("another long enough string to allocate"));
+
+	String value;
+	TEST_TRUE(queue.TryPop(value));
+	TEST_TRUE(value == "a long enough string to allocate");
+};
+
+
+REGISTER_TEST("SPSCQueue Threads")
+{
+	constexpr int  cCount = 100'000;
+	SPSCQueue<int> queue(1024);
+
+	bool in_order = true;
+	{
+		Thread consumer;
+		consumer.Create({ .mName = "SPSCConsumer" }, [&queue, &in_order](Thread&)
+		{
+			int expected = 0;
+			int values[64];
+			while (expected < cCount)
+			{
+				int count = queue.TryPopN(values);
+				for (int i = 0; i < count; ++i)
+					in_order &= (values[i] == expected++);
+
+				if (count == 0)
+					gThreadYield();
+			}
+		});
+
+		for (int i = 0; i < cCount; ++i)
+		{
+			while (!queue.TryPush(i))
+				gThreadYield();
+		}
+	}
+
+	TEST_TRUE(in_order);
+	TEST_TRUE(queue.SizeApprox() == 0);
+};
+
+
+REGISTER_TEST("BlockingSPSCQueue")
+{
+	constexpr int          cCount = 100'000;
+	BlockingSPSCQueue<int> queue(16);
+
+	int64 sum = 0;
+	{
+		Thread consumer;
+		consumer.Create({ .mName = "SPSCConsumer" }, [&queue, &sum](Thread&)
+		{
+			for (int i = 0; i < cCount; ++i)
+			{
+				int value;
+				queue.Pop(value);
+				sum += value;
+			}
+		});
+
+		for (int i = 0; i < cCount; ++i)
+			queue.Push(i);
+	}
+
+	TEST_TRUE(sum == (int64)cCount * (cCount - 1) / 2);
+};
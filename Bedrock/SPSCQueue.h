@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Atomic.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Span.h>
+#include <Bedrock/Event.h>
+#include <Bedrock/PlacementNew.h>
+
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// The Push functions must only be called by the producer, the Pop functions only by the consumer.
+// Head and tail are on separate cache lines, and each side keeps a cached copy of the other side's index so that it only
+// reads the shared index when the queue looks full (producer) or empty (consumer).
+// See BlockingSPSCQueue for a version that can wait.
+template <typename taType, typename taAllocator = DefaultAllocator<taType>>
+struct SPSCQueue : NoCopy, private taAllocator
+{
+	using ValueType = taType;
+	using Allocator = taAllocator;
+
+	// inCapacity is rounded up to a power of 2.
+	explicit SPSCQueue(int inCapacity, Allocator&& inAllocator = {});
+	~SPSCQueue();
+
+	int Capacity() const { return mCapacity; }
+
+	// Return the number of elements in the queue. Only exact when called from the producer or consumer while the other side is idle.
+	int SizeApprox() const { return (int)(mTail.Load(MemoryOrder::Relaxed) - mHead.Load(MemoryOrder::Relaxed)); }
+
+	// Add an element. Return false if the queue is full. Producer only.
+	bool TryPush(const taType& inValue)	{ return TryEmplace(inValue); }
+	bool TryPush(taType&& inValue)		{ return TryEmplace(gMove(inValue)); }
+	template <typename... taArgs>
+	bool TryEmplace(taArgs&&... inArgs);
+
+	// Add as many elements of inValues as possible, return how many were added. Producer only.
+	int  TryPushN(Span<const taType> inValues);
+
+	// Remove the front element and move it into outValue. Return false if the queue is empty. Consumer only.
+	bool TryPop(taType& outValue);
+
+	// Remove up to outValues.Size() elements and move them into outValues, return how many were removed. Consumer only.
+	int  TryPopN(Span<taType> outValues);
+
+private:
+	// Read-only after construction.
+	taType*     mData     = nullptr;
+	int         mCapacity = 0;
+
+	// Written by the producer.
+	alignas(cCacheLineSize)
+	AtomicInt64 mTail       = 0;
+	int64       mCachedHead = 0;	// Last value of mHead seen by the producer.
+
+	// Written by the consumer.
+	alignas(cCacheLineSize)
+	AtomicInt64 mHead       = 0;
+	int64       mCachedTail = 0;	// Last value of mTail seen by the consumer.
+};
+
+
+// SPSCQueue with blocking Push and Pop. They wait on an Event when the queue is full or empty.
+// The non-blocking functions can be used as well.
+// Each push and pop costs an extra interlocked operation, to check whether the other side is waiting.
+template <typename taType, typename taAllocator = DefaultAllocator<taType>>
+struct BlockingSPSCQueue : NoCopy
+{
+	using ValueType = taType;
+	using Allocator = taAllocator;
+
+	explicit BlockingSPSCQueue(int inCapacity, Allocator&& inAllocator = {}) : mQueue(inCapacity, gMove(inAllocator)) {}
+
+	int  Capacity() const	{ return mQueue.Capacity(); }
+	int  SizeApprox() const	{ return mQueue.SizeApprox(); }
+
+	// Producer only.
+	bool TryPush(const taType& inValue)			{ return OnPushed(mQueue.TryPush(inValue)); }
+	bool TryPush(taType&& inValue)				{ return OnPushed(mQueue.TryPush(gMove(inValue))); }
+	int  TryPushN(Span<const taType> inValues)	{ return OnPushed(mQueue.TryPushN(inValues)); }
+	void Push(const taType& inValue)			{ PushWait([&] { return mQueue.TryPush(inValue); }); }
+	void Push(taType&& inValue)					{ PushWait([&] { return mQueue.TryPush(gMove(inValue)); }); }
+
+	// Consumer only.
+	bool TryPop(taType& outValue)				{ return OnPopped(mQueue.TryPop(outValue)); }
+	int  TryPopN(Span<taType> outValues)		{ return OnPopped(mQueue.TryPopN(outValues)); }
+	void Pop(taType& outValue)					{ PopWait([&] { return mQueue.TryPop(outValue); }); }
+
+	// Wait until at least one element is available, then pop as many as possible (up to outValues.Size()). Return how many were popped.
+	int  PopN(Span<taType> outValues)			{ int count = 0; PopWait([&] { count = mQueue.TryPopN(outValues); return count != 0; }); return count; }
+
+private:
+	// Wake up the other side if it is waiting.
+	// Note: Exchange is a full barrier, it can't be reordered with the index update that was just done by the queue.
+	template <typename T> T OnPushed(T inResult)	{ if (inResult && mConsumerWaiting.Exchange(false)) mItemsAvailable.Set(); return inResult; }
+	template <typename T> T OnPopped(T inResult)	{ if (inResult && mProducerWaiting.Exchange(false)) mSpaceAvailable.Set(); return inResult; }
+
+	template <typename taFunc> void PushWait(taFunc&& inTryPush);
+	template <typename taFunc> void PopWait(taFunc&& inTryPop);
+
+	SPSCQueue<taType, taAllocator> mQueue;
+	AtomicBool                     mProducerWaiting = false;
+	AtomicBool                     mConsumerWaiting = false;
+	Event                          mSpaceAvailable  = { Event::AutoReset };
+	Event                          mItemsAvailable  = { Event::AutoReset };
+};
+
+
+template <typename taType, typename taAllocator>
+SPSCQueue<taType, taAllocator>::SPSCQueue(int inCapacity, Allocator&& inAllocator)
+	: Allocator(gMove(inAllocator))
+{
+	gAssert(inCapacity > 0);
+
+	mCapacity = (int)gGetNextPow2(inCapacity);
+	mData     = Allocator::Allocate(mCapacity);
+}
+
+
+template <typename taType, typename taAllocator>
+SPSCQueue<taType, taAllocator>::~SPSCQueue()
+{
+	// Destroy the elements that were not popped.
+	if constexpr (!cIsTriviallyDestructible<taType>)
+	{
+		for (int64 i = mHead.Load(MemoryOrder::Relaxed), end = mTail.Load(MemoryOrder::Relaxed); i < end; ++i)
+			mData[i & (mCapacity - 1)].~taType();
+	}
+
+	Allocator::Free(mData, mCapacity);
+}
+
+
+template <typename taType, typename taAllocator>
+template <typename ... taArgs>
+bool SPSCQueue<taType, taAllocator>::TryEmplace(taArgs&&... inArgs)
+{
+	int64 tail = mTail.Load(MemoryOrder::Relaxed); // Only the producer writes mTail.
+
+	if (tail - mCachedHead == mCapacity) [[unlikely]]
+	{
+		// Looks full, check again with the real head.
+		mCachedHead = mHead.Load(MemoryOrder::Acquire);
+		if (tail - mCachedHead == mCapacity)
+			return false;
+	}
+
+	gPlacementNew(mData[tail & (mCapacity - 1)], gForward<taArgs>(inArgs)...);
+
+	// Publish the element.
+	mTail.Store(tail + 1, MemoryOrder::Release);
+	return true;
+}
+
+
+template <typename taType, typename taAllocator>
+int SPSCQueue<taType, taAllocator>::TryPushN(Span<const taType> inValues)
+{
+	int64 tail = mTail.Load(MemoryOrder::Relaxed); // Only the producer writes mTail.
+
+	if (tail - mCachedHead + inValues.Size() > mCapacity)
+		mCachedHead = mHead.Load(MemoryOrder::Acquire);
+
+	int count = gMin(inValues.Size(), (int)(mCapacity - (tail - mCachedHead)));
+
+	for (int i = 0; i < count; ++i)
+		gPlacementNew(mData[(tail + i) & (mCapacity - 1)], inValues[i]);
+
+	// Publish all the elements at once.
+	if (count != 0)
+		mTail.Store(tail + count, MemoryOrder::Release);
+
+	return count;
+}
+
+
+template <typename taType, typename taAllocator>
+bool SPSCQueue<taType, taAllocator>::TryPop(taType& outValue)
+{
+	int64 head = mHead.Load(MemoryOrder::Relaxed); // Only the consumer writes mHead.
+
+	if (head == mCachedTail) [[unlikely]]
+	{
+		// Looks empty, check again with the real tail.
+		mCachedTail = mTail.Load(MemoryOrder::Acquire);
+		if (head == mCachedTail)
+			return false;
+	}
+
+	taType& element = mData[head & (mCapacity - 1)];
+	outValue = gMove(element);
+	element.~taType();
+
+	// Give the slot back to the producer.
+	mHead.Store(head + 1, MemoryOrder::Release);
+	return true;
+}
+
+
+template <typename taType, typename taAllocator>
+int SPSCQueue<taType, taAllocator>::TryPopN(Span<taType> outValues)
+{
+	int64 head = mHead.Load(MemoryOrder::Relaxed); // Only the consumer writes mHead.
+
+	if (mCachedTail - head < outValues.Size())
+		mCachedTail = mTail.Load(MemoryOrder::Acquire);
+
+	int count = gMin(outValues.Size(), (int)(mCachedTail - head));
+
+	for (int i = 0; i < count; ++i)
+	{
+		taType& element = mData[(head + i) & (mCapacity - 1)];
+		outValues[i] = gMove(element);
+		element.~taType();
+	}
+
+	// Give all the slots back at once.
+	if (count != 0)
+		mHead.Store(head + count, MemoryOrder::Release);
+
+	return count;
+}
+
+
+template <typename taType, typename taAllocator>
+template <typename taFunc>
+void BlockingSPSCQueue<taType, taAllocator>::PushWait(taFunc&& inTryPush)
+{
+	while (!OnPushed(inTryPush()))
+	{
+		// Tell the consumer we're waiting, then check again in case it popped something in the meantime.
+		mProducerWaiting.Store(true);
+		if (OnPushed(inTryPush()))
+			return;
+
+		mSpaceAvailable.Wait();
+	}
+}
+
+
+template <typename taType, typename taAllocator>
+template <typename taFunc>
+void BlockingSPSCQueue<taType, taAllocator>::PopWait(taFunc&& inTryPop)
+{
+	while (!OnPopped(inTryPop()))
+	{
+		// Tell the producer we're waiting, then check again in case it pushed something in the meantime.
+		mConsumerWaiting.Store(true);
+		if (OnPopped(inTryPop()))
+			return;
+
+		mItemsAvailable.Wait();
+	}
+}
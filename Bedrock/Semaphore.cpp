@@ -2,12 +2,24 @@
 #include <Bedrock/Semaphore.h>
 #include <Bedrock/Test.h>
 
+#if defined(_WIN32)
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <Bedrock/Ticks.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#else
+#error Unknown platform
+#endif
 
 
+#if defined(_WIN32)
+
 Semaphore::Semaphore(int inInitialCount, int inMaxCount)
 {
 	mOSSemaphore = CreateSemaphoreA(nullptr, inInitialCount, inMaxCount, nullptr);
@@ -52,6 +64,90 @@ void Semaphore::Release(int inCount)
 }
 
 
+#elif defined(__linux__)
+
+// Wait until the count of the semaphore eventfd is non-zero and decrement it. A negative timeout means infinite.
+static bool sAcquire(int inFD, int inTimeoutMs)
+{
+	int64 end_ticks  = gGetTickCount() + gMillisecondsToTicks(inTimeoutMs);
+	int   timeout_ms = inTimeoutMs;
+
+	while (true)
+	{
+		// With EFD_SEMAPHORE, a read decrements the count by one (or fails if it's zero).
+		uint64 value;
+		if (read(inFD, &value, sizeof(value)) == sizeof(value))
+			return true;
+
+		gAssert(errno == EAGAIN);
+
+		if (timeout_ms == 0)
+			return false;
+
+		pollfd poll_fd = { .fd = inFD, .events = POLLIN };
+		int    ret     = poll(&poll_fd, 1, timeout_ms);
+
+		if (ret == 0)
+			return false; // Timeout.
+
+		gAssert(ret > 0 || errno == EINTR);
+
+		// Another thread may acquire it first, wait again for what's left of the timeout.
+		if (timeout_ms > 0)
+			timeout_ms = gMax(0, (int)gTicksToMilliseconds(end_ticks - gGetTickCount()));
+	}
+}
+
+
+Semaphore::Semaphore(int inInitialCount, int inMaxCount)
+{
+	// Note: eventfd has no max count, it's only checked in Release.
+	int fd = eventfd(inInitialCount, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+	gAssert(fd >= 0);
+
+	mOSSemaphore = (OSSemaphore)(int64)fd;
+	mMaxCount    = inMaxCount;
+}
+
+
+Semaphore::~Semaphore()
+{
+	int result = close((int)(int64)mOSSemaphore);
+	gAssert(result == 0);
+}
+
+
+bool Semaphore::TryAcquire()
+{
+	return TryAcquireFor(0_NS);
+}
+
+
+bool Semaphore::TryAcquireFor(NanoSeconds inTimeout)
+{
+	return sAcquire((int)(int64)mOSSemaphore, (int)gToMilliSeconds(inTimeout));
+}
+
+
+void Semaphore::Acquire()
+{
+	bool success = sAcquire((int)(int64)mOSSemaphore, -1);
+	gAssert(success);
+}
+
+
+void Semaphore::Release(int inCount)
+{
+	gAssert(inCount > 0);
+	gAssert(inCount <= mMaxCount); // Going above the max count. Note: Only checks inCount since the current count can't be read.
+
+	uint64  value  = inCount;
+	ssize_t result = write((int)(int64)mOSSemaphore, &value, sizeof(value));
+	gAssert(result == sizeof(value));
+}
+
+#endif
+
 REGISTER_TEST("Semaphore")
 {
 	Semaphore sema(0, 2);
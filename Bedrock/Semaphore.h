@@ -23,4 +23,7 @@ struct Semaphore : NoCopy
 private:
 
 	OSSemaphore mOSSemaphore = {};
+#ifndef _WIN32
+	int         mMaxCount    = 0; // Windows semaphores know their own max count, eventfds don't.
+#endif
 };
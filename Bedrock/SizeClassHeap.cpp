@@ -0,0 +1,554 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/SizeClassHeap.h>
+#include <Bedrock/Array.h>
+#include <Bedrock/Mutex.h>
+#include <Bedrock/MemoryStats.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Thread.h>
+
+#include <stdlib.h>
+
+
+// Size classes are 16 bytes apart up to 128 bytes, then there are 4 classes per power of 2 (160, 192, 224, 256, 320, etc.).
+// This keeps the internal fragmentation under 25%.
+constexpr int cNumLinearSizeClasses = 8;
+constexpr int cLinearSizeClassStep  = 16;
+constexpr int cLinearSizeClassMax   = cNumLinearSizeClasses * cLinearSizeClassStep;
+constexpr int cSizeClassesPerPow2   = 4;
+constexpr int cNumSizeClasses       = cNumLinearSizeClasses + (15 - 7) * cSizeClassesPerPow2;
+
+constexpr int64 cSpanSize           = 256_KiB; // Size of the blocks of virtual memory that are split into allocations of a single size class.
+constexpr int64 cRegionSize         = 1_GiB;   // Size of the virtual memory reservations that spans are committed from.
+constexpr int   cBatchSizeInBytes   = 16_KiB;  // Number of bytes moved between a thread cache and the central pool at once.
+constexpr int   cMinBatchSize       = 2;
+constexpr int   cMaxBatchSize       = 64;
+
+
+constexpr int sGetSizeClass(int64 inSize)
+{
+	if (inSize <= cLinearSizeClassMax)
+		return (int)gMax<int64>((inSize + cLinearSizeClassStep - 1) / cLinearSizeClassStep - 1, 0);
+
+	uint64 value    = (uint64)inSize - 1;
+	int    log2     = 63 - gCountLeadingZeros64(value);
+	int    sub_step = (int)(value >> (log2 - 2)) & (cSizeClassesPerPow2 - 1);
+	return cNumLinearSizeClasses + (log2 - 7) * cSizeClassesPerPow2 + sub_step;
+}
+
+
+constexpr int sGetSizeClassSize(int inSizeClass)
+{
+	if (inSizeClass < cNumLinearSizeClasses)
+		return (inSizeClass + 1) * cLinearSizeClassStep;
+
+	int index = inSizeClass - cNumLinearSizeClasses;
+	int log2  = 7 + index / cSizeClassesPerPow2;
+	return (1 << log2) + (index % cSizeClassesPerPow2 + 1) * (1 << (log2 - 2));
+}
+
+
+struct SizeClassInfo
+{
+	int mSize      = 0; // Size of the blocks of this size class.
+	int mBatchSize = 0; // Number of blocks moved between a thread cache and the central pool at once.
+};
+
+
+constexpr Array<SizeClassInfo, cNumSizeClasses> cSizeClassInfos = []()
+{
+	Array<SizeClassInfo, cNumSizeClasses> infos = {};
+	for (int i = 0; i < cNumSizeClasses; ++i)
+	{
+		infos[i].mSize      = sGetSizeClassSize(i);
+		infos[i].mBatchSize = gClamp(cBatchSizeInBytes / infos[i].mSize, cMinBatchSize, cMaxBatchSize);
+	}
+	return infos;
+}();
+
+
+static_assert(sGetSizeClass(1) == 0);
+static_assert(sGetSizeClass(16) == 0);
+static_assert(sGetSizeClass(17) == 1);
+static_assert(sGetSizeClass(128) == cNumLinearSizeClasses - 1);
+static_assert(sGetSizeClass(129) == cNumLinearSizeClasses);
+static_assert(sGetSizeClassSize(cNumLinearSizeClasses) == 160);
+static_assert(sGetSizeClass(cSizeClassHeapMaxSize) == cNumSizeClasses - 1);
+static_assert(sGetSizeClassSize(cNumSizeClasses - 1) == cSizeClassHeapMaxSize);
+static_assert(cSpanSize / cSizeClassHeapMaxSize >= cMinBatchSize * 2);
+
+
+// Free blocks store the free list links in place.
+// Blocks are at least 16 bytes, so there is room for two pointers.
+struct FreeNode
+{
+	FreeNode* mNext;      // Next node in the same batch (or list).
+	FreeNode* mNextBatch; // First node of the next batch. Only valid on the first node of a batch.
+};
+
+
+// Per size class list of free blocks shared by all threads.
+struct CentralFreeList
+{
+	Mutex     mMutex;
+	FreeNode* mBatches      = nullptr; // Full batches (mBatchSize blocks each), linked by mNextBatch.
+	FreeNode* mPartialBatch = nullptr; // Incomplete batch, linked by mNext.
+	int       mPartialCount = 0;
+};
+
+
+struct CentralPool
+{
+	Mutex           mSpanMutex;
+	MemBlock        mRegion;               // Current virtual memory reservation.
+	int64           mRegionUsedSize = 0;   // Size of the part of mRegion already given to spans.
+	CentralFreeList mFreeLists[cNumSizeClasses];
+};
+
+
+// The central pool is lazily initialized since allocations can happen during static initialization.
+static CentralPool& sGetCentralPool()
+{
+	static CentralPool sCentralPool;
+	return sCentralPool;
+}
+
+
+struct ThreadCache : NoCopy
+{
+	ThreadCache() = default;
+	~ThreadCache();
+
+	void Flush();
+
+	struct FreeList
+	{
+		FreeNode* mHead  = nullptr;
+		int       mCount = 0;
+	};
+
+	FreeList mFreeLists[cNumSizeClasses];
+};
+
+
+static thread_local ThreadCache sThreadCache;
+
+// Set when the thread cache is destroyed. Allocations and frees that happen after that (eg. from the destructor of another
+// thread_local object) go directly to the central pool.
+// Note: This is a separate variable because it is trivially destructible, so it stays valid until the thread exits.
+static thread_local bool sThreadCacheDestroyed = false;
+
+
+// Commit a new span of virtual memory.
+static MemBlock sAllocateSpan()
+{
+	CentralPool& pool = sGetCentralPool();
+	MutexLockGuard lock(pool.mSpanMutex);
+
+	if (pool.mRegion == nullptr || pool.mRegionUsedSize + cSpanSize > pool.mRegion.mSize)
+	{
+		// The rest of the previous region (if any) stays reserved but unused. Regions are never freed.
+		pool.mRegion         = gVMemReserve(cRegionSize);
+		pool.mRegionUsedSize = 0;
+
+		if (pool.mRegion == nullptr) [[unlikely]]
+			return {};
+	}
+
+	MemBlock span = gVMemCommit({ pool.mRegion.mPtr + pool.mRegionUsedSize, cSpanSize });
+	if (span == nullptr) [[unlikely]]
+		return {};
+
+	pool.mRegionUsedSize += cSpanSize;
+	gGetMemCounters(EMemoryKind::VMemCommitted).OnResize(span.mSize);
+
+	return span;
+}
+
+
+// Push a partial list of nodes to the central free list. Complete batches are formed along the way.
+static void sPushPartialList(CentralFreeList& ioCentral, FreeNode* inHead, int inBatchSize)
+{
+	MutexLockGuard lock(ioCentral.mMutex);
+
+	while (inHead != nullptr)
+	{
+		FreeNode* node = inHead;
+		inHead         = node->mNext;
+
+		node->mNext             = ioCentral.mPartialBatch;
+		ioCentral.mPartialBatch = node;
+		ioCentral.mPartialCount++;
+
+		if (ioCentral.mPartialCount == inBatchSize)
+		{
+			ioCentral.mPartialBatch->mNextBatch = ioCentral.mBatches;
+			ioCentral.mBatches                  = ioCentral.mPartialBatch;
+			ioCentral.mPartialBatch             = nullptr;
+			ioCentral.mPartialCount             = 0;
+		}
+	}
+}
+
+
+// Refill an empty thread cache free list, either from the central pool or from a new span.
+// Return false if out of memory.
+static bool sRefill(ThreadCache::FreeList& ioList, int inSizeClass)
+{
+	gAssert(ioList.mHead == nullptr);
+
+	const SizeClassInfo& info    = cSizeClassInfos[inSizeClass];
+	CentralFreeList&     central = sGetCentralPool().mFreeLists[inSizeClass];
+
+	{
+		MutexLockGuard lock(central.mMutex);
+
+		if (central.mBatches != nullptr)
+		{
+			ioList.mHead     = central.mBatches;
+			ioList.mCount    = info.mBatchSize;
+			central.mBatches = central.mBatches->mNextBatch;
+			return true;
+		}
+
+		if (central.mPartialBatch != nullptr)
+		{
+			ioList.mHead          = central.mPartialBatch;
+			ioList.mCount         = central.mPartialCount;
+			central.mPartialBatch = nullptr;
+			central.mPartialCount = 0;
+			return true;
+		}
+	}
+
+	// The central pool is empty, split a new span.
+	MemBlock span = sAllocateSpan();
+	if (span == nullptr) [[unlikely]]
+		return false;
+
+	int num_blocks  = (int)(span.mSize / info.mSize);
+	int num_batches = num_blocks / info.mBatchSize;
+
+	// Build the batches back to front, so that blocks are handed out in address order.
+	// The first batch and the leftover blocks go to the thread cache, the other batches to the central pool.
+	int       first_central_block = num_blocks - (num_batches - 1) * info.mBatchSize;
+	FreeNode* batches             = nullptr;
+	FreeNode* last_batch          = nullptr;
+	FreeNode* next                = nullptr;
+
+	for (int i = num_blocks - 1; i >= first_central_block; --i)
+	{
+		FreeNode* node = (FreeNode*)(span.mPtr + (int64)i * info.mSize);
+
+		if ((i - first_central_block) % info.mBatchSize == info.mBatchSize - 1)
+			next = nullptr; // Last node of a batch.
+
+		node->mNext = next;
+		next        = node;
+
+		if ((i - first_central_block) % info.mBatchSize == 0)
+		{
+			// First node of a batch.
+			node->mNextBatch = batches;
+			batches          = node;
+			if (last_batch == nullptr)
+				last_batch = node; // Batches are built back to front, the first one built is the last one.
+		}
+	}
+
+	next = nullptr;
+	for (int i = first_central_block - 1; i >= 0; --i)
+	{
+		FreeNode* node = (FreeNode*)(span.mPtr + (int64)i * info.mSize);
+		node->mNext    = next;
+		next           = node;
+	}
+
+	ioList.mHead  = next;
+	ioList.mCount = first_central_block;
+
+	if (batches != nullptr)
+	{
+		MutexLockGuard lock(central.mMutex);
+		last_batch->mNextBatch = central.mBatches;
+		central.mBatches            = batches;
+	}
+
+	return true;
+}
+
+
+// Move one batch from a thread cache free list to the central pool.
+static void sReleaseBatch(ThreadCache::FreeList& ioList, int inSizeClass)
+{
+	const SizeClassInfo& info = cSizeClassInfos[inSizeClass];
+	gAssert(ioList.mCount > info.mBatchSize);
+
+	FreeNode* batch = ioList.mHead;
+	FreeNode* last  = batch;
+	for (int i = 1; i < info.mBatchSize; ++i)
+		last = last->mNext;
+
+	ioList.mHead   = last->mNext;
+	ioList.mCount -= info.mBatchSize;
+	last->mNext    = nullptr;
+
+	CentralFreeList& central = sGetCentralPool().mFreeLists[inSizeClass];
+	MutexLockGuard   lock(central.mMutex);
+
+	batch->mNextBatch = central.mBatches;
+	central.mBatches  = batch;
+}
+
+
+ThreadCache::~ThreadCache()
+{
+	Flush();
+	sThreadCacheDestroyed = true;
+}
+
+
+void ThreadCache::Flush()
+{
+	for (int size_class = 0; size_class < cNumSizeClasses; ++size_class)
+	{
+		FreeList& list = mFreeLists[size_class];
+		if (list.mHead == nullptr)
+			continue;
+
+		const SizeClassInfo& info = cSizeClassInfos[size_class];
+		while (list.mCount > info.mBatchSize)
+			sReleaseBatch(list, size_class);
+
+		sPushPartialList(sGetCentralPool().mFreeLists[size_class], list.mHead, info.mBatchSize);
+		list = {};
+	}
+}
+
+
+// Allocate a block directly from the central pool, without going through the thread cache.
+static MemBlock sCentralAlloc(int inSizeClass, int64 inSize)
+{
+	ThreadCache::FreeList list;
+	if (!sRefill(list, inSizeClass)) [[unlikely]]
+		return { nullptr, inSize };
+
+	FreeNode* node = list.mHead;
+
+	// Give the rest back.
+	if (node->mNext != nullptr)
+		sPushPartialList(sGetCentralPool().mFreeLists[inSizeClass], node->mNext, cSizeClassInfos[inSizeClass].mBatchSize);
+
+	return { (uint8*)node, inSize };
+}
+
+
+// Free a block directly to the central pool, without going through the thread cache.
+static void sCentralFree(int inSizeClass, uint8* inPtr)
+{
+	FreeNode* node = (FreeNode*)inPtr;
+	node->mNext    = nullptr;
+	sPushPartialList(sGetCentralPool().mFreeLists[inSizeClass], node, cSizeClassInfos[inSizeClass].mBatchSize);
+}
+
+
+MemBlock gSizeClassHeapAlloc(int64 inSize)
+{
+	if (inSize > cSizeClassHeapMaxSize) [[unlikely]]
+		return { (uint8*)malloc(inSize), inSize };
+
+	int size_class = sGetSizeClass(inSize);
+
+	if (sThreadCacheDestroyed) [[unlikely]]
+		return sCentralAlloc(size_class, inSize);
+
+	ThreadCache::FreeList& list = sThreadCache.mFreeLists[size_class];
+
+	if (list.mHead == nullptr) [[unlikely]]
+	{
+		if (!sRefill(list, size_class)) [[unlikely]]
+			return { nullptr, inSize };
+	}
+
+	FreeNode* node = list.mHead;
+	list.mHead     = node->mNext;
+	list.mCount--;
+
+	return { (uint8*)node, inSize };
+}
+
+
+void gSizeClassHeapFree(MemBlock inMemory)
+{
+	if (inMemory.mSize > cSizeClassHeapMaxSize) [[unlikely]]
+	{
+		free(inMemory.mPtr);
+		return;
+	}
+
+	int size_class = sGetSizeClass(inMemory.mSize);
+
+	if (sThreadCacheDestroyed) [[unlikely]]
+	{
+		sCentralFree(size_class, inMemory.mPtr);
+		return;
+	}
+
+	ThreadCache::FreeList& list = sThreadCache.mFreeLists[size_class];
+
+	FreeNode* node = (FreeNode*)inMemory.mPtr;
+	node->mNext    = list.mHead;
+	list.mHead     = node;
+	list.mCount++;
+
+	// Keep up to two batches in the cache so that alternating allocs and frees don't always hit the central pool.
+	if (list.mCount > cSizeClassInfos[size_class].mBatchSize * 2) [[unlikely]]
+		sReleaseBatch(list, size_class);
+}
+
+
+int64 gSizeClassHeapGetUsableSize(int64 inSize)
+{
+	if (inSize > cSizeClassHeapMaxSize) [[unlikely]]
+		return inSize;
+
+	return cSizeClassInfos[sGetSizeClass(inSize)].mSize;
+}
+
+
+void gSizeClassHeapFlushThreadCache()
+{
+	sThreadCache.Flush();
+}
+
+
+REGISTER_TEST("SizeClassHeap")
+{
+	for (int size_class = 0; size_class < cNumSizeClasses; ++size_class)
+	{
+		TEST_TRUE(sGetSizeClass(sGetSizeClassSize(size_class)) == size_class);
+		TEST_TRUE(sGetSizeClass(sGetSizeClassSize(size_class) + 1) == size_class + 1);
+	}
+
+	// Allocate enough blocks of each size to go through several refills and releases.
+	constexpr int cNumAllocs = 300;
+	MemBlock      blocks[cNumAllocs];
+
+	for (int64 size : { 1, 16, 17, 100, 129, 1000, 4096, 5000, 20000, cSizeClassHeapMaxSize, cSizeClassHeapMaxSize + 1, 100000 })
+	{
+		for (int i = 0; i < cNumAllocs; ++i)
+		{
+			blocks[i] = gSizeClassHeapAlloc(size);
+			TEST_TRUE(blocks[i].mPtr != nullptr);
+			TEST_TRUE(blocks[i].mSize == size);
+			TEST_TRUE(((int64)blocks[i].mPtr & 15) == 0);
+
+			// Write a pattern to the first and last bytes to detect overlaps.
+			blocks[i].mPtr[0]        = (uint8)i;
+			blocks[i].mPtr[size - 1] = (uint8)i;
+		}
+
+		for (int i = 0; i < cNumAllocs; ++i)
+		{
+			TEST_TRUE(blocks[i].mPtr[0] == (uint8)i);
+			TEST_TRUE(blocks[i].mPtr[size - 1] == (uint8)i);
+		}
+
+		// Free half, reallocate, then free everything.
+		for (int i = 0; i < cNumAllocs; i += 2)
+			gSizeClassHeapFree(blocks[i]);
+
+		for (int i = 0; i < cNumAllocs; i += 2)
+			blocks[i] = gSizeClassHeapAlloc(size);
+
+		for (int i = 0; i < cNumAllocs; ++i)
+			gSizeClassHeapFree(blocks[i]);
+	}
+
+	// The last freed block is the first reused.
+	MemBlock block = gSizeClassHeapAlloc(64);
+	gSizeClassHeapFree(block);
+	MemBlock block2 = gSizeClassHeapAlloc(64);
+	TEST_TRUE(block.mPtr == block2.mPtr);
+	gSizeClassHeapFree(block2);
+
+	gSizeClassHeapFlushThreadCache();
+};
+
+
+REGISTER_TEST("SizeClassHeap Threads")
+{
+	// Allocate on some threads, free on other threads.
+	constexpr int cNumThreads = 4;
+	constexpr int cNumAllocs  = 2000;
+
+	MemBlock blocks[cNumThreads][cNumAllocs];
+	Thread   threads[cNumThreads];
+
+	for (int t = 0; t < cNumThreads; ++t)
+	{
+		threads[t].Create({ .mName = "SizeClassHeapTest" }, [&blocks, t](Thread&)
+		{
+			for (int i = 0; i < cNumAllocs; ++i)
+			{
+				MemBlock& block             = blocks[t][i];
+				block                       = gSizeClassHeapAlloc(16 + (i % 64) * 16);
+				block.mPtr[0]               = (uint8)t;
+				block.mPtr[block.mSize - 1] = (uint8)t;
+			}
+		});
+	}
+
+	for (Thread& thread : threads)
+		thread.Join();
+
+	for (int t = 0; t < cNumThreads; ++t)
+		for (int i = 0; i < cNumAllocs; ++i)
+			TEST_TRUE(blocks[t][i].mPtr[0] == (uint8)t && blocks[t][i].mPtr[blocks[t][i].mSize - 1] == (uint8)t);
+
+	for (int t = 0; t < cNumThreads; ++t)
+	{
+		threads[t].Create({ .mName = "SizeClassHeapTest" }, [&blocks, t](Thread&)
+		{
+			// Free the blocks allocated by another thread.
+			int other = (t + 1) % cNumThreads;
+			for (int i = 0; i < cNumAllocs; ++i)
+				gSizeClassHeapFree(blocks[other][i]);
+		});
+	}
+
+	for (Thread& thread : threads)
+		thread.Join();
+};
+
+
+REGISTER_TEST("SizeClassHeap After Thread Cache Destroyed")
+{
+	// Frees a block and allocates a new one when the thread exits, after the thread cache is destroyed.
+	struct LateFree
+	{
+		~LateFree()
+		{
+			gSizeClassHeapFree(mBlock);
+
+			MemBlock block = gSizeClassHeapAlloc(64);
+			*mSucceeded    = block.mPtr != nullptr;
+			gSizeClassHeapFree(block);
+		}
+
+		MemBlock mBlock;
+		bool*    mSucceeded = nullptr;
+	};
+
+	bool   succeeded = false;
+	Thread thread;
+	thread.Create({ .mTempMemSize = 0 }, [&succeeded](Thread&)
+	{
+		// Construct late_free before the first allocation (which constructs the thread cache), so that it's destroyed after it.
+		static thread_local LateFree late_free;
+		late_free.mSucceeded = &succeeded;
+		late_free.mBlock     = gSizeClassHeapAlloc(64);
+	});
+	thread.Join();
+
+	TEST_TRUE(succeeded);
+};
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Memory.h>
+
+// Size-class heap with per-thread caches.
+// Small allocations are rounded up to a size class and served from a thread local free list. Free lists are
+// refilled from (and returned to) a central pool by batches, and the central pool carves new blocks out of
+// virtual memory spans. Allocations larger than cSizeClassHeapMaxSize go to malloc.
+//
+// gMemAlloc/gMemFree use this heap when BEDROCK_ENABLE_SIZE_CLASS_HEAP is defined.
+//
+// Notes:
+// - The size passed to gSizeClassHeapFree must be the size passed to gSizeClassHeapAlloc (it is used to find the size class),
+//   or any size up to the usable size (see gSizeClassHeapGetUsableSize).
+// - Memory can be freed from any thread. It goes into the cache of the freeing thread.
+// - Memory is never given back to the OS, but cached blocks are returned to the central pool when a thread exits.
+
+constexpr int cSizeClassHeapMaxSize = 32_KiB; // Allocations above this size are not cached.
+
+MemBlock gSizeClassHeapAlloc(int64 inSize);         // Allocate memory. Alignment is at least 16 bytes.
+void     gSizeClassHeapFree(MemBlock inMemory);     // Free memory allocated with gSizeClassHeapAlloc.
+void     gSizeClassHeapFlushThreadCache();          // Return all the blocks cached by the current thread to the central pool.
+int64    gSizeClassHeapGetUsableSize(int64 inSize); // Return the size of the block that an allocation of inSize bytes actually gets (inSize if not cached).
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/SoAVector.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/String.h>
+#include <Bedrock/StringFormat.h>
+
+
+REGISTER_TEST("SoAVector")
+{
+	struct alignas(32) Wide
+	{
+		float mValues[8];
+	};
+
+	SoAVector<int, Wide, uint8> test;
+	static_assert(test.cNumColumns == 3);
+	static_assert(test.cAlignment == 32);
+
+	for (int i = 0; i < 100; ++i)
+		test.PushBack(i, Wide{ { (float)i } }, (uint8)i);
+
+	TEST_TRUE(test.Size() == 100);
+	TEST_TRUE(test.Capacity() >= 100);
+
+	// Each column is contiguous and aligned.
+	Span<int>   ints   = test.GetColumn<0>();
+	Span<Wide>  wides  = test.GetColumn<1>();
+	Span<uint8> bytes  = test.GetColumn<2>();
+	TEST_TRUE(ints.Size() == 100 && wides.Size() == 100 && bytes.Size() == 100);
+	TEST_TRUE(((uint64)ints.Data() % 32) == 0);
+	TEST_TRUE(((uint64)wides.Data() % 32) == 0);
+	TEST_TRUE(((uint64)bytes.Data() % 32) == 0);
+	TEST_TRUE((uint8*)wides.Data() >= (uint8*)(ints.Data() + test.Capacity()));
+	TEST_TRUE(ints[42] == 42);
+	TEST_TRUE(wides[42].mValues[0] == 42.0f);
+	TEST_TRUE(test.Get<2>(99) == 99);
+
+	// Iterate on some of the columns.
+	int sum = 0;
+	test.ForEach<0, 2>([&sum](int inInt, uint8 inByte) { sum += inInt + inByte; });
+	TEST_TRUE(sum == 2 * (99 * 100 / 2));
+
+	// Iterate on all the columns.
+	test.ForEach([](int& ioInt, Wide& ioWide, uint8& ioByte) { ioInt = -ioInt; ioWide.mValues[1] = 1.0f; ioByte = 0; });
+	TEST_TRUE(test.Get<0>(10) == -10);
+	TEST_TRUE(test.Get<1>(10).mValues[1] == 1.0f);
+	TEST_TRUE(test.Get<2>(10) == 0);
+
+	test.SwapErase(0);
+	TEST_TRUE(test.Size() == 99);
+	TEST_TRUE(test.Get<0>(0) == -99);
+
+	test.PopBack();
+	test.Resize(200);
+	TEST_TRUE(test.Size() == 200);
+	TEST_TRUE(test.Get<0>(0) == -99);
+	TEST_TRUE(test.Get<0>(150) == 0);
+	TEST_TRUE(test.Get<1>(150).mValues[0] == 0.0f);
+
+	test.Resize(10);
+	TEST_TRUE(test.Size() == 10);
+};
+
+
+REGISTER_TEST("SoAVector NonTrivial")
+{
+	SoAVector<String, int> test;
+	for (int i = 0; i < 50; ++i)
+		test.PushBack(gTempFormat("%d", i), i);
+
+	TEST_TRUE(test.Get<0>(42) == "42");
+
+	test.SwapErase(10);
+	TEST_TRUE(test.Get<0>(10) == "49");
+	TEST_TRUE(test.Get<1>(10) == 49);
+
+	// Copy.
+	SoAVector<String, int> copy = test;
+	TEST_TRUE(copy.Size() == test.Size());
+	TEST_TRUE(copy.Get<0>(42) == "42");
+	TEST_TRUE(copy.GetColumn<0>().Data() != test.GetColumn<0>().Data());
+
+	// Move.
+	const String* column_data = test.GetColumn<0>().Data();
+	SoAVector<String, int> moved = gMove(test);
+	TEST_TRUE(moved.GetColumn<0>().Data() == column_data);
+	TEST_TRUE(test.Empty());
+
+	const SoAVector<String, int>& const_moved = moved;
+	int total_size = 0;
+	const_moved.ForEach<0>([&total_size](const String& inString) { total_size += inString.Size(); });
+	TEST_TRUE(total_size == 10 + 2 * 39);
+
+	moved.Clear();
+	TEST_TRUE(moved.Empty());
+};
+
+
+REGISTER_TEST("TempSoAVector")
+{
+	TempSoAVector<int, float> test;
+	test.PushBack(1, 2.0f);
+	TEST_TRUE(gTempMemArena.Owns(test.GetColumn<0>().Data()));
+	TEST_TRUE(test.Get<1>(0) == 2.0f);
+};
@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/TypeTraits.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/Span.h>
+#include <Bedrock/PlacementNew.h>
+
+
+// Structure of arrays container. Stores one column (array) per type in taTypes, all columns have the same size and capacity.
+// Loops that only read a few of the columns don't bring the other ones in cache.
+// All the columns are stored in a single allocation, and each column is aligned to cAlignment.
+//
+//		SoAVector<Vec3, float, uint32> particles;
+//		particles.PushBack(position, 1.0f, 0xFF);
+//		particles.ForEach<0, 1>([](Vec3& ioPosition, float inSpeed) { ... });
+//
+// taAllocator allocates bytes (eg. DefaultAllocator<uint8>).
+template <typename taAllocator, typename... taTypes>
+struct SoAVectorBase : private taAllocator
+{
+	static_assert(sizeof...(taTypes) > 0);
+	static_assert((!cIsConst<taTypes> && ...));
+
+	using Allocator = taAllocator;
+
+	template <int taColumn>
+	using ColumnType = TypeAtIndex<taColumn, taTypes...>;
+
+	static constexpr int cNumColumns = (int)sizeof...(taTypes);
+	static constexpr int cAlignment  = [] { int alignment = cMemDefaultAlignment; ((alignment = gMax(alignment, (int)alignof(taTypes))), ...); return alignment; }();
+
+	// Default
+	constexpr SoAVectorBase() = default;
+	~SoAVectorBase() { ClearAndFreeMemory(); }
+
+	// Default with Allocator
+	constexpr explicit SoAVectorBase(Allocator&& inAllocator) : Allocator(gMove(inAllocator)) {}
+
+	// Move
+	SoAVectorBase(SoAVectorBase&& ioOther) { MoveFrom(gMove(ioOther)); }
+	SoAVectorBase& operator=(SoAVectorBase&& ioOther) { MoveFrom(gMove(ioOther)); return *this; }
+
+	// Copy
+	SoAVectorBase(const SoAVectorBase& inOther) { CopyFrom(inOther); }
+	SoAVectorBase& operator=(const SoAVectorBase& inOther) { CopyFrom(inOther); return *this; }
+
+	int Size() const { return mSize; }
+	int Capacity() const { return mCapacity; }
+	bool Empty() const { return mSize == 0; }
+
+	const Allocator& GetAllocator() const { return *this; }
+	Allocator&       GetAllocator() { return *this; }
+
+	// Return all the elements of a column.
+	template <int taColumn> Span<ColumnType<taColumn>>       GetColumn()       { return { GetColumnData<taColumn>(), mSize }; }
+	template <int taColumn> Span<const ColumnType<taColumn>> GetColumn() const { return { GetColumnData<taColumn>(), mSize }; }
+
+	// Return the element at inPosition in a column.
+	template <int taColumn> ColumnType<taColumn>&       Get(int inPosition)       { gBoundsCheck(inPosition, mSize); return GetColumnData<taColumn>()[inPosition]; }
+	template <int taColumn> const ColumnType<taColumn>& Get(int inPosition) const { gBoundsCheck(inPosition, mSize); return GetColumnData<taColumn>()[inPosition]; }
+
+	void Clear();
+	void ClearAndFreeMemory();
+	void Reserve(int inCapacity);
+	void Resize(int inNewSize);		// New elements are value-initialized (ie. zero-initialized if they don't have a constructor).
+
+	// Add an element at the end. Takes one value per column.
+	template <typename... taArgs>
+	requires (sizeof...(taArgs) == sizeof...(taTypes))
+	void PushBack(taArgs&&... inValues);
+
+	void PopBack();
+	void SwapErase(int inPosition);
+
+	// Call inFunc for each element, with one reference per column: inFunc(column0[i], column1[i], ...).
+	// Only the columns in taColumns are passed if any are specified (eg. ForEach<0, 2>(func) calls func(column0[i], column2[i])).
+	template <int... taColumns, typename taFunc> void ForEach(taFunc&& inFunc);
+	template <int... taColumns, typename taFunc> void ForEach(taFunc&& inFunc) const;
+
+private:
+	template <int taColumn> ColumnType<taColumn>*       GetColumnData()       { return (ColumnType<taColumn>*)mColumns[taColumn]; }
+	template <int taColumn> const ColumnType<taColumn>* GetColumnData() const { return (const ColumnType<taColumn>*)mColumns[taColumn]; }
+
+	// Call inFunc(taType* inTypeTag, int inColumn) for each column, inTypeTag is always nullptr.
+	template <typename taFunc> static void ForEachColumnType(taFunc&& inFunc);
+
+	// Return the size in bytes of the allocation needed for inCapacity elements, and set outColumns to the start of each column in inData.
+	static int64 GetColumns(uint8* inData, int inCapacity, void* (&outColumns)[cNumColumns]);
+	static int64 GetAllocationSize(int inCapacity) { void* columns[cNumColumns]; return GetColumns(nullptr, inCapacity, columns); }
+
+	// Return true if inPtr points inside one of the columns (including their unused capacity).
+	bool IsInColumns(const void* inPtr) const;
+
+	void MoveFrom(SoAVectorBase&& ioOther);
+	void CopyFrom(const SoAVectorBase& inOther);
+	void Grow(int inCapacity);
+
+	void* mColumns[cNumColumns] = {};	// mColumns[0] is also the start of the allocation.
+	int   mSize                 = 0;
+	int   mCapacity             = 0;
+};
+
+
+// Alias for a SoAVector using the DefaultAllocator.
+template <typename... taTypes>
+using SoAVector = SoAVectorBase<DefaultAllocator<uint8>, taTypes...>;
+
+// Alias for a SoAVector using the TempAllocator.
+template <typename... taTypes>
+using TempSoAVector = SoAVectorBase<TempAllocator<uint8>, taTypes...>;
+
+// Alias for a SoAVector using the ArenaAllocator.
+// A MemArena needs to be passed to the SoAVector before it can be used.
+template <typename... taTypes>
+using ArenaSoAVector = SoAVectorBase<ArenaAllocator<uint8>, taTypes...>;
+
+
+// SoAVectors can be relocated with a memcpy if their allocator can (the elements themselves are not moved).
+template <typename taAllocator, typename... taTypes> inline constexpr bool cIsTriviallyRelocatable<SoAVectorBase<taAllocator, taTypes...>> = cIsTriviallyRelocatable<taAllocator>;
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::Clear()
+{
+	ForEachColumnType([this]<typename taType>(taType*, int inColumn)
+	{
+		taType* column = (taType*)mColumns[inColumn];
+		for (int i = 0, n = mSize; i < n; ++i)
+			column[i].~taType();
+	});
+
+	mSize = 0;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::ClearAndFreeMemory()
+{
+	Clear();
+
+	if (mColumns[0] != nullptr)
+	{
+		Allocator::Free((uint8*)mColumns[0], (int)GetAllocationSize(mCapacity), cAlignment);
+
+		for (void*& column : mColumns)
+			column = nullptr;
+		mCapacity = 0;
+	}
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::Reserve(int inCapacity)
+{
+	if (mCapacity >= inCapacity)
+		return;
+
+	// Allocate new data for all the columns at once.
+	// Note: The allocation can't be resized in place, since the start of each column depends on the capacity.
+	int64 new_size = GetAllocationSize(inCapacity);
+	gAssert(new_size <= cMaxInt); // Allocators only take int sizes.
+
+	void*  new_columns[cNumColumns];
+	uint8* new_data = Allocator::Allocate((int)new_size, cAlignment);
+	GetColumns(new_data, inCapacity, new_columns);
+
+	// Move old data to new.
+	ForEachColumnType([this, &new_columns]<typename taType>(taType*, int inColumn)
+	{
+		taType* old_column = (taType*)mColumns[inColumn];
+		taType* new_column = (taType*)new_columns[inColumn];
+
+		if constexpr (cIsTriviallyRelocatable<taType>)
+		{
+			// Relocate all the elements at once (no need to destroy relocated elements).
+			if (mSize != 0)
+				gMemCopy(new_column, old_column, mSize * (int64)sizeof(taType));
+		}
+		else
+		{
+			for (int i = 0, n = mSize; i < n; ++i)
+			{
+				gPlacementNew(new_column[i], gMove(old_column[i]));
+				old_column[i].~taType();
+			}
+		}
+	});
+
+	// Free old data.
+	if (mColumns[0] != nullptr)
+		Allocator::Free((uint8*)mColumns[0], (int)GetAllocationSize(mCapacity), cAlignment);
+
+	for (int i = 0; i < cNumColumns; ++i)
+		mColumns[i] = new_columns[i];
+	mCapacity = inCapacity;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::Resize(int inNewSize)
+{
+	if (inNewSize < mSize)
+	{
+		// Shrinking.
+		// Destroy the elements that need to be removed.
+		ForEachColumnType([this, inNewSize]<typename taType>(taType*, int inColumn)
+		{
+			taType* column = (taType*)mColumns[inColumn];
+			for (int i = inNewSize, n = mSize; i < n; ++i)
+				column[i].~taType();
+		});
+
+		mSize = inNewSize;
+	}
+	else if (inNewSize > mSize)
+	{
+		// Growing.
+		Reserve(inNewSize);
+
+		// Construct the elements.
+		ForEachColumnType([this, inNewSize]<typename taType>(taType*, int inColumn)
+		{
+			taType* column = (taType*)mColumns[inColumn];
+			for (int i = mSize, n = inNewSize; i < n; ++i)
+				gPlacementNew(column[i]);
+		});
+
+		mSize = inNewSize;
+	}
+}
+
+
+template <typename taAllocator, typename... taTypes>
+template <typename... taArgs>
+requires (sizeof...(taArgs) == sizeof...(taTypes))
+void SoAVectorBase<taAllocator, taTypes...>::PushBack(taArgs&&... inValues)
+{
+	// Copying from self is not allowed.
+	gAssert((!IsInColumns(&inValues) && ...));
+
+	Grow(mSize + 1);
+
+	// Construct one element per column.
+	[&]<int... taColumns>(IntegerSequence<taColumns...>)
+	{
+		(gPlacementNew(GetColumnData<taColumns>()[mSize], gForward<taArgs>(inValues)), ...);
+	}(MakeIntegerSequence<cNumColumns>{});
+
+	mSize++;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::PopBack()
+{
+	gAssert(Size() >= 1);
+	mSize--;
+
+	ForEachColumnType([this]<typename taType>(taType*, int inColumn)
+	{
+		((taType*)mColumns[inColumn])[mSize].~taType();
+	});
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::SwapErase(int inPosition)
+{
+	gBoundsCheck(inPosition, mSize);
+
+	int last = mSize - 1;
+
+	ForEachColumnType([this, inPosition, last]<typename taType>(taType*, int inColumn)
+	{
+		taType* column = (taType*)mColumns[inColumn];
+
+		// Move the last element to inPosition, then destroy it.
+		if (inPosition != last)
+			column[inPosition] = gMove(column[last]);
+
+		column[last].~taType();
+	});
+
+	mSize--;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+template <int... taColumns, typename taFunc>
+void SoAVectorBase<taAllocator, taTypes...>::ForEach(taFunc&& inFunc)
+{
+	if constexpr (sizeof...(taColumns) == 0)
+	{
+		// No columns specified, pass all of them.
+		[&]<int... taAllColumns>(IntegerSequence<taAllColumns...>) { ForEach<taAllColumns...>(inFunc); }(MakeIntegerSequence<cNumColumns>{});
+	}
+	else
+	{
+		// Get the column pointers once, outside the loop.
+		[&](auto*... inColumns)
+		{
+			for (int i = 0, n = mSize; i < n; ++i)
+				inFunc(inColumns[i]...);
+		}(GetColumnData<taColumns>()...);
+	}
+}
+
+
+template <typename taAllocator, typename... taTypes>
+template <int... taColumns, typename taFunc>
+void SoAVectorBase<taAllocator, taTypes...>::ForEach(taFunc&& inFunc) const
+{
+	if constexpr (sizeof...(taColumns) == 0)
+	{
+		// No columns specified, pass all of them.
+		[&]<int... taAllColumns>(IntegerSequence<taAllColumns...>) { ForEach<taAllColumns...>(inFunc); }(MakeIntegerSequence<cNumColumns>{});
+	}
+	else
+	{
+		// Get the column pointers once, outside the loop.
+		[&](const auto*... inColumns)
+		{
+			for (int i = 0, n = mSize; i < n; ++i)
+				inFunc(inColumns[i]...);
+		}(GetColumnData<taColumns>()...);
+	}
+}
+
+
+template <typename taAllocator, typename... taTypes>
+template <typename taFunc>
+void SoAVectorBase<taAllocator, taTypes...>::ForEachColumnType(taFunc&& inFunc)
+{
+	int column = 0;
+	(inFunc((taTypes*)nullptr, column++), ...);
+}
+
+
+template <typename taAllocator, typename... taTypes>
+int64 SoAVectorBase<taAllocator, taTypes...>::GetColumns(uint8* inData, int inCapacity, void* (&outColumns)[cNumColumns])
+{
+	int64 offset = 0;
+	ForEachColumnType([&]<typename taType>(taType*, int inColumn)
+	{
+		outColumns[inColumn] = inData == nullptr ? nullptr : inData + offset;
+		offset += gAlignUp(inCapacity * (int64)sizeof(taType), (int64)cAlignment);
+	});
+
+	return offset;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+bool SoAVectorBase<taAllocator, taTypes...>::IsInColumns(const void* inPtr) const
+{
+	bool is_in_columns = false;
+	ForEachColumnType([this, inPtr, &is_in_columns]<typename taType>(taType*, int inColumn)
+	{
+		const taType* column = (const taType*)mColumns[inColumn];
+		is_in_columns |= (inPtr >= column && inPtr < column + mCapacity);
+	});
+
+	return is_in_columns;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::MoveFrom(SoAVectorBase&& ioOther)
+{
+	// Moving from self is not allowed.
+	gAssert(mColumns[0] != ioOther.mColumns[0] || mColumns[0] == nullptr);
+
+	// Clear the current data.
+	ClearAndFreeMemory();
+
+	// Move the allocator.
+	GetAllocator() = gMove(ioOther.GetAllocator());
+	ioOther.GetAllocator() = Allocator();
+
+	// Move the data.
+	for (int i = 0; i < cNumColumns; ++i)
+	{
+		mColumns[i]         = ioOther.mColumns[i];
+		ioOther.mColumns[i] = nullptr;
+	}
+
+	mSize     = ioOther.mSize;
+	mCapacity = ioOther.mCapacity;
+
+	ioOther.mSize     = 0;
+	ioOther.mCapacity = 0;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::CopyFrom(const SoAVectorBase& inOther)
+{
+	// Copying from self is not allowed.
+	gAssert(mColumns[0] != inOther.mColumns[0] || mColumns[0] == nullptr);
+
+	// Note: The allocator of inOther is never copied (same as Vector).
+
+	Clear();
+	Reserve(inOther.mSize);
+
+	ForEachColumnType([this, &inOther]<typename taType>(taType*, int inColumn)
+	{
+		taType*       column       = (taType*)mColumns[inColumn];
+		const taType* other_column = (const taType*)inOther.mColumns[inColumn];
+
+		for (int i = 0, n = inOther.mSize; i < n; ++i)
+			gPlacementNew(column[i], other_column[i]);
+	});
+
+	mSize = inOther.mSize;
+}
+
+
+template <typename taAllocator, typename... taTypes>
+void SoAVectorBase<taAllocator, taTypes...>::Grow(int inCapacity)
+{
+	if (mCapacity >= inCapacity) [[likely]]
+		return;
+
+	// Grow by 50%, but make sure we get at least the requested capacity.
+	Reserve(gMax(mCapacity + mCapacity / 2, inCapacity));
+}
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MPL-2.0
+#include <Bedrock/Sort.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/String.h>
+#include <Bedrock/Random.h>
+
+
+// gSort is usable in constexpr.
+static_assert([]
+{
+	int values[] = { 5, 3, 9, 1, 7, 2, 8, 6, 4, 0, 11, 10 };
+	gSort(values);
+	return gIsSorted(values) && values[0] == 0 && values[11] == 11;
+}());
+
+
+// Fill ioValues with different patterns that are known to be bad cases for some sorting algorithms.
+static void sFillPattern(Span<int> ioValues, int inPattern, uint32& ioSeed)
+{
+	int size = ioValues.Size();
+	for (int i = 0; i < size; ++i)
+	{
+		switch (inPattern)
+		{
+		case 0: ioValues[i] = (int)(ioSeed = gRand32(ioSeed));			break; // Random
+		case 1: ioValues[i] = i;										break; // Sorted
+		case 2: ioValues[i] = size - i;									break; // Reverse sorted
+		case 3: ioValues[i] = 42;										break; // All equal
+		case 4: ioValues[i] = (int)((ioSeed = gRand32(ioSeed)) % 4);	break; // Few unique
+		case 5: ioValues[i] = i < size / 2 ? i : size - i;				break; // Organ pipe
+		case 6: ioValues[i] = (i % 16) == 0 ? size - i : i;				break; // Almost sorted
+		}
+	}
+}
+
+
+REGISTER_TEST("Sort")
+{
+	// All combinations of 0s and 1s for small sizes. Enough to validate the sorting networks (zero-one principle).
+	for (int size = 0; size <= 12; ++size)
+	{
+		for (int bits = 0; bits < (1 << size); ++bits)
+		{
+			int values[12];
+			for (int i = 0; i < size; ++i)
+				values[i] = (bits >> i) & 1;
+
+			gSort(values, values + size);
+			TEST_TRUE(gIsSorted(values, values + size));
+		}
+	}
+
+	uint32     seed = 1234;
+	Vector<int> values;
+	for (int size : { 10, 30, 100, 1000, 10000 })
+	{
+		for (int pattern = 0; pattern < 7; ++pattern)
+		{
+			values.Resize(size);
+			sFillPattern(values, pattern, seed);
+
+			int64 sum = 0;
+			for (int v : values)
+				sum += v;
+
+			gSort(values);
+			TEST_TRUE(gIsSorted(values));
+
+			// Nothing lost or duplicated.
+			for (int v : values)
+				sum -= v;
+			TEST_TRUE(sum == 0);
+		}
+	}
+
+	// Custom comparison.
+	sFillPattern(values, 0, seed);
+	auto greater = [](int inA, int inB) { return inA > inB; };
+	gSort(values, greater);
+	TEST_TRUE(gIsSorted(values, greater));
+
+	// Non-trivial type.
+	Vector<String> strings = { "pear", "apple", "fig", "banana", "cherry", "a fairly long string that allocates", "date" };
+	gSort(strings);
+	TEST_TRUE(gIsSorted(strings));
+	TEST_TRUE(strings[0] == "a fairly long string that allocates");
+	TEST_TRUE(strings.Back() == "pear");
+};
+
+
+REGISTER_TEST("HeapSort")
+{
+	// Only used by gSort as a fallback, so test it separately.
+	uint32 seed = 5678;
+	int    values[500];
+	sFillPattern(values, 0, seed);
+
+	Less less;
+	Details::HeapSort(values, values + 500, less);
+	TEST_TRUE(gIsSorted(values));
+};
+
+
+REGISTER_TEST("StableSort")
+{
+	struct Element
+	{
+		int mKey;
+		int mIndex;
+	};
+
+	auto less_key = [](const Element& inA, const Element& inB) { return inA.mKey < inB.mKey; };
+
+	uint32 seed = 4321;
+	for (int size : { 5, 24, 25, 100, 1001, 10000 })
+	{
+		Vector<Element> elements;
+		for (int i = 0; i < size; ++i)
+			elements.PushBack({ (int)((seed = gRand32(seed)) % 8), i });
+
+		gStableSort(elements, less_key);
+
+		// Sorted by key, and by original index for equal keys.
+		TEST_TRUE(gIsSorted(elements, [](const Element& inA, const Element& inB)
+		{
+			return inA.mKey < inB.mKey || (inA.mKey == inB.mKey && inA.mIndex < inB.mIndex);
+		}));
+	}
+
+	// Non-trivial type, goes through the scratch buffer.
+	Vector<String> strings;
+	for (int i = 0; i < 100; ++i)
+	{
+		char suffix = (char)('a' + (i * 7) % 26);
+		String string = "a string long enough to allocate ";
+		string.Append(&suffix, 1);
+		strings.PushBack(gMove(string));
+	}
+
+	gStableSort(strings);
+	TEST_TRUE(gIsSorted(strings));
+};
+
+
+REGISTER_TEST("PartialSort")
+{
+	uint32      seed = 8765;
+	Vector<int> values;
+	values.Resize(1000);
+	sFillPattern(values, 0, seed);
+
+	Vector<int> sorted = values;
+	gSort(sorted);
+
+	gPartialSort(values, 10);
+	for (int i = 0; i < 10; ++i)
+		TEST_TRUE(values[i] == sorted[i]);
+
+	// The rest is still there.
+	gSort(values);
+	TEST_TRUE(gEquals(values, sorted));
+
+	// Count larger than the size sorts everything.
+	int small[] = { 3, 1, 2 };
+	gPartialSort(small, 10);
+	TEST_TRUE(small[0] == 1 && small[1] == 2 && small[2] == 3);
+};
+
+
+REGISTER_TEST("NthElement")
+{
+	uint32      seed = 1357;
+	Vector<int> values;
+
+	for (int size : { 1, 10, 100, 1000, 10000 })
+	{
+		for (int pattern = 0; pattern < 7; ++pattern)
+		{
+			values.Resize(size);
+			sFillPattern(values, pattern, seed);
+
+			Vector<int> sorted = values;
+			gSort(sorted);
+
+			for (int nth : { 0, size / 3, size - 1 })
+			{
+				gNthElement(values, nth);
+				TEST_TRUE(values[nth] == sorted[nth]);
+
+				bool partitioned = true;
+				for (int i = 0; i < size; ++i)
+					partitioned &= (i < nth) ? values[i] <= values[nth] : values[i] >= values[nth];
+				TEST_TRUE(partitioned);
+			}
+		}
+	}
+};
@@ -0,0 +1,619 @@
+// SPDX-License-Identifier: MPL-2.0
+#pragma once
+
+#include <Bedrock/Core.h>
+#include <Bedrock/Algorithm.h>
+#include <Bedrock/Span.h>
+#include <Bedrock/Allocator.h>
+#include <Bedrock/PlacementNew.h>
+
+
+// Sorting algorithms to avoid <algorithm>.
+// They work on [inBegin, inEnd) pointer ranges, or on anything a Span can be made from (Vector, Array, C arrays, etc.).
+// inLess(a, b) must return true if a should be before b (a strict weak ordering, like operator<).
+
+
+// True if a Span can be made from taContainer (contiguous containers and C arrays) and taLess can compare its elements.
+template <typename taContainer, typename taLess>
+concept cIsSortable = requires (taContainer& ioContainer, taLess& inLess) { inLess(Span(ioContainer)[0], Span(ioContainer)[0]); };
+
+
+namespace Details
+{
+	// Below this size, ranges are sorted with an insertion sort (or a sorting network if they're small enough).
+	constexpr int cInsertionSortThreshold = 24;
+
+	// Above this size, the quicksort pivot is chosen with Tukey's ninther instead of a median of 3.
+	constexpr int cNintherThreshold = 128;
+
+	// Max number of moves allowed in PartialInsertionSort before giving up.
+	constexpr int cPartialInsertionSortLimit = 8;
+
+
+	template <typename taType, typename taLess>
+	force_inline constexpr void CompareSwap(taType& ioA, taType& ioB, taLess& inLess)
+	{
+		if (inLess(ioB, ioA))
+			gSwap(ioA, ioB);
+	}
+
+
+	template <typename taType, typename taLess>
+	force_inline constexpr void Sort3(taType& ioA, taType& ioB, taType& ioC, taLess& inLess)
+	{
+		CompareSwap(ioA, ioB, inLess);
+		CompareSwap(ioB, ioC, inLess);
+		CompareSwap(ioA, ioB, inLess);
+	}
+
+
+	// Apply a sorting network given as a list of pairs of indices to compare-swap.
+	template <typename taType, typename taLess, int taNumPairs>
+	force_inline constexpr void ApplySortingNetwork(taType* ioData, const uint8 (&inPairs)[taNumPairs][2], taLess& inLess)
+	{
+		for (const uint8 (&pair)[2] : inPairs)
+			CompareSwap(ioData[pair[0]], ioData[pair[1]], inLess);
+	}
+
+
+	// Sort up to 8 elements with an optimal sorting network. Fewer branch mispredictions than an insertion sort for tiny ranges.
+	template <typename taType, typename taLess>
+	constexpr void SortingNetwork(taType* ioData, int inSize, taLess& inLess)
+	{
+		constexpr uint8 cNetwork3[][2] = { {0,2}, {0,1}, {1,2} };
+		constexpr uint8 cNetwork4[][2] = { {0,2}, {1,3}, {0,1}, {2,3}, {1,2} };
+		constexpr uint8 cNetwork5[][2] = { {0,3}, {1,4}, {0,2}, {1,3}, {0,1}, {2,4}, {1,2}, {3,4}, {2,3} };
+		constexpr uint8 cNetwork6[][2] = { {0,5}, {1,3}, {2,4}, {1,2}, {3,4}, {0,3}, {2,5}, {0,1}, {2,3}, {4,5}, {1,2}, {3,4} };
+		constexpr uint8 cNetwork7[][2] = { {0,6}, {2,3}, {4,5}, {0,2}, {1,4}, {3,6}, {0,1}, {2,5}, {3,4}, {1,2}, {4,6}, {2,3}, {4,5}, {1,2}, {3,4}, {5,6} };
+		constexpr uint8 cNetwork8[][2] = { {0,2}, {1,3}, {4,6}, {5,7}, {0,4}, {1,5}, {2,6}, {3,7}, {0,1}, {2,3}, {4,5}, {6,7}, {2,4}, {3,5}, {1,4}, {3,6}, {1,2}, {3,4}, {5,6} };
+
+		switch (inSize)
+		{
+		case 0:
+		case 1: break;
+		case 2: CompareSwap(ioData[0], ioData[1], inLess); break;
+		case 3: ApplySortingNetwork(ioData, cNetwork3, inLess); break;
+		case 4: ApplySortingNetwork(ioData, cNetwork4, inLess); break;
+		case 5: ApplySortingNetwork(ioData, cNetwork5, inLess); break;
+		case 6: ApplySortingNetwork(ioData, cNetwork6, inLess); break;
+		case 7: ApplySortingNetwork(ioData, cNetwork7, inLess); break;
+		case 8: ApplySortingNetwork(ioData, cNetwork8, inLess); break;
+		default: gAssert(false); break;
+		}
+	}
+
+
+	// Stable insertion sort.
+	// If taUnguarded is true, there must be an element before inBegin that is not greater than any element in the range.
+	template <bool taUnguarded = false, typename taType, typename taLess>
+	constexpr void InsertionSort(taType* inBegin, taType* inEnd, taLess& inLess)
+	{
+		if (inBegin == inEnd)
+			return;
+
+		for (taType* current = inBegin + 1; current != inEnd; ++current)
+		{
+			taType* sift = current;
+			if (!inLess(*sift, *(sift - 1)))
+				continue;
+
+			// Shift the greater elements to the right until the position of current is found.
+			taType value = gMove(*sift);
+			do
+			{
+				*sift = gMove(*(sift - 1));
+				--sift;
+			}
+			while ((taUnguarded || sift != inBegin) && inLess(value, *(sift - 1)));
+
+			*sift = gMove(value);
+		}
+	}
+
+
+	// Insertion sort that gives up if it needs to move too many elements. Return true if the range was sorted.
+	// Used to quickly finish ranges that are already (almost) sorted.
+	template <typename taType, typename taLess>
+	constexpr bool PartialInsertionSort(taType* inBegin, taType* inEnd, taLess& inLess)
+	{
+		int num_moves = 0;
+
+		for (taType* current = inBegin + 1; current < inEnd; ++current)
+		{
+			taType* sift = current;
+			if (!inLess(*sift, *(sift - 1)))
+				continue;
+
+			taType value = gMove(*sift);
+			do
+			{
+				*sift = gMove(*(sift - 1));
+				--sift;
+			}
+			while (sift != inBegin && inLess(value, *(sift - 1)));
+
+			*sift = gMove(value);
+
+			num_moves += (int)(current - sift);
+			if (num_moves > cPartialInsertionSortLimit)
+				return false;
+		}
+
+		return true;
+	}
+
+
+	// Sort a small range. There must be an element before inBegin that is not greater than any element in the range unless inLeftmost is true.
+	template <typename taType, typename taLess>
+	force_inline constexpr void SmallSort(taType* inBegin, taType* inEnd, taLess& inLess, bool inLeftmost)
+	{
+		int size = (int)(inEnd - inBegin);
+
+		if (size <= 8)
+			SortingNetwork(inBegin, size, inLess);
+		else if (inLeftmost)
+			InsertionSort(inBegin, inEnd, inLess);
+		else
+			InsertionSort<true>(inBegin, inEnd, inLess);
+	}
+
+
+	// Move the element at inIndex down the max-heap [ioHeap, ioHeap + inSize) until the heap property is restored.
+	template <typename taType, typename taLess>
+	constexpr void SiftDown(taType* ioHeap, int inSize, int inIndex, taLess& inLess)
+	{
+		taType value = gMove(ioHeap[inIndex]);
+
+		while (true)
+		{
+			int child = inIndex * 2 + 1;
+			if (child >= inSize)
+				break;
+
+			// Pick the greater child.
+			if (child + 1 < inSize && inLess(ioHeap[child], ioHeap[child + 1]))
+				child++;
+
+			if (!inLess(value, ioHeap[child]))
+				break;
+
+			ioHeap[inIndex] = gMove(ioHeap[child]);
+			inIndex         = child;
+		}
+
+		ioHeap[inIndex] = gMove(value);
+	}
+
+
+	template <typename taType, typename taLess>
+	constexpr void MakeHeap(taType* ioHeap, int inSize, taLess& inLess)
+	{
+		for (int i = inSize / 2 - 1; i >= 0; --i)
+			SiftDown(ioHeap, inSize, i, inLess);
+	}
+
+
+	// Sort a max-heap in place.
+	template <typename taType, typename taLess>
+	constexpr void SortHeap(taType* ioHeap, int inSize, taLess& inLess)
+	{
+		for (int size = inSize - 1; size > 0; --size)
+		{
+			gSwap(ioHeap[0], ioHeap[size]);
+			SiftDown(ioHeap, size, 0, inLess);
+		}
+	}
+
+
+	template <typename taType, typename taLess>
+	constexpr void HeapSort(taType* inBegin, taType* inEnd, taLess& inLess)
+	{
+		int size = (int)(inEnd - inBegin);
+		MakeHeap(inBegin, size, inLess);
+		SortHeap(inBegin, size, inLess);
+	}
+
+
+	// Move the median of 3 (or of 9 for large ranges) to inBegin, to be used as pivot.
+	template <typename taType, typename taLess>
+	constexpr void ChoosePivot(taType* inBegin, taType* inEnd, taLess& inLess)
+	{
+		int size = (int)(inEnd - inBegin);
+		int half = size / 2;
+
+		if (size > cNintherThreshold)
+		{
+			// Tukey's ninther.
+			Sort3(inBegin[0], inBegin[half], inEnd[-1], inLess);
+			Sort3(inBegin[1], inBegin[half - 1], inEnd[-2], inLess);
+			Sort3(inBegin[2], inBegin[half + 1], inEnd[-3], inLess);
+			Sort3(inBegin[half - 1], inBegin[half], inBegin[half + 1], inLess);
+			gSwap(inBegin[0], inBegin[half]);
+		}
+		else
+		{
+			Sort3(inBegin[half], inBegin[0], inEnd[-1], inLess);
+		}
+	}
+
+
+	// Partition [inBegin, inEnd) around the pivot at inBegin. Elements equal to the pivot go to the right.
+	// Return the final position of the pivot, and set outAlreadyPartitioned if no element had to be swapped.
+	// There must be an element not less than the pivot at the end of the range (ChoosePivot guarantees it).
+	template <typename taType, typename taLess>
+	constexpr taType* PartitionRight(taType* inBegin, taType* inEnd, taLess& inLess, bool& outAlreadyPartitioned)
+	{
+		taType pivot = gMove(*inBegin);
+
+		taType* first = inBegin;
+		taType* last  = inEnd;
+
+		// Find the first element not less than the pivot.
+		while (inLess(*++first, pivot)) {}
+
+		// Find the last element less than the pivot. Only needs a bounds check if no element was less than the pivot so far.
+		if (first - 1 == inBegin)
+			while (first < last && !inLess(*--last, pivot)) {}
+		else
+			while (!inLess(*--last, pivot)) {}
+
+		outAlreadyPartitioned = first >= last;
+
+		// Swap the misplaced elements. No bounds check needed since the previous loops left sentinels on both sides.
+		while (first < last)
+		{
+			gSwap(*first, *last);
+			while (inLess(*++first, pivot)) {}
+			while (!inLess(*--last, pivot)) {}
+		}
+
+		// Put the pivot in its final position.
+		taType* pivot_pos = first - 1;
+		*inBegin   = gMove(*pivot_pos);
+		*pivot_pos = gMove(pivot);
+
+		return pivot_pos;
+	}
+
+
+	// Partition [inBegin, inEnd) around the pivot at inBegin. Elements equal to the pivot go to the left.
+	// Used when the pivot is equal to the element before the range: all the elements equal to it are then already in their final place.
+	template <typename taType, typename taLess>
+	constexpr taType* PartitionLeft(taType* inBegin, taType* inEnd, taLess& inLess)
+	{
+		taType pivot = gMove(*inBegin);
+
+		taType* first = inBegin;
+		taType* last  = inEnd;
+
+		while (inLess(pivot, *--last)) {}
+
+		if (last + 1 == inEnd)
+			while (first < last && !inLess(pivot, *++first)) {}
+		else
+			while (!inLess(pivot, *++first)) {}
+
+		while (first < last)
+		{
+			gSwap(*first, *last);
+			while (inLess(pivot, *--last)) {}
+			while (!inLess(pivot, *++first)) {}
+		}
+
+		taType* pivot_pos = last;
+		*inBegin   = gMove(*pivot_pos);
+		*pivot_pos = gMove(pivot);
+
+		return pivot_pos;
+	}
+
+
+	// Swap a few elements around to break patterns that lead to unbalanced partitions.
+	template <typename taType>
+	constexpr void BreakPatterns(taType* inBegin, taType* inEnd)
+	{
+		int size    = (int)(inEnd - inBegin);
+		int quarter = size / 4;
+
+		if (size >= cInsertionSortThreshold)
+		{
+			gSwap(inBegin[0], inBegin[quarter]);
+			gSwap(inEnd[-1], inEnd[-quarter]);
+
+			if (size > cNintherThreshold)
+			{
+				gSwap(inBegin[1], inBegin[quarter + 1]);
+				gSwap(inBegin[2], inBegin[quarter + 2]);
+				gSwap(inEnd[-2], inEnd[-quarter - 1]);
+				gSwap(inEnd[-3], inEnd[-quarter - 2]);
+			}
+		}
+	}
+
+
+	// Pattern-defeating quicksort (Orson Peters).
+	// A quicksort that detects already sorted and all-equal ranges, and falls back to heap sort after too many bad partitions
+	// to guarantee O(n log n).
+	template <typename taType, typename taLess>
+	constexpr void PdqSort(taType* inBegin, taType* inEnd, taLess& inLess, int inBadPartitionsAllowed, bool inLeftmost)
+	{
+		while (true)
+		{
+			int size = (int)(inEnd - inBegin);
+
+			if (size < cInsertionSortThreshold)
+			{
+				SmallSort(inBegin, inEnd, inLess, inLeftmost);
+				return;
+			}
+
+			ChoosePivot(inBegin, inEnd, inLess);
+
+			// If the pivot is equal to the element before the range (the pivot of the parent partition), all the elements
+			// equal to it can be put on the left and don't need to be sorted further. This makes many equal elements O(n).
+			if (!inLeftmost && !inLess(inBegin[-1], inBegin[0]))
+			{
+				inBegin = PartitionLeft(inBegin, inEnd, inLess) + 1;
+				continue;
+			}
+
+			bool    already_partitioned;
+			taType* pivot_pos = PartitionRight(inBegin, inEnd, inLess, already_partitioned);
+
+			int left_size  = (int)(pivot_pos - inBegin);
+			int right_size = (int)(inEnd - (pivot_pos + 1));
+
+			if (left_size < size / 8 || right_size < size / 8)
+			{
+				// Very unbalanced partition. Too many of them and we switch to heap sort.
+				if (--inBadPartitionsAllowed == 0)
+				{
+					HeapSort(inBegin, inEnd, inLess);
+					return;
+				}
+
+				BreakPatterns(inBegin, pivot_pos);
+				BreakPatterns(pivot_pos + 1, inEnd);
+			}
+			else if (already_partitioned)
+			{
+				// Nothing was swapped, the range might already be sorted. Try to finish it cheaply.
+				if (PartialInsertionSort(inBegin, pivot_pos, inLess) && PartialInsertionSort(pivot_pos + 1, inEnd, inLess))
+					return;
+			}
+
+			// Recurse on the left part, loop on the right part.
+			PdqSort(inBegin, pivot_pos, inLess, inBadPartitionsAllowed, inLeftmost);
+			inBegin    = pivot_pos + 1;
+			inLeftmost = false;
+		}
+	}
+
+
+	// Merge the sorted ranges [inBegin, inMiddle) and [inMiddle, inEnd) in place, using ioBuffer as scratch memory
+	// (uninitialized, large enough for [inBegin, inMiddle)).
+	template <typename taType, typename taLess>
+	void MergeWithBuffer(taType* inBegin, taType* inMiddle, taType* inEnd, taType* ioBuffer, taLess& inLess)
+	{
+		// Move the left range into the buffer.
+		int left_size = (int)(inMiddle - inBegin);
+		for (int i = 0; i < left_size; ++i)
+			gPlacementNew(ioBuffer[i], gMove(inBegin[i]));
+
+		taType* left     = ioBuffer;
+		taType* left_end = ioBuffer + left_size;
+		taType* right    = inMiddle;
+		taType* out      = inBegin;
+
+		// Take from the right only if strictly less, to keep equal elements in order.
+		while (left != left_end && right != inEnd)
+		{
+			if (inLess(*right, *left))
+				*out++ = gMove(*right++);
+			else
+				*out++ = gMove(*left++);
+		}
+
+		// The rest of the right range is already in place.
+		while (left != left_end)
+			*out++ = gMove(*left++);
+
+		for (int i = 0; i < left_size; ++i)
+			ioBuffer[i].~taType();
+	}
+
+
+	template <typename taType, typename taLess>
+	void StableSort(taType* inBegin, taType* inEnd, taType* ioBuffer, taLess& inLess)
+	{
+		if (inEnd - inBegin <= cInsertionSortThreshold)
+		{
+			InsertionSort(inBegin, inEnd, inLess);
+			return;
+		}
+
+		taType* middle = inBegin + (inEnd - inBegin) / 2;
+		StableSort(inBegin, middle, ioBuffer, inLess);
+		StableSort(middle, inEnd, ioBuffer, inLess);
+
+		// Skip the merge if the two halves are already in order.
+		if (inLess(*middle, *(middle - 1)))
+			MergeWithBuffer(inBegin, middle, inEnd, ioBuffer, inLess);
+	}
+}
+
+
+// Return true if the range [inBegin, inEnd) is sorted.
+template <typename taType, typename taLess = Less>
+constexpr bool gIsSorted(const taType* inBegin, const taType* inEnd, taLess inLess = {})
+{
+	for (const taType* it = inBegin + 1; it < inEnd; ++it)
+		if (inLess(*it, *(it - 1)))
+			return false;
+
+	return true;
+}
+
+
+// Return true if a container is sorted.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+constexpr bool gIsSorted(const taContainer& inContainer, taLess inLess = {})
+{
+	Span span(inContainer);
+	return gIsSorted(span.Begin(), span.End(), inLess);
+}
+
+
+// Sort the range [inBegin, inEnd). Not stable.
+// Pattern-defeating quicksort: O(n log n) worst case, O(n) for sorted, reverse sorted and all-equal ranges.
+template <typename taType, typename taLess = Less>
+constexpr void gSort(taType* inBegin, taType* inEnd, taLess inLess = {})
+{
+	int size = (int)(inEnd - inBegin);
+	if (size <= 1)
+		return;
+
+	// Allow about log2(size) bad partitions before switching to heap sort.
+	int bad_partitions_allowed = 64 - gCountLeadingZeros64((uint64)size);
+	Details::PdqSort(inBegin, inEnd, inLess, bad_partitions_allowed, true);
+}
+
+
+// Sort a container. Not stable.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+constexpr void gSort(taContainer&& ioContainer, taLess inLess = {})
+{
+	Span span(ioContainer);
+	gSort(span.Begin(), span.End(), inLess);
+}
+
+
+// Sort the range [inBegin, inEnd), keeping equal elements in their original order.
+// Merge sort, uses temp memory for a scratch buffer of half the size of the range.
+template <typename taType, typename taLess = Less>
+void gStableSort(taType* inBegin, taType* inEnd, taLess inLess = {})
+{
+	int size = (int)(inEnd - inBegin);
+	if (size <= Details::cInsertionSortThreshold)
+	{
+		Details::InsertionSort(inBegin, inEnd, inLess);
+		return;
+	}
+
+	// The left half is the largest range that will be merged.
+	int     buffer_size = size - size / 2;
+	taType* buffer      = TempAllocator<taType>::Allocate(buffer_size);
+
+	Details::StableSort(inBegin, inEnd, buffer, inLess);
+
+	TempAllocator<taType>::Free(buffer, buffer_size);
+}
+
+
+// Sort a container, keeping equal elements in their original order.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+void gStableSort(taContainer&& ioContainer, taLess inLess = {})
+{
+	Span span(ioContainer);
+	gStableSort(span.Begin(), span.End(), inLess);
+}
+
+
+// Rearrange [inBegin, inEnd) so that [inBegin, inMiddle) contains the smallest elements in sorted order.
+// The order of the other elements is unspecified. Heap select: O(n log k) with k = inMiddle - inBegin.
+template <typename taType, typename taLess = Less>
+constexpr void gPartialSort(taType* inBegin, taType* inMiddle, taType* inEnd, taLess inLess = {})
+{
+	gAssert(inBegin <= inMiddle && inMiddle <= inEnd);
+
+	int heap_size = (int)(inMiddle - inBegin);
+	if (heap_size == 0)
+		return;
+
+	// Keep the smallest elements in a max-heap, replacing the top whenever a smaller element is found.
+	Details::MakeHeap(inBegin, heap_size, inLess);
+
+	for (taType* it = inMiddle; it != inEnd; ++it)
+	{
+		if (inLess(*it, *inBegin))
+		{
+			gSwap(*it, *inBegin);
+			Details::SiftDown(inBegin, heap_size, 0, inLess);
+		}
+	}
+
+	Details::SortHeap(inBegin, heap_size, inLess);
+}
+
+
+// Rearrange a container so that its first inCount elements are the smallest ones, in sorted order.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+constexpr void gPartialSort(taContainer&& ioContainer, int inCount, taLess inLess = {})
+{
+	Span span(ioContainer);
+	gPartialSort(span.Begin(), span.Begin() + gMin(inCount, span.Size()), span.End(), inLess);
+}
+
+
+// Rearrange [inBegin, inEnd) so that inNth contains the element that would be there if the range was sorted,
+// with no greater element before it and no smaller element after it.
+// Introselect: quickselect with the same partitioning as gSort, falls back to heap select if the partitions are too unbalanced.
+template <typename taType, typename taLess = Less>
+constexpr void gNthElement(taType* inBegin, taType* inNth, taType* inEnd, taLess inLess = {})
+{
+	gAssert(inBegin <= inNth && inNth < inEnd);
+
+	int bad_partitions_allowed = 64 - gCountLeadingZeros64((uint64)(inEnd - inBegin));
+
+	while (inEnd - inBegin >= Details::cInsertionSortThreshold)
+	{
+		Details::ChoosePivot(inBegin, inEnd, inLess);
+
+		bool    already_partitioned;
+		taType* pivot_pos = Details::PartitionRight(inBegin, inEnd, inLess, already_partitioned);
+
+		if (pivot_pos == inNth)
+			return;
+
+		int size       = (int)(inEnd - inBegin);
+		int left_size  = (int)(pivot_pos - inBegin);
+		int right_size = (int)(inEnd - (pivot_pos + 1));
+
+		if (left_size < size / 8 || right_size < size / 8)
+		{
+			if (--bad_partitions_allowed == 0)
+			{
+				// Too many bad partitions, fall back to heap select (O(n log n) worst case).
+				gPartialSort(inBegin, inNth + 1, inEnd, inLess);
+				return;
+			}
+
+			Details::BreakPatterns(inBegin, pivot_pos);
+			Details::BreakPatterns(pivot_pos + 1, inEnd);
+		}
+
+		// Only continue with the partition that contains inNth.
+		if (inNth < pivot_pos)
+			inEnd = pivot_pos;
+		else
+			inBegin = pivot_pos + 1;
+	}
+
+	Details::InsertionSort(inBegin, inEnd, inLess);
+}
+
+
+// Rearrange a container so that the element at inIndex is the one that would be there if the container was sorted,
+// with no greater element before it and no smaller element after it.
+template <typename taContainer, typename taLess = Less>
+requires cIsSortable<taContainer, taLess>
+constexpr void gNthElement(taContainer&& ioContainer, int inIndex, taLess inLess = {})
+{
+	Span span(ioContainer);
+	gBoundsCheck(inIndex, span.Size());
+	gNthElement(span.Begin(), span.Begin() + inIndex, span.End(), inLess);
+}
@@ -13,9 +13,8 @@ REGISTER_TEST("String")
 		TEST_TRUE(test == "test");
 		TEST_TRUE(*test.End() == 0);
 
-		char* test_begin = test.Begin();
-		test.Reserve(30);
-		TEST_TRUE(test.Begin() != test_begin); // Should have re-allocated.
+		test.Reserve(30); // Note: The heap may grow the allocation in place, the data doesn't necessarily move.
+		TEST_TRUE(test == "test");
 		TEST_TRUE(test.Capacity() >= 30);
 		TEST_TRUE(test.Size() == 4);
 		TEST_TRUE(*test.End() == 0);
@@ -38,7 +37,7 @@ REGISTER_TEST("String")
 		TEST_TRUE(test == test_as_sv);
 		TEST_TRUE(test.Begin() == test_as_sv.Begin());
 
-		test_begin = test.Begin();
+		char* test_begin = test.Begin();
 		String moved_test = gMove(test);
 		TEST_TRUE(moved_test.Begin() == test_begin);
 		TEST_TRUE(test.Begin() == StringView().Begin());
@@ -143,6 +142,27 @@ REGISTER_TEST("TempString")
 };
 
 
+REGISTER_TEST("TempString Adjacent Values")
+{
+	TEST_INIT_TEMP_MEMORY(1_KiB);
+
+	// A string located right after the allocation of the string is not part of it, inserting it must not assert.
+	TempString test;
+	test.Reserve(16);
+	TEST_TRUE(test.Capacity() == 16);
+
+	MemBlock after = gTempMemArena.Alloc(16);
+	TEST_TRUE((char*)after.mPtr == test.Data() + test.Capacity());
+	gMemCopy(after.mPtr, "abc", 3);
+
+	test = "def";
+	test.Insert(0, StringView((const char*)after.mPtr, 3));
+	TEST_TRUE(test == "abcdef");
+
+	gTempMemArena.Free(after);
+};
+
+
 
 REGISTER_TEST("FixedString")
 {
@@ -177,3 +197,48 @@ REGISTER_TEST("FixedString")
 	test.ShrinkToFit();
 	TEST_TRUE(test.Capacity() == test.Size() + 1);
 };
+
+
+REGISTER_TEST("SmallString")
+{
+	SmallString<8> test = "test";
+
+	char* inline_begin = test.Begin();
+	TEST_TRUE(test.GetAllocator().IsInline(inline_begin));
+	TEST_TRUE(test == "test");
+
+	// Grows in place up to the inline capacity.
+	test.Append("abc");
+	TEST_TRUE(test.Begin() == inline_begin);
+	TEST_TRUE(test == "testabc");
+
+	// Spills to the heap.
+	test.Append("defgh");
+	TEST_TRUE(!test.GetAllocator().IsInline(test.Begin()));
+	TEST_TRUE(test == "testabcdefgh");
+	TEST_TRUE(*test.End() == 0);
+
+	// Moving a heap string steals the memory.
+	char* heap_begin = test.Begin();
+	SmallString<8> moved = gMove(test);
+	TEST_TRUE(moved.Begin() == heap_begin);
+	TEST_TRUE(test.Empty());
+
+	// ShrinkToFit moves the string back inline.
+	moved.Resize(3);
+	moved.ShrinkToFit();
+	TEST_TRUE(moved.GetAllocator().IsInline(moved.Begin()));
+	TEST_TRUE(moved == "tes");
+	TEST_TRUE(moved.Capacity() == 4);
+
+	// Moving an inline string copies it.
+	test = gMove(moved);
+	TEST_TRUE(test.GetAllocator().IsInline(test.Begin()));
+	TEST_TRUE(test == "tes");
+	TEST_TRUE(moved.Empty());
+
+	// Temp memory as fallback.
+	SmallString<4, TempAllocator<char>> temp = "temp memory";
+	TEST_TRUE(gTempMemArena.Owns(temp.Begin()));
+	TEST_TRUE(temp == "temp memory");
+};
@@ -21,6 +21,12 @@ using TempString = StringBase<TempAllocator<char>>;
 template <int taCapacity>
 using FixedString = StringBase<FixedAllocator<char, taCapacity>>;
 
+// Alias for a String using a SmallAllocator.
+// It contains a buffer that can hold taCapacity, including the null terminator, and allocates from taFallbackAllocator for longer strings.
+// ShrinkToFit moves the string back into the buffer if it fits.
+template <int taCapacity, typename taFallbackAllocator = DefaultAllocator<char>>
+using SmallString = StringBase<SmallAllocator<char, taCapacity, taFallbackAllocator>>;
+
 
 template <typename taAllocator>
 struct StringBase : StringView, private taAllocator
@@ -86,7 +92,7 @@ struct StringBase : StringView, private taAllocator
 	void Reserve(int inCapacity);	// Note: inCapacity includes the null terminator.
 	void Resize(int inSize);		// Note: inSize does not include the null terminator (it is stored at [Size()]).
 	void Clear() { Resize(0); }
-	void ShrinkToFit();				// Note: Only does somethig if the allocator supports TryRealloc (eg. TempAllocator).
+	void ShrinkToFit();				// Note: Only does somethig if the allocator supports TryRealloc (eg. TempAllocator) or has inline storage (eg. SmallAllocator).
 
 	void Insert(int inPosition, StringView inString);
 
@@ -107,6 +113,11 @@ struct StringBase : StringView, private taAllocator
 	void operator+=(StringView inString) { Append(inString); }
 
 private:
+	// Optional allocator features (see DefaultAllocator).
+	static constexpr bool cHasAllocateAtLeast = requires (taAllocator& ioAllocator, int& ioSize) { ioAllocator.AllocateAtLeast(ioSize); };
+	static constexpr bool cHasReallocate      = requires (taAllocator& ioAllocator, char* inPtr, int& ioSize) { ioAllocator.Reallocate(inPtr, 0, ioSize); };
+	static constexpr bool cHasInlineStorage   = requires (const taAllocator& inAllocator, const char* inPtr) { inAllocator.IsInline(inPtr); };
+
 	void MoveFrom(StringBase&& ioOther);
 	void CopyFrom(StringView inOther);
 
@@ -119,6 +130,9 @@ static_assert(sizeof(StringBase<DefaultAllocator<char>>) == 16);
 // String is a contiguous container.
 template<typename T> inline constexpr bool cIsContiguous<StringBase<T>> = true;
 
+// String can be relocated with a memcpy if its allocator can (eg. not FixedString, which points to its own buffer).
+template<typename T> inline constexpr bool cIsTriviallyRelocatable<StringBase<T>> = cIsTriviallyRelocatable<T>;
+
 
 template <typename taAllocator>
 struct Hash<StringBase<taAllocator>> : Hash<StringView> {};
@@ -200,9 +214,27 @@ void StringBase<taAllocator>::Reserve(int inCapacity)
 	if (mData != cEmpty && Allocator::TryRealloc(mData, old_capacity, mCapacity))
 		return; // Success, nothing else to do.
 
+	// Let the allocator move the data if it can (it might be able to grow in place).
+	if constexpr (cHasReallocate)
+	{
+		if (mData != cEmpty)
+		{
+			char* new_data = Allocator::Reallocate(mData, old_capacity, mCapacity);
+			if (new_data != nullptr) [[likely]]
+			{
+				mData = new_data;
+				return;
+			}
+		}
+	}
+
 	// Allocate new data.
+	// If the allocator can tell, use the actual size of the allocation as capacity.
 	char* old_data = mData;
-	mData = Allocator::Allocate(mCapacity);
+	if constexpr (cHasAllocateAtLeast)
+		mData = Allocator::AllocateAtLeast(mCapacity);
+	else
+		mData = Allocator::Allocate(mCapacity);
 
 	// Copy old data to new.
 	gMemCopy(mData, old_data, mSize);
@@ -229,7 +261,25 @@ void StringBase<taAllocator>::Resize(int inSize)
 
 template <typename taAllocator> void StringBase<taAllocator>::ShrinkToFit()
 {
-	if (mData == cEmpty || mCapacity == (mSize + 1))
+	if (mData == cEmpty)
+		return;
+
+	if constexpr (cHasInlineStorage)
+	{
+		// If the string fits in the inline storage, move it back there.
+		if (mSize + 1 <= taAllocator::cInlineSize && !GetAllocator().IsInline(mData))
+		{
+			char* old_data = mData;
+			mData = Allocator::Allocate(mSize + 1);
+			gMemCopy(mData, old_data, mSize + 1);
+
+			Allocator::Free(old_data, mCapacity);
+			mCapacity = mSize + 1;
+			return;
+		}
+	}
+
+	if (mCapacity == (mSize + 1))
 		return;
 
 	if (Allocator::TryRealloc(mData, mCapacity, mSize + 1))
@@ -245,7 +295,7 @@ void StringBase<taAllocator>::Insert(int inPosition, StringView inString)
 
 	gBoundsCheck(inPosition, mSize + 1);
 	// Copying from self is not allowed.
-	gAssert(mData > inString.End() || (mData + mCapacity) < inString.Begin() || inString.Empty());
+	gAssert(mData >= inString.End() || (mData + mCapacity) <= inString.Begin() || inString.Empty());
 
 	Reserve(mSize + inString.Size() + 1);
 
@@ -299,6 +349,21 @@ void StringBase<taAllocator>::MoveFrom(StringBase&& ioOther)
 		GetAllocator() = gMove(ioOther.GetAllocator());
 		ioOther.GetAllocator() = Allocator();
 
+		if constexpr (cHasInlineStorage)
+		{
+			// If the data is inside the other allocator, it can't be stolen. Copy it instead.
+			if (ioOther.GetAllocator().IsInline(ioOther.mData))
+			{
+				mData     = const_cast<char*>(cEmpty);
+				mSize     = 0;
+				mCapacity = 1;
+				CopyFrom(ioOther);
+
+				ioOther.Resize(0);
+				return;
+			}
+		}
+
 		mData     = ioOther.mData;
 		mSize     = ioOther.mSize;
 		mCapacity = ioOther.mCapacity;
@@ -1,10 +1,223 @@
 // SPDX-License-Identifier: MPL-2.0
 #include <Bedrock/TempMemory.h>
+#include <Bedrock/Vector.h>
+#include <Bedrock/Test.h>
+#include <Bedrock/Thread.h>
+
+
+static TempMemoryConfig sTempMemoryConfig;
+
+
+void gSetTempMemoryConfig(const TempMemoryConfig& inConfig)
+{
+	sTempMemoryConfig = inConfig;
+}
+
+
+const TempMemoryConfig& gGetTempMemoryConfig()
+{
+	return sTempMemoryConfig;
+}
+
+
+TempMemArena& TempMemArena::operator=(TempMemArena&& ioOther)
+{
+	gAssert(GetAllocatedSize() == 0);
+
+	mFixedArena = gMove(ioOther.mFixedArena);
+
+	for (int i = 0; i < cMaxVMemBlocks; ++i)
+		mVMemBlocks[i] = gMove(ioOther.mVMemBlocks[i]);
+
+	mNumVMemBlocks = ioOther.mNumVMemBlocks;
+	mNumOverflows  = ioOther.mNumOverflows;
+	mScopeDepth    = ioOther.mScopeDepth;
+
+	ioOther.mNumVMemBlocks = 0;
+	ioOther.mNumOverflows  = 0;
+	ioOther.mScopeDepth    = 0;
+
+	return *this;
+}
+
+
+MemBlock TempMemArena::AllocInNewVMemBlock(int inSize, int inAlignment)
+{
+	if (mNumVMemBlocks == cMaxVMemBlocks) [[unlikely]]
+		return {}; // Out of blocks, let the caller fall back to something else.
+
+	// If there is already some memory, this is an overflow. Otherwise it's the lazy initialization.
+	bool is_overflow = mNumVMemBlocks > 0 || mFixedArena.GetMemBlock() != nullptr;
+
+	const TempMemoryConfig& config        = gGetTempMemoryConfig();
+	int64                   reserved_size = gMax(config.mReservedSize, (int64)gAlignUp(inSize, cAlignment) + inAlignment);
+
+	VMemArena<>& block = mVMemBlocks[mNumVMemBlocks];
+	block              = VMemArena<>(reserved_size, config.mCommitIncreaseSize);
+
+	if (block.GetReservedSize() == 0) [[unlikely]]
+		return {}; // Failed to reserve memory.
+
+	mNumVMemBlocks++;
+
+	// Everything allocated in this block is inside the active scopes, if any.
+	if (mScopeDepth > 0)
+		(void)block.BeginScope();
+
+	if (is_overflow)
+		mNumOverflows++;
+
+	return block.Alloc(inSize, inAlignment);
+}
+
+
+void TempMemArena::Free(MemBlock inMemory, int inAlignment)
+{
+	for (int i = mNumVMemBlocks - 1; i >= 0; --i)
+	{
+		if (mVMemBlocks[i].Owns(inMemory.mPtr))
+		{
+			mVMemBlocks[i].Free(inMemory, inAlignment);
+			ReleaseEmptyVMemBlocks();
+			return;
+		}
+	}
+
+	mFixedArena.Free(inMemory, inAlignment);
+}
+
+
+bool TempMemArena::TryRealloc(MemBlock& ioMemory, int inNewSize)
+{
+	for (int i = mNumVMemBlocks - 1; i >= 0; --i)
+	{
+		if (mVMemBlocks[i].Owns(ioMemory.mPtr))
+			return mVMemBlocks[i].TryRealloc(ioMemory, inNewSize);
+	}
+
+	return mFixedArena.TryRealloc(ioMemory, inNewSize);
+}
+
+
+bool TempMemArena::Owns(const void* inMemoryPtr) const
+{
+	for (int i = mNumVMemBlocks - 1; i >= 0; --i)
+	{
+		if (mVMemBlocks[i].Owns(inMemoryPtr))
+			return true;
+	}
+
+	return mFixedArena.Owns(inMemoryPtr);
+}
+
+
+bool TempMemArena::IsLastAlloc(MemBlock inMemory) const
+{
+	for (int i = mNumVMemBlocks - 1; i >= 0; --i)
+	{
+		if (mVMemBlocks[i].Owns(inMemory.mPtr))
+			return mVMemBlocks[i].IsLastAlloc(inMemory);
+	}
+
+	return mFixedArena.IsLastAlloc(inMemory);
+}
+
+
+int TempMemArena::GetAllocatedSize() const
+{
+	int allocated_size = mFixedArena.GetAllocatedSize();
+	for (int i = 0; i < mNumVMemBlocks; ++i)
+		allocated_size += mVMemBlocks[i].GetAllocatedSize();
+
+	return allocated_size;
+}
+
+
+TempMemArena::Marker TempMemArena::GetMarker() const
+{
+	if (mNumVMemBlocks > 0)
+		return { mNumVMemBlocks, mVMemBlocks[mNumVMemBlocks - 1].GetMarker() };
+	else
+		return { 0, mFixedArena.GetMarker() };
+}
+
+
+void TempMemArena::Rewind(Marker inMarker)
+{
+	ReleaseVMemBlocksAfter(inMarker.mNumVMemBlocks);
+
+	if (mNumVMemBlocks > 0)
+		mVMemBlocks[mNumVMemBlocks - 1].Rewind(inMarker.mBlockMarker);
+	else
+		mFixedArena.Rewind(inMarker.mBlockMarker);
+
+	ReleaseEmptyVMemBlocks();
+}
+
+
+TempMemArena::Marker TempMemArena::BeginScope()
+{
+	mScopeDepth++;
+
+	if (mNumVMemBlocks > 0)
+		return { mNumVMemBlocks, mVMemBlocks[mNumVMemBlocks - 1].BeginScope() };
+	else
+		return { 0, mFixedArena.BeginScope() };
+}
+
+
+void TempMemArena::EndScope(Marker inMarker)
+{
+	gAssert(mScopeDepth > 0);
+
+	ReleaseVMemBlocksAfter(inMarker.mNumVMemBlocks);
+
+	if (mNumVMemBlocks > 0)
+		mVMemBlocks[mNumVMemBlocks - 1].EndScope(inMarker.mBlockMarker);
+	else
+		mFixedArena.EndScope(inMarker.mBlockMarker);
+
+	mScopeDepth--;
+
+	ReleaseEmptyVMemBlocks();
+}
+
+
+// Release the blocks created after a marker, along with everything allocated in them.
+void TempMemArena::ReleaseVMemBlocksAfter(int inNumVMemBlocks)
+{
+	while (mNumVMemBlocks > inNumVMemBlocks)
+	{
+		VMemArena<>& block = mVMemBlocks[mNumVMemBlocks - 1];
+		block.Rewind({});
+		block = {};
+		mNumVMemBlocks--;
+	}
+}
+
+
+// Release the overflow blocks that became empty.
+// The first block is kept if there is no fixed memory block (it's the lazily initialized one).
+// Blocks are kept while a scope is active since the scope markers might point to them.
+void TempMemArena::ReleaseEmptyVMemBlocks()
+{
+	if (mScopeDepth > 0)
+		return;
+
+	int min_num_blocks = (mFixedArena.GetMemBlock() == nullptr) ? 1 : 0;
+
+	while (mNumVMemBlocks > min_num_blocks && mVMemBlocks[mNumVMemBlocks - 1].GetAllocatedSize() == 0)
+	{
+		mVMemBlocks[mNumVMemBlocks - 1] = {};
+		mNumVMemBlocks--;
+	}
+}
 
 
 void gThreadInitTempMemory(MemBlock inMemory)
 {
 	gAssert(gTempMemArena.GetMemBlock() == nullptr); // Already initialized.
+	gAssert(gTempMemArena.GetAllocatedSize() == 0);  // Already lazily initialized and in use.
 
 	gTempMemArena = { inMemory };
 }
@@ -21,4 +234,94 @@ MemBlock gThreadExitTempMemory()
 }
 
 
+REGISTER_TEST("TempMemScope")
+{
+	int allocated_size = gTempMemArena.GetAllocatedSize();
+
+	{
+		TempMemScope scope;
+
+		// Free a lot of blocks in the wrong order. Outside of a scope, this would run out of pending frees.
+		MemBlock blocks[cDefaultMaxPendingFrees * 2];
+		for (MemBlock& block : blocks)
+			block = gTempMemArena.Alloc(16);
+
+		for (MemBlock& block : blocks)
+			gTempMemArena.Free(block);
+
+		TempVector<int> values = { 1, 2, 3 };
+		TEST_TRUE(gTempMemArena.GetAllocatedSize() > allocated_size);
+	}
+
+	TEST_TRUE(gTempMemArena.GetAllocatedSize() == allocated_size);
+};
+
+
+REGISTER_TEST("TempMemory Overflow")
+{
+	TEST_INIT_TEMP_MEMORY(1_KiB);
+
+	TEST_TRUE(gTempMemArena.GetNumOverflows() == 0);
+
+	MemBlock small = gTempMemArena.Alloc(512);
+
+	// Doesn't fit in the fixed block, a new block is chained instead of failing.
+	TempVector<uint8> large;
+	large.Resize(4_KiB);
+	TEST_TRUE(gTempMemArena.Owns(large.Begin()));
+	TEST_TRUE(gTempMemArena.GetNumOverflows() == 1);
+	TEST_TRUE(gTempMemArena.GetAllocatedSize() == 512 + 4_KiB);
+
+	// Free out of order. The overflow block is released when it's empty, the fixed block stays.
+	gTempMemArena.Free(small);
+	large.ClearAndFreeMemory();
+	TEST_TRUE(gTempMemArena.GetAllocatedSize() == 0);
+
+	// Scopes rewind across blocks.
+	{
+		TempMemScope scope;
+		gTempMemArena.Alloc(512);
+		gTempMemArena.Alloc(4_KiB);
+		TEST_TRUE(gTempMemArena.GetNumOverflows() == 2);
+	}
+
+	TEST_TRUE(gTempMemArena.GetAllocatedSize() == 0);
+};
+
+
+REGISTER_TEST("TempMemory Aligned")
+{
+	TEST_INIT_TEMP_MEMORY(4_KiB);
+
+	// The alignment padding isn't a pending free, having many over-aligned allocations alive doesn't overflow.
+	MemBlock blocks[cDefaultMaxPendingFrees * 2];
+	for (MemBlock& block : blocks)
+	{
+		block = gTempMemArena.Alloc(16, 64);
+		TEST_TRUE(((uint64)block.mPtr % 64) == 0);
+	}
+
+	for (int i = (int)gElemCount(blocks) - 1; i >= 0; --i)
+		gTempMemArena.Free(blocks[i], 64);
+
+	TEST_TRUE(gTempMemArena.GetNumOverflows() == 0);
+	TEST_TRUE(gTempMemArena.GetAllocatedSize() == 0);
+};
+
+
+REGISTER_TEST("TempMemory Lazy Init")
+{
+	Thread thread;
+	thread.Create({ .mName = "TempMemoryTest", .mTempMemSize = 0 }, [](Thread&)
+	{
+		// No temp memory was provided, it's lazily initialized with virtual memory.
+		TempVector<int> values = { 1, 2, 3 };
+		TEST_TRUE(gTempMemArena.Owns(values.Begin()));
+		TEST_TRUE(gTempMemArena.GetMemBlock() == nullptr);
+		TEST_TRUE(gTempMemArena.GetNumOverflows() == 0);
 
+		// It can grow.
+		values.Resize(1'000'000);
+		TEST_TRUE(gTempMemArena.Owns(values.Begin()));
+	});
+};
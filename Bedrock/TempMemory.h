@@ -5,14 +5,106 @@
 #include <Bedrock/MemoryArena.h>
 
 
-// Initialize temporary memory for the current thread.
+struct TempMemoryConfig
+{
+	int64 mReservedSize       = 100_MiB; // Virtual memory reserved when temp memory is lazily initialized, and for each overflow block.
+	int64 mCommitIncreaseSize = 64_KiB;  // Virtual memory committed every time a lazily initialized temp memory (or an overflow block) grows.
+};
+
+// Change the config used to lazily initialize temp memory. Affects all threads. Should be called at startup.
+void                    gSetTempMemoryConfig(const TempMemoryConfig& inConfig);
+const TempMemoryConfig& gGetTempMemoryConfig();
+
+
+// Arena used for temporary memory.
+// Can be initialized with a fixed MemBlock (see gThreadInitTempMemory). Otherwise, it reserves virtual memory on first use and
+// commits it as needed, up to TempMemoryConfig::mReservedSize.
+// When the memory runs out, a new virtual memory block is chained on top instead of failing. It is released once empty.
+// Allocations must be freed in order in general, but a small number of out of order frees is supported (see MemArena).
+struct TempMemArena : NoCopy
+{
+	static constexpr int cAlignment     = MemArena<>::cAlignment;
+	static constexpr int cMaxVMemBlocks = 8; // Max number of virtual memory blocks, including the lazily initialized one.
+
+	TempMemArena() = default;
+	~TempMemArena() = default;
+
+	// Initialize this arena with a memory block.
+	TempMemArena(MemBlock inMemory) : mFixedArena(inMemory) {}
+
+	TempMemArena(TempMemArena&& ioOther) { operator=((TempMemArena&&)ioOther); }
+	TempMemArena& operator=(TempMemArena&& ioOther);
+
+	// Allocate memory. Initializes the arena first if necessary.
+	// Allocations are aligned to cAlignment, or to inAlignment if it is larger (see MemArena::Alloc).
+	MemBlock Alloc(int inSize, int inAlignment = cAlignment)
+	{
+		MemBlock memory;
+		if (mNumVMemBlocks > 0)
+			memory = mVMemBlocks[mNumVMemBlocks - 1].Alloc(inSize, inAlignment);
+		else if (mFixedArena.GetMemBlock() != nullptr)
+			memory = mFixedArena.Alloc(inSize, inAlignment);
+
+		if (memory == nullptr) [[unlikely]]
+			memory = AllocInNewVMemBlock(inSize, inAlignment);
+
+		return memory;
+	}
+
+	void Free(MemBlock inMemory, int inAlignment = cAlignment);
+	bool TryRealloc(MemBlock& ioMemory, int inNewSize);
+
+	bool Owns(const void* inMemoryPtr) const;
+	bool IsLastAlloc(MemBlock inMemory) const;
+
+	// Return the amount of memory currently allocated, in all blocks.
+	int GetAllocatedSize() const;
+
+	// Return the memory block this arena was initialized with, or a nullptr MemBlock if it uses virtual memory instead.
+	MemBlock GetMemBlock() const { return mFixedArena.GetMemBlock(); }
+
+	// Return the number of times the memory ran out and a new block had to be chained.
+	int GetNumOverflows() const { return mNumOverflows; }
+
+	// Markers and scopes, see MemArena.
+	struct Marker
+	{
+		int                mNumVMemBlocks = 0;
+		MemArena<>::Marker mBlockMarker;
+	};
+
+	Marker GetMarker() const;
+	void   Rewind(Marker inMarker);
+	Marker BeginScope();
+	void   EndScope(Marker inMarker);
+
+private:
+	MemBlock AllocInNewVMemBlock(int inSize, int inAlignment);
+	void     ReleaseVMemBlocksAfter(int inNumVMemBlocks);
+	void     ReleaseEmptyVMemBlocks();
+
+	MemArena<>  mFixedArena;						// Memory provided by gThreadInitTempMemory, if any.
+	VMemArena<> mVMemBlocks[cMaxVMemBlocks];		// Virtual memory blocks, chained on top of mFixedArena.
+	int         mNumVMemBlocks = 0;
+	int         mNumOverflows  = 0;
+	int         mScopeDepth    = 0;
+};
+
+
+// Initialize temporary memory for the current thread with a fixed memory block.
+// This is optional, otherwise temp memory is lazily initialized with virtual memory (see TempMemoryConfig).
 void gThreadInitTempMemory(MemBlock inMemory);
 
 // De-initialize temporary memory for the current thread.
+// Return the memory block passed to gThreadInitTempMemory, if any.
 [[nodiscard]] MemBlock gThreadExitTempMemory();
 
 // Thread-local arena that can be used for allocating temporary memory.
-using TempMemArena = MemArena<>;
 inline thread_local TempMemArena gTempMemArena;
 
-
+// Scope that frees all the temp memory allocated inside it at once when it ends (see MemArenaScope).
+// Out of order frees inside the scope are not tracked, so they can't run out of pending frees.
+struct TempMemScope : MemArenaScope<TempMemArena>
+{
+	TempMemScope() : MemArenaScope(gTempMemArena) {}
+};
@@ -4,34 +4,76 @@
 #include <Bedrock/Debug.h>
 #include <Bedrock/Test.h>
 
+#if defined(_WIN32)
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#else
+#error Unknown platform
+#endif
 
 struct ThreadInternal
 {
-	static DWORD WINAPI sThreadProc(LPVOID inParam)
+	static void sRun(Thread& ioThread)
 	{
-		Thread& thread = *(Thread*)inParam;
-
 		// Set the thread name.
-		if (!thread.mConfig.mName.Empty())
-			gSetCurrentThreadName(thread.mConfig.mName.AsCStr());
+		if (!ioThread.mConfig.mName.Empty())
+			gSetCurrentThreadName(ioThread.mConfig.mName.AsCStr());
 
 		// Allocate temp memory.
-		if (thread.mConfig.mTempMemSize > 0)
-			gThreadInitTempMemory(gMemAlloc(thread.mConfig.mTempMemSize));
+		if (ioThread.mConfig.mTempMemSize > 0)
+			gThreadInitTempMemory(gMemAlloc(ioThread.mConfig.mTempMemSize));
 
 		// Call the entry point.
-		thread.mEntryPoint(thread);
+		ioThread.mEntryPoint(ioThread);
 
 		// Free temp memory.
-		if (thread.mConfig.mTempMemSize > 0)
+		if (ioThread.mConfig.mTempMemSize > 0)
 			gMemFree(gThreadExitTempMemory());
+	}
+
+#if defined(_WIN32)
 
+	static DWORD WINAPI sThreadProc(LPVOID inParam)
+	{
+		sRun(*(Thread*)inParam);
 		return 0;
 	}
+
+#elif defined(__linux__)
+
+	static void* sThreadProc(void* inParam)
+	{
+		Thread& thread = *(Thread*)inParam;
+
+		thread.mOSThreadID = (uint32)gettid();
+
+		// Set the priority. There are no thread priorities for normal threads on Linux, but the nice value is per-thread.
+		// Note: Raising the priority (negative nice) needs privileges and will silently fail without them.
+		int nice_value = 0;
+		switch (thread.mConfig.mPriority)
+		{
+		case EThreadPriority::Idle:			nice_value = 19;	break;
+		case EThreadPriority::Lowest:		nice_value = 10;	break;
+		case EThreadPriority::BelowNormal:	nice_value = 5;		break;
+		case EThreadPriority::Normal:		nice_value = 0;		break;
+		case EThreadPriority::AboveNormal:	nice_value = -5;	break;
+		case EThreadPriority::Highest:		nice_value = -10;	break;
+		}
+		if (nice_value != 0)
+			setpriority(PRIO_PROCESS, thread.mOSThreadID, nice_value);
+
+		sRun(thread);
+		return nullptr;
+	}
+
+#endif
 };
 
 
@@ -41,6 +83,8 @@ Thread::~Thread()
 }
 
 
+#if defined(_WIN32)
+
 void Thread::Create(const ThreadConfig& inConfig, Function<void(Thread&)>&& ioEntryPoint)
 {
 	gAssert(mOSThread == nullptr); // There's already a thread running!
@@ -82,6 +126,44 @@ void Thread::Join()
 	Cleanup();
 }
 
+#elif defined(__linux__)
+
+void Thread::Create(const ThreadConfig& inConfig, Function<void(Thread&)>&& ioEntryPoint)
+{
+	gAssert(mOSThread == nullptr); // There's already a thread running!
+
+	mEntryPoint = gMove(ioEntryPoint);
+	mConfig     = inConfig;
+
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	pthread_attr_setstacksize(&attributes, gMax((int64)inConfig.mStackSize, (int64)PTHREAD_STACK_MIN));
+
+	// Note: The priority is set by the thread itself, see ThreadInternal::sThreadProc.
+	pthread_t thread;
+	int       result = pthread_create(&thread, &attributes, ThreadInternal::sThreadProc, this);
+	gAssert(result == 0);
+
+	pthread_attr_destroy(&attributes);
+
+	mOSThread = (OSThread)thread;
+}
+
+
+void Thread::Join()
+{
+	if (mOSThread == nullptr)
+		return;
+
+	// Wait for it to stop.
+	int result = pthread_join((pthread_t)mOSThread, nullptr);
+	gAssert(result == 0);
+
+	Cleanup();
+}
+
+#endif
+
 
 // Reset everything to default/empty.
 void Thread::Cleanup()
@@ -94,6 +176,15 @@ void Thread::Cleanup()
 }
 
 
+#if defined(_WIN32)
+
+// Return the OS ID of the current thread.
+uint32 gGetCurrentThreadID()
+{
+	return GetCurrentThreadId();
+}
+
+
 // Number of threads that can run concurrently.
 // Equivalent to the number of CPU cores (incuding hyperthreading logical cores).
 int gThreadHardwareConcurrency()
@@ -109,12 +200,41 @@ int gThreadHardwareConcurrency()
 
 
 // Yield the processor to other threads that are ready to run.
-void gYieldThread()
+void gThreadYield()
 {
 	SwitchToThread();
 }
 
 
+#elif defined(__linux__)
+
+// Return the OS ID of the current thread.
+uint32 gGetCurrentThreadID()
+{
+	return (uint32)gettid();
+}
+
+
+// Number of threads that can run concurrently.
+// Equivalent to the number of CPU cores (incuding hyperthreading logical cores).
+int gThreadHardwareConcurrency()
+{
+	static const int number_of_cpus = [] {
+		return gMax(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+	}();
+
+	return number_of_cpus;
+}
+
+
+// Yield the processor to other threads that are ready to run.
+void gThreadYield()
+{
+	sched_yield();
+}
+
+#endif
+
 REGISTER_TEST("Thread")
 {
 	Thread thread;
@@ -133,7 +253,7 @@ REGISTER_TEST("Thread")
 			set_by_thread = true;
 
 			while (!ioSelf.IsStopRequested())
-				gYieldThread();
+				gThreadYield();
 		});
 
 	TEST_TRUE(thread.IsStopRequested() == false);
@@ -26,7 +26,7 @@ struct ThreadConfig
 {
 	String          mName        = "";      // The thread name.
 	int             mStackSize   = 128_KiB; // The stack size of the thread.
-	int             mTempMemSize = 128_KiB; // Initialize a temp memory of that size of the thread. Can be 0.
+	int             mTempMemSize = 128_KiB; // Initialize a temp memory of that size of the thread. Can be 0 (temp memory is then lazily initialized).
 	EThreadPriority mPriority    = EThreadPriority::Normal; // The priority of the thread.
 };
 
@@ -62,6 +62,9 @@ private:
 // Yield the processor to other threads that are ready to run.
 void gThreadYield();
 
+// Return the OS ID of the current thread.
+uint32 gGetCurrentThreadID();
+
 // Number of threads that can run concurrently.
 // Equivalent to the number of CPU cores (incuding hyperthreading logical cores).
 int gThreadHardwareConcurrency();
\ No newline at end of file
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MPL-2.0
 #include<Bedrock/Ticks.h>
 
+#if defined(_WIN32)
+
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -29,6 +31,28 @@ int64 gGetTickCount()
 	return counter.QuadPart;
 }
 
+#elif defined(__linux__)
+
+#include <time.h>
+
+
+// The monotonic clock is already in nanoseconds.
+static constexpr int64 sGetNanosecondsPerTick()
+{
+	return 1;
+}
+
+
+int64 gGetTickCount()
+{
+	timespec time = {};
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (int64)time.tv_sec * 1'000'000'000 + time.tv_nsec;
+}
+
+#else
+#error Unknown platform
+#endif
 
 int64 gTicksToNanoseconds(int64 inTicks)
 {
@@ -33,6 +33,14 @@ template <class T> constexpr bool cIsTriviallyDefaultConstructible = __is_trivia
 // Equivalent to std::is_trivially_copyable
 template <class T> constexpr bool cIsTriviallyCopyable = __is_trivially_copyable(T);
 
+// Equivalent to std::is_trivially_destructible
+template <class T> constexpr bool cIsTriviallyDestructible = __is_trivially_destructible(T);
+
+// True if objects of type T can be moved to a different address with a memcpy, without calling the move constructor and the
+// destructor of the source (eg. types that don't point to themselves). Containers use it to move elements in bulk.
+// True for trivially copyable types, other types can opt in by specializing it.
+template <class T> constexpr bool cIsTriviallyRelocatable = cIsTriviallyCopyable<T>;
+
 // Equivalent to std::is_const
 namespace Details
 {
@@ -133,7 +141,48 @@ template<class T> constexpr bool cIsIntegral = cIsAnyOf<RemoveCV<T>, bool, char,
 // Equivalent to std::integral
 template <class T> concept Integral = cIsIntegral<T>;
 
+// Equivalent to std::is_floating_point
+template<class T> constexpr bool cIsFloatingPoint = cIsAnyOf<RemoveCV<T>, float, double, long double>;
+
+// Equivalent to std::is_signed
+namespace Details
+{
+	template<class T, bool = cIsIntegral<T> || cIsFloatingPoint<T>> struct IsSigned { static constexpr bool cValue = false; };
+	template<class T> struct IsSigned<T, true> { static constexpr bool cValue = (::RemoveCV<T>)-1 < (::RemoveCV<T>)0; };
+}
+template<class T> constexpr bool cIsSigned = Details::IsSigned<T>::cValue;
+
+// Unsigned integer type of a given size in bytes.
+namespace Details
+{
+	template <int taSize> struct UnsignedOfSize;
+	template <> struct UnsignedOfSize<1> { using Type = uint8; };
+	template <> struct UnsignedOfSize<2> { using Type = uint16; };
+	template <> struct UnsignedOfSize<4> { using Type = uint32; };
+	template <> struct UnsignedOfSize<8> { using Type = uint64; };
+}
+template <int taSize> using UnsignedOfSize = typename Details::UnsignedOfSize<taSize>::Type;
+
 // Equivalent to std::as_const
 template <class T>
 [[nodiscard]] ATTRIBUTE_INTRINSIC constexpr const T& gAsConst(T& inValue) { return inValue; }
- 
\ No newline at end of file
+ 
+// Equivalent to std::integer_sequence (but only for int).
+template <int... taValues> struct IntegerSequence {};
+
+// Equivalent to std::make_integer_sequence (but only for int).
+namespace Details
+{
+	template <int taCount, int... taValues> struct MakeIntegerSequence { using Type = typename MakeIntegerSequence<taCount - 1, taCount - 1, taValues...>::Type; };
+	template <int... taValues> struct MakeIntegerSequence<0, taValues...> { using Type = IntegerSequence<taValues...>; };
+}
+template <int taCount> using MakeIntegerSequence = typename Details::MakeIntegerSequence<taCount>::Type;
+
+// Type at index taIndex in taTypes. Equivalent to std::tuple_element (but for a parameter pack).
+namespace Details
+{
+	template <int taIndex, class T, class... taTypes> struct TypeAtIndex { using Type = typename TypeAtIndex<taIndex - 1, taTypes...>::Type; };
+	template <class T, class... taTypes> struct TypeAtIndex<0, T, taTypes...> { using Type = T; };
+}
+template <int taIndex, class... taTypes> requires (taIndex >= 0 && taIndex < (int)sizeof...(taTypes))
+using TypeAtIndex = typename Details::TypeAtIndex<taIndex, taTypes...>::Type;
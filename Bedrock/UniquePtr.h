@@ -2,6 +2,7 @@
 #pragma once
 
 #include <Bedrock/Core.h>
+#include <Bedrock/TypeTraits.h>
 
 constexpr void gDefaultDelete(auto* inValue) { delete inValue; };
 
@@ -63,3 +64,5 @@ private:
 };
 
 
+// UniquePtr can be relocated with a memcpy.
+template<class taType> inline constexpr bool cIsTriviallyRelocatable<UniquePtr<taType>> = true;
@@ -2,6 +2,7 @@
 #include <Bedrock/Vector.h>
 #include <Bedrock/Test.h>
 #include <Bedrock/String.h>
+#include <Bedrock/StringFormat.h>
 
 
 REGISTER_TEST("Vector")
@@ -222,6 +223,192 @@ REGISTER_TEST("Vector")
 };
 
 
+REGISTER_TEST("Vector Alignment")
+{
+	// Over-aligned heap memory.
+	Vector<int, DefaultAllocator<int>, 64> vec = { 1, 2, 3 };
+	TEST_TRUE(((uint64)vec.Data() % 64) == 0);
+	for (int i = 0; i < 100; i++)
+	{
+		vec.PushBack(i);
+		TEST_TRUE(((uint64)vec.Data() % 64) == 0);
+	}
+
+	// Copy between different alignments.
+	Vector<int> copy = vec;
+	TEST_TRUE(Span(copy) == Span(vec));
+	vec = copy;
+	TEST_TRUE(Span(copy) == Span(vec));
+
+	// Types with a large alignment are aligned by default.
+	struct alignas(32) Aligned32 { int mValue; };
+	Vector<Aligned32> aligned_vec;
+	aligned_vec.Resize(10);
+	TEST_TRUE(((uint64)aligned_vec.Data() % 32) == 0);
+
+	// Over-aligned temp memory.
+	{
+		TEST_INIT_TEMP_MEMORY(1_KiB);
+
+		TempVector<int> temp_vec = { 1 };
+		Vector<int, TempAllocator<int>, 128> aligned_temp_vec = { 1, 2, 3 };
+		TEST_TRUE(gTempMemArena.Owns(aligned_temp_vec.Data()));
+		TEST_TRUE(((uint64)aligned_temp_vec.Data() % 128) == 0);
+	}
+
+	// Fixed vector with an aligned buffer.
+	Vector<int, FixedAllocator<int, 16, 64>, 64> fixed_vec = { 1, 2, 3 };
+	TEST_TRUE(((uint64)fixed_vec.Data() % 64) == 0);
+	static_assert(cIsStable<decltype(fixed_vec)>);
+
+	// Virtual memory vector. Its only allocation is at the start of the reserved memory, it doesn't need padding.
+	Vector<int, VMemAllocator<int>, 64> vmem_vec;
+	for (int i = 0; i < 10000; i++)
+		vmem_vec.PushBack(i);
+	TEST_TRUE(((uint64)vmem_vec.Data() % 64) == 0);
+	TEST_TRUE(vmem_vec.Back() == 9999);
+};
+
+
+REGISTER_TEST("Vector Heap Growth")
+{
+	// Capacity includes the slack of the allocation.
+	Vector<int> vec;
+	vec.Reserve(5);
+	TEST_TRUE(vec.Capacity() >= 5);
+
+	// Growing keeps the elements (trivially copyable elements are moved by the allocator).
+	for (int i = 0; i < 100000; ++i)
+		vec.PushBack(i);
+
+	bool all_equal = true;
+	for (int i = 0; i < 100000; ++i)
+		all_equal &= (vec[i] == i);
+	TEST_TRUE(all_equal);
+
+	// Same with non-trivial elements.
+	Vector<String> strings;
+	for (int i = 0; i < 100; ++i)
+		strings.PushBack(gTempFormat("%d", i));
+	TEST_TRUE(strings[42] == "42");
+	TEST_TRUE(strings.Capacity() >= strings.Size());
+};
+
+
+REGISTER_TEST("Vector Relocatable")
+{
+	static_assert(cIsTriviallyRelocatable<int>);
+	static_assert(cIsTriviallyRelocatable<String>);
+	static_assert(cIsTriviallyRelocatable<Vector<String>>);
+	static_assert(!cIsTriviallyRelocatable<FixedString<8>>);
+	static_assert(!cIsTriviallyRelocatable<FixedVector<int, 8>>);
+
+	// Strings are relocated with memcpy when inserting/erasing in the middle and when growing.
+	Vector<String> strings;
+	for (int i = 0; i < 10; ++i)
+		strings.PushBack(gTempFormat("%d", i));
+
+	strings.Insert(0, String("first"));
+	strings.Emplace(5, "middle");
+	String ab[] = { "a", "b" };
+	strings.Insert(2, ab);
+	TEST_TRUE(strings.Size() == 14);
+	TEST_TRUE(strings[0] == "first");
+	TEST_TRUE(strings[2] == "a");
+	TEST_TRUE(strings[3] == "b");
+	TEST_TRUE(strings[7] == "middle");
+	TEST_TRUE(strings[13] == "9");
+
+	strings.Erase(2, 2);
+	strings.SwapErase(0);
+	TEST_TRUE(strings.Size() == 11);
+	TEST_TRUE(strings[0] == "9");
+	TEST_TRUE(strings[1] == "0");
+	TEST_TRUE(strings[5] == "middle");
+	TEST_TRUE(strings[10] == "8");
+
+	strings.Reserve(1000);
+	TEST_TRUE(strings[5] == "middle");
+	TEST_TRUE(strings[10] == "8");
+};
+
+REGISTER_TEST("SmallVector")
+{
+	// Up to 4 elements are stored inline, without any heap allocation.
+	{
+		MemStats heap_before = gGetMemStats(EMemoryKind::Heap);
+
+		SmallVector<int, 4> ints = { 1, 2, 3 };
+		ints.PushBack(4);
+		TEST_TRUE(ints.GetAllocator().IsInline(ints.Data()));
+		TEST_TRUE(ints.Capacity() == 4);
+		TEST_TRUE(gGetMemStats(EMemoryKind::Heap).mTotalCount == heap_before.mTotalCount);
+
+		ints.PushBack(5);
+		TEST_TRUE(gGetMemStats(EMemoryKind::Heap).mTotalCount == heap_before.mTotalCount + 1);
+	}
+
+	// Once spilled, the capacity is the usable size of the heap allocation, like for a regular Vector.
+	{
+		Vector<int>         heap_ints;
+		SmallVector<int, 4> small_ints = { 1, 2, 3, 4 };
+		heap_ints.Reserve(37);
+		small_ints.Reserve(37);
+		TEST_TRUE(!small_ints.GetAllocator().IsInline(small_ints.Data()));
+		TEST_TRUE(small_ints.Capacity() == heap_ints.Capacity());
+		TEST_TRUE(small_ints[3] == 4);
+
+		small_ints.Reserve(1000);
+		heap_ints.Reserve(1000);
+		TEST_TRUE(small_ints.Capacity() == heap_ints.Capacity());
+		TEST_TRUE(small_ints[3] == 4);
+	}
+
+	SmallVector<String, 4> test = { "a", "b", "c" };
+	test.PushBack("d");
+	TEST_TRUE(test.GetAllocator().IsInline(test.Data()));
+
+	// Spills to the heap.
+	test.PushBack("e");
+	TEST_TRUE(!test.GetAllocator().IsInline(test.Data()));
+	TEST_TRUE(test.Size() == 5);
+	TEST_TRUE(test[0] == "a");
+	TEST_TRUE(test[4] == "e");
+
+	// ShrinkToFit moves the elements back inline.
+	test.PopBack();
+	test.ShrinkToFit();
+	TEST_TRUE(test.GetAllocator().IsInline(test.Data()));
+	TEST_TRUE(test.Size() == 4);
+	TEST_TRUE(test[3] == "d");
+
+	// Moving an inline vector moves the elements.
+	SmallVector<String, 4> moved = gMove(test);
+	TEST_TRUE(moved.GetAllocator().IsInline(moved.Data()));
+	TEST_TRUE(moved.Size() == 4);
+	TEST_TRUE(moved[0] == "a");
+	TEST_TRUE(test.Empty());
+
+	// Moving a heap vector steals the memory.
+	moved.PushBack("e");
+	String* heap_data = moved.Data();
+	test = gMove(moved);
+	TEST_TRUE(test.Data() == heap_data);
+	TEST_TRUE(moved.Empty());
+
+	Vector<String> heap_copy = test;
+	TEST_TRUE(Span(heap_copy) == Span(test));
+
+	// Arena as fallback.
+	FixedMemArena<1_KiB>                     mem_arena;
+	SmallVector<int, 2, ArenaAllocator<int>> arena_vec(ArenaAllocator<int>{ mem_arena });
+	arena_vec = { 1, 2 };
+	TEST_TRUE(arena_vec.GetAllocator().IsInline(arena_vec.Data()));
+	arena_vec.PushBack(3);
+	TEST_TRUE(mem_arena.Owns(arena_vec.Data()));
+	arena_vec.ClearAndFreeMemory();
+};
+
 REGISTER_TEST("TempVector")
 {
 	TEST_INIT_TEMP_MEMORY(1_KiB);
@@ -308,6 +495,36 @@ REGISTER_TEST("ArenaVector")
 };
 
 
+REGISTER_TEST("ArenaVector Adjacent Values")
+{
+	// Values located right after the allocation of the vector are not part of it, adding them must not assert.
+	FixedMemArena<1_KiB> mem_arena;
+
+	ArenaVector<int> test(mem_arena);
+	test.Reserve(8);
+	TEST_TRUE(test.Capacity() == 8);
+
+	MemBlock after  = mem_arena.Alloc(2 * sizeof(int));
+	int*     values = (int*)after.mPtr;
+	TEST_TRUE(values == test.Begin() + test.Capacity());
+
+	values[0] = 1;
+	values[1] = 2;
+
+	test = Span<const int>(values, 2);
+	test.PushBack(values[0]);
+	test.PushBack(gMove(values[0]));
+	test.Insert(0, values[0]);
+	test.Insert(0, gMove(values[0]));
+	test.Insert(0, Span<const int>(values, 2));
+
+	Vector<int> expected = { 1, 2, 1, 1, 1, 2, 1, 1 };
+	TEST_TRUE(Span(test) == Span(expected));
+
+	mem_arena.Free(after);
+};
+
+
 REGISTER_TEST("VMemVector")
 {
 	VMemVector<int> test;
@@ -16,14 +16,20 @@ enum class EResizeInit
 };
 
 
-template <typename taType, typename taAllocator = DefaultAllocator<taType>>
+// taAlignment is the alignment of the allocated memory. It can be larger than the alignment of taType (eg. to align the data
+// on cache lines or for SIMD), in which case it is passed to the allocator.
+template <typename taType, typename taAllocator = DefaultAllocator<taType>, int taAlignment = alignof(taType)>
 struct Vector : private taAllocator
 {
 	static_assert(!cIsConst<taType>);
+	static_assert(gIsPow2(taAlignment) && taAlignment >= (int)alignof(taType));
+	static_assert(taAlignment <= Details::GetMaxAlignment<taAllocator>(), "Alignment not supported by this allocator");
 
 	using ValueType = taType;
 	using Allocator = taAllocator;
 
+	static constexpr int cAlignment = taAlignment;
+
 	// Default
 	constexpr Vector() = default;
 	~Vector();
@@ -39,13 +45,13 @@ struct Vector : private taAllocator
 	Vector(const Vector& inOther);
 	Vector& operator=(const Vector& inOther);
 
-	// Copy from Vector with different allocator
-	template <typename taOtherAllocator>
-	requires (!cIsSame<taAllocator, taOtherAllocator>)
-	Vector(const Vector<taType, taOtherAllocator>& inOther);
-	template <typename taOtherAllocator>
-	requires (!cIsSame<taAllocator, taOtherAllocator>)
-	Vector& operator=(const Vector<taType, taOtherAllocator>& inOther);
+	// Copy from Vector with different allocator or alignment
+	template <typename taOtherAllocator, int taOtherAlignment>
+	requires (!cIsSame<taAllocator, taOtherAllocator> || taAlignment != taOtherAlignment)
+	Vector(const Vector<taType, taOtherAllocator, taOtherAlignment>& inOther);
+	template <typename taOtherAllocator, int taOtherAlignment>
+	requires (!cIsSame<taAllocator, taOtherAllocator> || taAlignment != taOtherAlignment)
+	Vector& operator=(const Vector<taType, taOtherAllocator, taOtherAlignment>& inOther);
 
 	// Copy from InitializerList
 	Vector(InitializerList<taType> inInitializerList);
@@ -101,7 +107,7 @@ struct Vector : private taAllocator
 	void Reserve(int inCapacity);
 	void Resize(int inNewSize, EResizeInit inInit = EResizeInit::ZeroInit);
 	void Resize(int inNewSize, const taType& inValue);
-	void ShrinkToFit();				// Note: Only does somethig if the allocator supports TryRealloc (eg. TempAllocator).
+	void ShrinkToFit();				// Note: Only does somethig if the allocator supports TryRealloc (eg. TempAllocator) or has inline storage (eg. SmallAllocator).
 
 	void Insert(int inPosition, const taType& inValue);
 	void Insert(int inPosition, taType&& inValue);
@@ -121,9 +127,15 @@ struct Vector : private taAllocator
 	void PopBack();
 
 private:
+	// Optional allocator features (see DefaultAllocator).
+	static constexpr bool cHasAllocateAtLeast = requires (taAllocator& ioAllocator, int& ioSize) { ioAllocator.AllocateAtLeast(ioSize, taAlignment); };
+	static constexpr bool cHasReallocate      = requires (taAllocator& ioAllocator, taType* inPtr, int& ioSize) { ioAllocator.Reallocate(inPtr, 0, ioSize, taAlignment); };
+	static constexpr bool cHasInlineStorage   = requires (const taAllocator& inAllocator, const taType* inPtr) { inAllocator.IsInline(inPtr); };
+
 	void MoveFrom(Vector&& ioOther);
 	void CopyFrom(Span<const taType> inOther);
 	void Grow(int inCapacity);
+	void MoveToNewAllocation(int inCapacity);
 	void MoveElementsForward(int inFromPosition, int inToPosition);
 	void MoveElementsBackward(int inFromPosition, int inToPosition);
 
@@ -154,115 +166,125 @@ using VMemVector = Vector<taType, VMemAllocator<taType>>;
 template <typename taType, int taSize>
 using FixedVector = Vector<taType, FixedAllocator<taType, taSize>>;
 
+// Alias for a Vector using a SmallAllocator.
+// It contains a buffer large enough to store taSize elements, and allocates from taFallbackAllocator when it needs to grow larger.
+// ShrinkToFit moves the elements back into the buffer if they fit.
+template <typename taType, int taSize, typename taFallbackAllocator = DefaultAllocator<taType>>
+using SmallVector = Vector<taType, SmallAllocator<taType, taSize, taFallbackAllocator>>;
+
+
 
+// Vectors can be relocated with a memcpy if their allocator can (the elements themselves are not moved).
+template<class taType, typename taAllocator, int taAlignment> inline constexpr bool cIsTriviallyRelocatable<Vector<taType, taAllocator, taAlignment>> = cIsTriviallyRelocatable<taAllocator>;
 
 // All Vectors are contiguous containers.
-template<class taType, typename taAllocator> inline constexpr bool cIsContiguous<Vector<taType, taAllocator>> = true;
+template<class taType, typename taAllocator, int taAlignment> inline constexpr bool cIsContiguous<Vector<taType, taAllocator, taAlignment>> = true;
 
 // VMemVector is stable, its data address never changes.
-template<class taType> inline constexpr bool cIsStable<VMemVector<taType>> = true;
+template<class taType, int taAlignment> inline constexpr bool cIsStable<Vector<taType, VMemAllocator<taType>, taAlignment>> = true;
 
 // FixedVector is stable, its data address never changes.
-template<class taType, int taSize> inline constexpr bool cIsStable<FixedVector<taType, taSize>> = true;
+template<class taType, int taSize, int taAllocatorAlignment, int taAlignment>
+inline constexpr bool cIsStable<Vector<taType, FixedAllocator<taType, taSize, taAllocatorAlignment>, taAlignment>> = true;
 
 
 // Deduction guides for Span.
-template<typename taType, typename taAllocator>
-Span(Vector<taType, taAllocator>&) -> Span<taType>;
-template<typename taType, typename taAllocator>
-Span(const Vector<taType, taAllocator>&) -> Span<const taType>;
+template<typename taType, typename taAllocator, int taAlignment>
+Span(Vector<taType, taAllocator, taAlignment>&) -> Span<taType>;
+template<typename taType, typename taAllocator, int taAlignment>
+Span(const Vector<taType, taAllocator, taAlignment>&) -> Span<const taType>;
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>::~Vector()
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>::~Vector()
 {
 	ClearAndFreeMemory();
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>::Vector(Vector&& ioOther)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>::Vector(Vector&& ioOther)
 {
 	MoveFrom(gMove(ioOther));
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>& Vector<taType, taAllocator>::operator=(Vector&& ioOther)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>& Vector<taType, taAllocator, taAlignment>::operator=(Vector&& ioOther)
 {
 	MoveFrom(gMove(ioOther));
 	return *this;
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>::Vector(const Vector& inOther)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>::Vector(const Vector& inOther)
 {
 	CopyFrom(Span(inOther));
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>& Vector<taType, taAllocator>::operator=(const Vector& inOther)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>& Vector<taType, taAllocator, taAlignment>::operator=(const Vector& inOther)
 {
 	CopyFrom(Span(inOther));
 	return *this;
 }
 
 
-template <typename taType, typename taAllocator>
-template <typename taOtherAllocator>
-requires (!cIsSame<taAllocator, taOtherAllocator>)
-Vector<taType, taAllocator>::Vector(const Vector<taType, taOtherAllocator>& inOther)
+template <typename taType, typename taAllocator, int taAlignment>
+template <typename taOtherAllocator, int taOtherAlignment>
+requires (!cIsSame<taAllocator, taOtherAllocator> || taAlignment != taOtherAlignment)
+Vector<taType, taAllocator, taAlignment>::Vector(const Vector<taType, taOtherAllocator, taOtherAlignment>& inOther)
 {
 	CopyFrom(Span(inOther));
 }
 
 
-template <typename taType, typename taAllocator>
-template <typename taOtherAllocator>
-requires (!cIsSame<taAllocator, taOtherAllocator>)
-Vector<taType, taAllocator>& Vector<taType, taAllocator>::operator=(const Vector<taType, taOtherAllocator>& inOther)
+template <typename taType, typename taAllocator, int taAlignment>
+template <typename taOtherAllocator, int taOtherAlignment>
+requires (!cIsSame<taAllocator, taOtherAllocator> || taAlignment != taOtherAlignment)
+Vector<taType, taAllocator, taAlignment>& Vector<taType, taAllocator, taAlignment>::operator=(const Vector<taType, taOtherAllocator, taOtherAlignment>& inOther)
 {
 	CopyFrom(Span(inOther));
 	return *this;
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>::Vector(InitializerList<taType> inInitializerList)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>::Vector(InitializerList<taType> inInitializerList)
 {
 	CopyFrom(Span(inInitializerList.begin(), (int)inInitializerList.size()));
 }
 
 
-template <typename taType, typename taAllocator>
-Vector<taType, taAllocator>& Vector<taType, taAllocator>::operator=(InitializerList<taType> inInitializerList)
+template <typename taType, typename taAllocator, int taAlignment>
+Vector<taType, taAllocator, taAlignment>& Vector<taType, taAllocator, taAlignment>::operator=(InitializerList<taType> inInitializerList)
 {
 	CopyFrom(Span(inInitializerList.begin(), (int)inInitializerList.size()));
 	return *this;
 }
 
 
-template <typename taType, typename taAllocator>
+template <typename taType, typename taAllocator, int taAlignment>
 template <class taOtherType> requires cIsConvertible<taOtherType, taType>
-Vector<taType, taAllocator>::Vector(Span<taOtherType> inSpan)
+Vector<taType, taAllocator, taAlignment>::Vector(Span<taOtherType> inSpan)
 {
 	CopyFrom(inSpan);
 }
 
 
-template <typename taType, typename taAllocator>
+template <typename taType, typename taAllocator, int taAlignment>
 template <class taOtherType> requires cIsConvertible<taOtherType, taType>
-Vector<taType, taAllocator>& Vector<taType, taAllocator>::operator=(Span<taOtherType> inSpan)
+Vector<taType, taAllocator, taAlignment>& Vector<taType, taAllocator, taAlignment>::operator=(Span<taOtherType> inSpan)
 {
 	CopyFrom(inSpan);
 	return *this;
 }
 
 
-template <typename taType, typename taAllocator>
-constexpr int Vector<taType, taAllocator>::GetIndex(const taType& inElement) const
+template <typename taType, typename taAllocator, int taAlignment>
+constexpr int Vector<taType, taAllocator, taAlignment>::GetIndex(const taType& inElement) const
 {
 	int index = (int)(&inElement - mData);
 	gBoundsCheck(index, mSize);
@@ -270,8 +292,8 @@ constexpr int Vector<taType, taAllocator>::GetIndex(const taType& inElement) con
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Clear()
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Clear()
 {
 	for (taType& element : *this)
 		element.~taType();
@@ -279,36 +301,69 @@ void Vector<taType, taAllocator>::Clear()
 	mSize = 0;
 }
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::ClearAndFreeMemory()
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::ClearAndFreeMemory()
 {
 	Clear();
 
 	if (mData != nullptr)
 	{
-		Allocator::Free(mData, mCapacity);
+		Allocator::Free(mData, mCapacity, taAlignment);
 		mData     = nullptr;
 		mCapacity = 0;
 	}
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Reserve(int inCapacity)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Reserve(int inCapacity)
 {
 	if (mCapacity >= inCapacity)
 		return;
 
-	int old_capacity = mCapacity;
-	mCapacity = inCapacity;
-
 	// Try to grow the allocation.
-	if (mData != nullptr && Allocator::TryRealloc(mData, old_capacity, mCapacity))
+	if (mData != nullptr && Allocator::TryRealloc(mData, mCapacity, inCapacity))
+	{
+		mCapacity = inCapacity;
 		return; // Success, nothing else to do.
+	}
+
+	// If elements can be moved with a memcpy, let the allocator move them. It might be able to grow in place, or to move pages
+	// instead of copying them (eg. with realloc).
+	if constexpr (cHasReallocate && cIsTriviallyRelocatable<taType>)
+	{
+		if (mData != nullptr)
+		{
+			int     new_capacity = inCapacity;
+			taType* new_data     = Allocator::Reallocate(mData, mCapacity, new_capacity, taAlignment);
+			if (new_data != nullptr) [[likely]]
+			{
+				mData     = new_data;
+				mCapacity = new_capacity;
+				return;
+			}
+		}
+	}
+
+	MoveToNewAllocation(inCapacity);
+}
+
+
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::MoveToNewAllocation(int inCapacity)
+{
+	gAssert(inCapacity >= mSize);
+
+	taType* old_data     = mData;
+	int     old_capacity = mCapacity;
+	mCapacity = inCapacity;
 
 	// Allocate new data.
-	taType* old_data = mData;
-	mData = Allocator::Allocate(mCapacity);
+	// If the allocator can tell, use the actual size of the allocation as capacity.
+	if constexpr (cHasAllocateAtLeast)
+		mData = Allocator::AllocateAtLeast(mCapacity, taAlignment);
+	else
+		mData = Allocator::Allocate(mCapacity, taAlignment);
 
 	if constexpr (cIsStable<Vector>)
 	{
@@ -316,6 +371,15 @@ void Vector<taType, taAllocator>::Reserve(int inCapacity)
 		// This means taType does not need to have a copy constructor.
 		gAssert(old_data == nullptr);
 	}
+	else if constexpr (cIsTriviallyRelocatable<taType>)
+	{
+		// Relocate old data to new and free it (no need to destroy relocated elements).
+		if (old_data != nullptr)
+		{
+			gMemCopy(mData, old_data, mSize * (int64)sizeof(taType));
+			Allocator::Free(old_data, old_capacity, taAlignment);
+		}
+	}
 	else
 	{
 		if constexpr (cIsMoveConstructible<taType>)
@@ -337,14 +401,14 @@ void Vector<taType, taAllocator>::Reserve(int inCapacity)
 			for (int i = 0, n = mSize; i < n; ++i)
 				old_data[i].~taType();
 			
-			Allocator::Free(old_data, old_capacity);
+			Allocator::Free(old_data, old_capacity, taAlignment);
 		}
 	}
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Resize(int inNewSize, EResizeInit inInit)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Resize(int inNewSize, EResizeInit inInit)
 {
 	if (inNewSize < mSize)
 	{
@@ -380,8 +444,8 @@ void Vector<taType, taAllocator>::Resize(int inNewSize, EResizeInit inInit)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Resize(int inNewSize, const taType& inValue)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Resize(int inNewSize, const taType& inValue)
 {
 	if (inNewSize < mSize)
 	{
@@ -403,8 +467,18 @@ void Vector<taType, taAllocator>::Resize(int inNewSize, const taType& inValue)
 }
 
 
-template <typename taType, typename taAllocator> void Vector<taType, taAllocator>::ShrinkToFit()
+template <typename taType, typename taAllocator, int taAlignment> void Vector<taType, taAllocator, taAlignment>::ShrinkToFit()
 {
+	if constexpr (cHasInlineStorage)
+	{
+		// If the elements fit in the inline storage, move them back there.
+		if (mData != nullptr && mSize <= taAllocator::cInlineSize && !GetAllocator().IsInline(mData))
+		{
+			MoveToNewAllocation(mSize);
+			return;
+		}
+	}
+
 	if (mCapacity == mSize)
 		return;
 
@@ -413,17 +487,17 @@ template <typename taType, typename taAllocator> void Vector<taType, taAllocator
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Insert(int inPosition, const taType& inValue)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Insert(int inPosition, const taType& inValue)
 {
 	gBoundsCheck(inPosition, mSize + 1);
 	// Copying from self is not allowed.
-	gAssert(&inValue < mData || &inValue > (mData + mCapacity));
+	gAssert(&inValue < mData || &inValue >= (mData + mCapacity));
 
 	Grow(mSize + 1);
 
 	// If we're not inserting at the end.
-	if (inPosition != mSize)
+	if (inPosition != mSize && !cIsTriviallyRelocatable<taType>)
 	{
 		// Move existing elements to free inPosition.
 		MoveElementsForward(inPosition, inPosition + 1);
@@ -433,6 +507,10 @@ void Vector<taType, taAllocator>::Insert(int inPosition, const taType& inValue)
 	}
 	else
 	{
+		// Relocate existing elements to free inPosition, if necessary.
+		if (inPosition != mSize)
+			MoveElementsForward(inPosition, inPosition + 1);
+
 		// Copy-construct the new element.
 		gPlacementNew(mData[inPosition], inValue);
 	}
@@ -441,17 +519,17 @@ void Vector<taType, taAllocator>::Insert(int inPosition, const taType& inValue)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Insert(int inPosition, taType&& inValue)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Insert(int inPosition, taType&& inValue)
 {
 	gBoundsCheck(inPosition, mSize + 1);
 	// Copying from self is not allowed.
-	gAssert(&inValue < mData || &inValue > (mData + mCapacity));
+	gAssert(&inValue < mData || &inValue >= (mData + mCapacity));
 
 	Grow(mSize + 1);
 
 	// If we're not inserting at the end.
-	if (inPosition != mSize)
+	if (inPosition != mSize && !cIsTriviallyRelocatable<taType>)
 	{
 		// Move existing elements to free inPosition.
 		MoveElementsForward(inPosition, inPosition + 1);
@@ -461,6 +539,10 @@ void Vector<taType, taAllocator>::Insert(int inPosition, taType&& inValue)
 	}
 	else
 	{
+		// Relocate existing elements to free inPosition, if necessary.
+		if (inPosition != mSize)
+			MoveElementsForward(inPosition, inPosition + 1);
+
 		// Move-construct the new element.
 		gPlacementNew(mData[inPosition], gMove(inValue));
 	}
@@ -469,15 +551,15 @@ void Vector<taType, taAllocator>::Insert(int inPosition, taType&& inValue)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Insert(int inPosition, Span<const taType> inValues)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Insert(int inPosition, Span<const taType> inValues)
 {
 	if (inValues.Empty())
 		return;
 
 	gBoundsCheck(inPosition, mSize + 1);
 	// Copying from self is not allowed.
-	gAssert(mData > inValues.End() || (mData + mCapacity) < inValues.Begin() || inValues.Empty());
+	gAssert(mData >= inValues.End() || (mData + mCapacity) <= inValues.Begin() || inValues.Empty());
 
 	Grow(mSize + inValues.Size());
 
@@ -486,10 +568,11 @@ void Vector<taType, taAllocator>::Insert(int inPosition, Span<const taType> inVa
 		MoveElementsForward(inPosition, inPosition + inValues.Size());
 
 	// Copy-assign or Copy-construct the new elements depending on if they're past the current end.
+	// Relocated elements leave uninitialized memory behind, always copy-construct in that case.
 	int position = inPosition;
 	for (const taType& value : inValues)
 	{
-		if (position < mSize)
+		if (position < mSize && !cIsTriviallyRelocatable<taType>)
 			mData[position] = value;
 		else
 			gPlacementNew(mData[position], value);
@@ -501,9 +584,9 @@ void Vector<taType, taAllocator>::Insert(int inPosition, Span<const taType> inVa
 }
 
 
-template <typename taType, typename taAllocator>
+template <typename taType, typename taAllocator, int taAlignment>
 template <typename ... taArgs>
-void Vector<taType, taAllocator>::Emplace(int inPosition, taArgs&&... inArgs)
+void Vector<taType, taAllocator, taAlignment>::Emplace(int inPosition, taArgs&&... inArgs)
 {
 	gBoundsCheck(inPosition, mSize + 1);
 
@@ -515,8 +598,9 @@ void Vector<taType, taAllocator>::Emplace(int inPosition, taArgs&&... inArgs)
 		// Move existing elements to free inPosition.
 		MoveElementsForward(inPosition, inPosition + 1);
 
-		// Destruct the element at inPosition.
-		mData[inPosition].~taType();
+		// Destruct the element at inPosition (unless it was relocated, then there is nothing left to destruct).
+		if constexpr (!cIsTriviallyRelocatable<taType>)
+			mData[inPosition].~taType();
 	}
 
 	// Construct the new element.
@@ -525,13 +609,13 @@ void Vector<taType, taAllocator>::Emplace(int inPosition, taArgs&&... inArgs)
 }
 
 
-template <typename taType, typename taAllocator> void Vector<taType, taAllocator>::Erase(int inPosition)
+template <typename taType, typename taAllocator, int taAlignment> void Vector<taType, taAllocator, taAlignment>::Erase(int inPosition)
 {
 	Erase(inPosition, 1);
 }
 
 
-template <typename taType, typename taAllocator> void Vector<taType, taAllocator>::Erase(int inPosition, int inCount)
+template <typename taType, typename taAllocator, int taAlignment> void Vector<taType, taAllocator, taAlignment>::Erase(int inPosition, int inCount)
 {
 	gBoundsCheck(inPosition, mSize);
 	gBoundsCheck(inPosition + inCount - 1, mSize);
@@ -542,18 +626,31 @@ template <typename taType, typename taAllocator> void Vector<taType, taAllocator
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::SwapErase(int inPosition)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::SwapErase(int inPosition)
 {
-	gSwapErase(*this, Begin() + inPosition);
+	if constexpr (cIsTriviallyRelocatable<taType>)
+	{
+		// Destroy the element and relocate the last one in its place.
+		gBoundsCheck(inPosition, mSize);
+		mData[inPosition].~taType();
+		mSize--;
+
+		if (inPosition != mSize)
+			gMemCopy(&mData[inPosition], &mData[mSize], sizeof(taType));
+	}
+	else
+	{
+		gSwapErase(*this, Begin() + inPosition);
+	}
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::PushBack(const taType& inValue)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::PushBack(const taType& inValue)
 {
 	// Copying from self is not allowed.
-	gAssert(&inValue < mData || &inValue > (mData + mCapacity));
+	gAssert(&inValue < mData || &inValue >= (mData + mCapacity));
 
 	Grow(mSize + 1);
 
@@ -562,19 +659,19 @@ void Vector<taType, taAllocator>::PushBack(const taType& inValue)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::PushBack(taType&& inValue)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::PushBack(taType&& inValue)
 {
 	// Copying from self is not allowed.
-	gAssert(&inValue < mData || &inValue > (mData + mCapacity));
+	gAssert(&inValue < mData || &inValue >= (mData + mCapacity));
 
 	EmplaceBack(gMove(inValue));
 }
 
 
-template <typename taType, typename taAllocator>
+template <typename taType, typename taAllocator, int taAlignment>
 template <typename ... taArgs>
-taType& Vector<taType, taAllocator>::EmplaceBack(taArgs&&... inArgs)
+taType& Vector<taType, taAllocator, taAlignment>::EmplaceBack(taArgs&&... inArgs)
 {
 	Grow(mSize + 1);
 
@@ -587,8 +684,8 @@ taType& Vector<taType, taAllocator>::EmplaceBack(taArgs&&... inArgs)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::PopBack()
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::PopBack()
 {
 	gAssert(Size() >= 1);
 	mSize--;
@@ -596,8 +693,8 @@ void Vector<taType, taAllocator>::PopBack()
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::MoveFrom(Vector&& ioOther)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::MoveFrom(Vector&& ioOther)
 {
 	// Moving from self is not allowed.
 	gAssert(mData != ioOther.mData || mData == nullptr);
@@ -609,6 +706,22 @@ void Vector<taType, taAllocator>::MoveFrom(Vector&& ioOther)
 	GetAllocator() = gMove(ioOther.GetAllocator());
 	ioOther.GetAllocator() = Allocator();
 
+	if constexpr (cHasInlineStorage)
+	{
+		// If the data is inside the other allocator, it can't be stolen. Move the elements instead.
+		if (ioOther.mData != nullptr && ioOther.GetAllocator().IsInline(ioOther.mData))
+		{
+			Reserve(ioOther.mSize);
+
+			for (int i = 0, n = ioOther.mSize; i < n; ++i)
+				gPlacementNew(mData[i], gMove(ioOther.mData[i]));
+
+			mSize = ioOther.mSize;
+			ioOther.ClearAndFreeMemory();
+			return;
+		}
+	}
+
 	// Move the data.
 	mData     = ioOther.mData;
 	mSize     = ioOther.mSize;
@@ -620,11 +733,11 @@ void Vector<taType, taAllocator>::MoveFrom(Vector&& ioOther)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::CopyFrom(Span<const taType> inOther)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::CopyFrom(Span<const taType> inOther)
 {
 	// Copying from self is not allowed.
-	gAssert(mData > inOther.End() || (mData + mCapacity) < inOther.Begin() || inOther.Empty());
+	gAssert(mData >= inOther.End() || (mData + mCapacity) <= inOther.Begin() || inOther.Empty());
 
 	// Note: Currently the allocator of inOther is never copied (on purpose).
 	// Maybe an allocator trait to decide whether to copy or not would be useful, but wasn't needed so far.
@@ -642,8 +755,8 @@ void Vector<taType, taAllocator>::CopyFrom(Span<const taType> inOther)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::Grow(int inCapacity)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::Grow(int inCapacity)
 {
 	if (mCapacity >= inCapacity) [[likely]]
 		return;
@@ -663,8 +776,8 @@ void Vector<taType, taAllocator>::Grow(int inCapacity)
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::MoveElementsForward(int inFromPosition, int inToPosition)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::MoveElementsForward(int inFromPosition, int inToPosition)
 {
 	gAssert(inFromPosition < inToPosition);
 
@@ -676,11 +789,19 @@ void Vector<taType, taAllocator>::MoveElementsForward(int inFromPosition, int in
 	// | A | . | . | B | C | D |
 	// C and D are move-constructed.
 	// B is move-assigned.
+	// If taType is trivially relocatable, all elements are relocated instead and [1] and [2] are left uninitialized.
 
 	int num_elem_to_move = mSize - inFromPosition;
 	int move_distance  = inToPosition - inFromPosition;
 	gBoundsCheck(inToPosition + num_elem_to_move - 1, mCapacity);
 
+	if constexpr (cIsTriviallyRelocatable<taType>)
+	{
+		// Relocate all the elements at once.
+		gMemMove(mData + inToPosition, mData + inFromPosition, num_elem_to_move * (int64)sizeof(taType));
+		return;
+	}
+
 	// First do the move constructs (into unused memory).
 	for (taType* dest = mData + gMax(inToPosition, mSize), *dest_end = mData + inToPosition + num_elem_to_move; dest < dest_end; dest++)
 	{
@@ -697,8 +818,8 @@ void Vector<taType, taAllocator>::MoveElementsForward(int inFromPosition, int in
 }
 
 
-template <typename taType, typename taAllocator>
-void Vector<taType, taAllocator>::MoveElementsBackward(int inFromPosition, int inToPosition)
+template <typename taType, typename taAllocator, int taAlignment>
+void Vector<taType, taAllocator, taAlignment>::MoveElementsBackward(int inFromPosition, int inToPosition)
 {
 	gAssert(inFromPosition > inToPosition);
 
@@ -715,6 +836,16 @@ void Vector<taType, taAllocator>::MoveElementsBackward(int inFromPosition, int i
 	int move_distance  = inFromPosition - inToPosition;
 	gBoundsCheck(inToPosition, mSize + 1);
 
+	if constexpr (cIsTriviallyRelocatable<taType>)
+	{
+		// Destruct the elements that are overwritten, then relocate the following ones at once.
+		for (taType* dest = mData + inToPosition, *dest_end = mData + inFromPosition; dest < dest_end; dest++)
+			dest->~taType();
+
+		gMemMove(mData + inToPosition, mData + inFromPosition, num_elem_to_move * (int64)sizeof(taType));
+		return;
+	}
+
 	// First do the move assignements.
 	taType* dest = mData + inToPosition;
 	for (taType* dest_end = dest + num_elem_to_move; dest < dest_end; dest++)
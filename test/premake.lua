@@ -1,7 +1,7 @@
 solution "BedrockTest"
 	
 	platforms { "x64", "Clang" }
-	configurations { "Debug", "DebugASAN", "DebugOpt", "Release" }
+	configurations { "Debug", "DebugASAN", "DebugOpt", "DebugSizeClassHeap", "Release" }
 	startproject "BedrockTest"
 
 	project "BedrockTest"
@@ -18,14 +18,20 @@ solution "BedrockTest"
 			"FatalWarnings"
 		}
 
-		buildoptions
-		{
-			"/utf-8" 
-		}
+		filter { "system:windows" }
+			buildoptions
+			{
+				"/utf-8" 
+			}
 		
 		filter { "platforms:Clang" }
 			toolset "clang"
 
+		-- Linux is Clang only (both platforms), there's no GCC support.
+		filter { "system:linux" }
+			toolset "clang"
+			links "pthread"
+
 		filter { "configurations:Debug" }
 			targetsuffix "Debug"
 			defines "ASSERTS_ENABLED"
@@ -58,6 +64,14 @@ solution "BedrockTest"
 			optimize "Full"
 			editandcontinue "On"
 
+		-- Same as Debug, but gMemAlloc goes through the size-class heap instead of malloc.
+		filter { "configurations:DebugSizeClassHeap" }
+			targetsuffix "DebugSizeClassHeap"
+			defines { "ASSERTS_ENABLED", "BEDROCK_ENABLE_SIZE_CLASS_HEAP" }
+			optimize "Debug"
+			runtime "Debug"
+			editandcontinue "On"
+
 		filter { "configurations:Release" }
 			optimize "Full"
 			
@@ -0,0 +1 @@
+premake5 --file=premake.lua gmake2